@@ -95,6 +95,11 @@ workspace "Helios Engine"
 --		dir_group = "Libs/"
 --		include("Source/Libs/")
 
+	group "tools"
+		dir_group = "tools/"
+		include("source/texture-compressor/")
+		include("source/mesh-compiler/")
+
 	group "vendor"
 		dir_group = "vendor/"
 		include("vendor/")
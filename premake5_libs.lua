@@ -43,6 +43,16 @@ function VendorVulkan()
 end
 
 
+-- Shader compiler of the Vulkan SDK (glslc from the PATH without the SDK)
+function VulkanGlslc()
+	local sdk = os.getenv("VULKAN_SDK")
+	if sdk then
+		return path.join(sdk, os.host() == "windows" and "Bin" or "bin", "glslc")
+	end
+	return "glslc"
+end
+
+
 function VendorOpenGL()
 	-- TODO...
 	-- TODO...
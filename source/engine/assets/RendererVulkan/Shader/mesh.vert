@@ -0,0 +1,28 @@
+#version 450
+
+
+// Loaded meshes (VKModel::Vertex::GetMeshLayout), same interface as object.vert
+layout (location = 0) in vec3 vertPosition;
+layout (location = 1) in vec4 vertColor;
+
+layout (location = 0) out vec2 fragTexCoord;
+
+// Once per frame
+layout (set = 0, binding = 0) uniform Camera
+{
+	mat4 viewProjection;
+} camera;
+
+// Once per draw (dynamic offset)
+layout (set = 0, binding = 1) uniform Object
+{
+	mat4 transform;
+} object;
+
+
+void main()
+{
+	gl_Position = camera.viewProjection * object.transform * vec4(vertPosition, 1.0);
+	// Meshes have no texture coordinates yet
+	fragTexCoord = vertPosition.xy * 0.5 + 0.5;
+}
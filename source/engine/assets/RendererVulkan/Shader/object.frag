@@ -0,0 +1,18 @@
+#version 450
+
+
+layout (location = 0) out vec4 outColor;
+
+// Once per draw (dynamic offset)
+layout (set = 0, binding = 2) uniform Material
+{
+	vec4 color;
+	// Index into the bindless textures (unused without them)
+	uint textureIndex;
+} material;
+
+
+void main()
+{
+	outColor = material.color;
+}
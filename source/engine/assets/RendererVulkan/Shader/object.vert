@@ -0,0 +1,27 @@
+#version 450
+
+
+layout (location = 0) in vec2 vertPosition;
+layout (location = 1) in vec4 vertColor;
+
+layout (location = 0) out vec2 fragTexCoord;
+
+// Once per frame
+layout (set = 0, binding = 0) uniform Camera
+{
+	mat4 viewProjection;
+} camera;
+
+// Once per draw (dynamic offset)
+layout (set = 0, binding = 1) uniform Object
+{
+	mat4 transform;
+} object;
+
+
+void main()
+{
+	gl_Position = camera.viewProjection * object.transform * vec4(vertPosition, 0.0, 1.0);
+	// Models have no texture coordinates yet
+	fragTexCoord = vertPosition * 0.5 + 0.5;
+}
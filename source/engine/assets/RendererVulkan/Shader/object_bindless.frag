@@ -0,0 +1,26 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+
+layout (location = 0) in vec2 fragTexCoord;
+
+layout (location = 0) out vec4 outColor;
+
+// Once per draw (dynamic offset)
+layout (set = 0, binding = 2) uniform Material
+{
+	vec4 color;
+	// Index into the bindless textures (0xFFFFFFFF without a texture)
+	uint textureIndex;
+} material;
+
+// All textures of the renderer
+layout (set = 1, binding = 0) uniform sampler2D textures[];
+
+
+void main()
+{
+	outColor = material.color;
+	if (material.textureIndex != 0xFFFFFFFFu)
+		outColor *= texture(textures[nonuniformEXT(material.textureIndex)], fragTexCoord);
+}
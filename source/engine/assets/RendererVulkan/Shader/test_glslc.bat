@@ -1,4 +1,13 @@
 glslc test.vert -o test.vert.spv
 glslc test.frag -o test.frag.spv
+glslc object.vert -o object.vert.spv
+glslc mesh.vert -o mesh.vert.spv
+glslc object.frag -o object.frag.spv
+glslc object_bindless.frag -o object_bindless.frag.spv
+glslc cull.comp -o cull.comp.spv
+glslc cluster.comp -o cluster.comp.spv
+glslc --target-spv=spv1.4 meshlet.task -o meshlet.task.spv
+glslc --target-spv=spv1.4 meshlet.mesh -o meshlet.mesh.spv
+glslc meshlet.frag -o meshlet.frag.spv
 
 @pause
@@ -38,9 +38,26 @@ project "helios.engine"
 		-- assets
 		"assets/**.vert",
 		"assets/**.frag",
+		"assets/**.comp",
+		"assets/**.task",
+		"assets/**.mesh",
 	}
 
 
+	-- Shaders are compiled next to their source (same as test_glslc.bat),
+	-- so the SPIR-V of every shader exists and matches the GLSL
+	filter "files:assets/**.vert or assets/**.frag or assets/**.comp"
+		buildmessage "Compiling %{file.name}..."
+		buildcommands { "\"" .. VulkanGlslc() .. "\" \"%{file.abspath}\" -o \"%{file.abspath}.spv\"" }
+		buildoutputs { "%{file.abspath}.spv" }
+
+	-- Mesh shading needs SPIR-V 1.4
+	filter "files:assets/**.task or assets/**.mesh"
+		buildmessage "Compiling %{file.name}..."
+		buildcommands { "\"" .. VulkanGlslc() .. "\" --target-spv=spv1.4 \"%{file.abspath}\" -o \"%{file.abspath}.spv\"" }
+		buildoutputs { "%{file.abspath}.spv" }
+
+
 	filter "configurations:Debug"
 
 		defines {
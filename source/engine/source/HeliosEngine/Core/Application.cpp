@@ -120,17 +120,47 @@ namespace Helios {
 				LOG_CORE_INFO("CmdArg[{}] = \"{}\"", x, m_Specification.CommandLineArgs[x]);;
 		}
 
+		// Headless mode and size
+		auto& args = m_Specification.CommandLineArgs;
+		if (args.Check("headless"))
+			m_Specification.Headless = true;
+		m_Specification.Width = static_cast<uint32_t>(std::strtoul(args.Get("width", std::to_string(m_Specification.Width)).c_str(), nullptr, 10));
+		m_Specification.Height = static_cast<uint32_t>(std::strtoul(args.Get("height", std::to_string(m_Specification.Height)).c_str(), nullptr, 10));
+		if (m_Specification.Width == 0 or m_Specification.Height == 0)
+		{
+			LOG_CORE_WARN("Invalid size {}x{}, using 800x600!", m_Specification.Width, m_Specification.Height);
+			m_Specification.Width = 800;
+			m_Specification.Height = 600;
+		}
+		if (m_Specification.Headless)
+			LOG_CORE_INFO("Running headless ({}x{}).", m_Specification.Width, m_Specification.Height);
+
 		// Load config
 		Config::Init(m_Specification.configfile, m_Specification.WorkingDirectory);
 
 		Assets::Init(m_Specification.WorkingDirectory);
 
+		// Init frame limiter
+		m_FrameLimiter.SetLimit(std::strtof(Config::Get("FrameLimit", "0").c_str(), nullptr));
+		if (m_FrameLimiter.GetLimit() > 0.0f)
+			LOG_CORE_INFO("Frame limit: {} fps", m_FrameLimiter.GetLimit());
+
 		// Init Window/renderer
 		Renderer::Setup();
-		m_Window = Window::Create(WindowSpecification(m_Specification.Name));
-		m_Window->SetEventCallback(HE_BIND_EVENT_FN(Application::OnEvent));
+		if (!m_Specification.Headless)
+		{
+			m_Window = Window::Create(WindowSpecification(m_Specification.Name, m_Specification.Width, m_Specification.Height));
+			m_Window->SetEventCallback(HE_BIND_EVENT_FN(Application::OnEvent));
+		}
 		Renderer::Init();
 
+		// Frame capture for regression tests
+		if (args.Check("capture"))
+		{
+			uint32_t interval = static_cast<uint32_t>(std::strtoul(args.Get("capture", "1").c_str(), nullptr, 10));
+			Renderer::Get()->StartCaptureStream(args.Get("capture_path", "Capture/frame"), interval ? interval : 1, args.Get("capture_format", "ppm"));
+		}
+
 //		static std::string inipath = m_Specification.WorkingDirectory;
 //		inipath += "/imgui.ini";
 //		m_ImGuiLayer = new ImGuiLayer(inipath);
@@ -154,8 +184,9 @@ namespace Helios {
 		m_LayerStack.PushLayer(layer);
 		layer->OnAttach();
 
-		int size_x, size_y;
-		glfwGetWindowSize((GLFWwindow*)m_Window->GetNativeWindow(), &size_x, &size_y);
+		int size_x = m_Specification.Width, size_y = m_Specification.Height;
+		if (m_Window)
+			glfwGetWindowSize((GLFWwindow*)m_Window->GetNativeWindow(), &size_x, &size_y);
 		WindowResizeEvent event(size_x, size_y);
 		OnEvent(event);
 	}
@@ -166,13 +197,21 @@ namespace Helios {
 		m_LayerStack.PushOverlay(layer);
 		layer->OnAttach();
 
-		int size_x, size_y;
-		glfwGetWindowSize((GLFWwindow*)m_Window->GetNativeWindow(), &size_x, &size_y);
+		int size_x = m_Specification.Width, size_y = m_Specification.Height;
+		if (m_Window)
+			glfwGetWindowSize((GLFWwindow*)m_Window->GetNativeWindow(), &size_x, &size_y);
 		WindowResizeEvent event(size_x, size_y);
 		OnEvent(event);
 	}
 
 
+	void Application::SetFrameLimit(float fps)
+	{
+		m_FrameLimiter.SetLimit(fps);
+		Config::Set("FrameLimit", std::to_string(m_FrameLimiter.GetLimit()));
+	}
+
+
 	void Application::Close()
 	{
 		m_Running = false;
@@ -196,9 +235,20 @@ namespace Helios {
 
 	void Application::Run()
 	{
+		if (m_Specification.Headless)
+		{
+			RunHeadless();
+			return;
+		}
+
 		Timer RunLoopTimer;
 		while (m_Running)
 		{
+			// Wait for the next frame slot and poll events just before the
+			// frame is processed to keep the input latency low
+			m_FrameLimiter.Wait();
+			m_Window->OnUpdate();
+
 			Timestep timestep = RunLoopTimer.Elapsed();
 			RunLoopTimer.Reset();
 
@@ -261,10 +311,87 @@ namespace Helios {
 //					m_ImGuiLayer->End();
 //				}
 			}
+		}
+	}
 
-			// Poll events and so on
-			m_Window->OnUpdate();
+
+	void Application::RunHeadless()
+	{
+		auto& args = m_Specification.CommandLineArgs;
+		uint32_t frames = static_cast<uint32_t>(std::strtoul(args.Get("frames", "1000").c_str(), nullptr, 10));
+		uint32_t warmup = static_cast<uint32_t>(std::strtoul(args.Get("warmup", "100").c_str(), nullptr, 10));
+
+		LOG_CORE_INFO("Rendering {} frames (+{} warmup frames)...", frames, warmup);
+
+		std::vector<float> cpuTimes;
+		std::vector<float> gpuTimes;
+		cpuTimes.reserve(frames);
+		gpuTimes.reserve(frames);
+		// State changes of all measured frames
+		RenderQueueStats states;
+
+		Timer RunLoopTimer;
+		Timer TotalTimer;
+		for (uint32_t i = 0; m_Running and i < warmup + frames; i++)
+		{
+			if (i == warmup)
+				TotalTimer.Reset();
+
+			Timestep timestep = RunLoopTimer.Elapsed();
+			RunLoopTimer.Reset();
+
+			for (Layer* layer : m_LayerStack)
+				layer->OnUpdate(timestep);
+
+			Renderer::Get()->Render();
+
+			if (i < warmup)
+				continue;
+			// Includes waiting for a free frame in flight, so it is bound by the GPU
+			cpuTimes.push_back(RunLoopTimer.ElapsedMillis());
+			if (float gpu = Renderer::Get()->GetGPUFrameTime(); gpu > 0.0f)
+				gpuTimes.push_back(gpu);
+
+			RenderQueueStats frameStates = Renderer::Get()->GetRenderQueueStats();
+			states.draws += frameStates.draws;
+			states.pipelineBinds += frameStates.pipelineBinds;
+			states.pipelineBindsSkipped += frameStates.pipelineBindsSkipped;
+			states.vertexBufferBinds += frameStates.vertexBufferBinds;
+			states.vertexBufferBindsSkipped += frameStates.vertexBufferBindsSkipped;
 		}
+		float total = TotalTimer.Elapsed();
+
+		if (cpuTimes.empty())
+		{
+			LOG_CORE_WARN("Not enough frames rendered for statistics!");
+			return;
+		}
+
+		auto report = [](const char* name, std::vector<float>& times)
+		{
+			if (times.empty())
+			{
+				LOG_CORE_INFO("{} frame time: not available", name);
+				return;
+			}
+
+			std::sort(times.begin(), times.end());
+			auto percentile = [&](float p) { return times[static_cast<size_t>(p * (times.size() - 1))]; };
+			float avg = std::accumulate(times.begin(), times.end(), 0.0f) / times.size();
+
+			LOG_CORE_INFO("{} frame time: avg {:.3f} ms, min {:.3f} ms, max {:.3f} ms, p50 {:.3f} ms, p95 {:.3f} ms, p99 {:.3f} ms",
+				name, avg, times.front(), times.back(), percentile(0.50f), percentile(0.95f), percentile(0.99f));
+		};
+
+		LOG_CORE_INFO("Headless run: {} frames in {:.3f} s ({:.1f} fps)", frames, total, frames / total);
+		report("CPU", cpuTimes);
+		report("GPU", gpuTimes);
+
+		uint32_t measured = static_cast<uint32_t>(cpuTimes.size());
+		LOG_CORE_INFO("Draws: {} per frame, pipeline binds: {} per frame ({} skipped), vertex buffer binds: {} per frame ({} skipped)",
+			states.draws / measured,
+			states.pipelineBinds / measured, states.pipelineBindsSkipped / measured,
+			states.vertexBufferBinds / measured, states.vertexBufferBindsSkipped / measured);
 	}
 
 
@@ -2,6 +2,7 @@
 
 #include "HeliosEngine/Core/Layer.h"
 #include "HeliosEngine/Core/Window.h"
+#include "HeliosEngine/Core/FrameLimiter.h"
 
 #include "HeliosEngine/Events/Event.h"
 #include "HeliosEngine/Events/ApplicationEvent.h"
@@ -52,6 +53,11 @@ namespace Helios {
 		std::string logfile = "HeliosEngine.log";
 		// Name of the configfile
 		std::string configfile = "HeliosEngine.cfg";
+		// Render offscreen without a window (also set by the "headless" argument)
+		bool Headless = false;
+		// Size of the window or the offscreen images
+		uint32_t Width = 800;
+		uint32_t Height = 600;
 	};
 
 
@@ -70,10 +76,18 @@ namespace Helios {
 		void PushLayer(Layer* layer);
 		void PushOverlay(Layer* layer);
 
+		// Only valid if not headless
 		Window& GetWindow() { return *m_Window; }
+		bool IsHeadless() const { return m_Specification.Headless; }
+
+		// Limit the framerate (0 = unlimited)
+		void SetFrameLimit(float fps);
+		float GetFrameLimit() const { return m_FrameLimiter.GetLimit(); }
 
 	private:
 		void Run();
+		// Renders a fixed number of frames as fast as possible and logs the frame times
+		void RunHeadless();
 		bool OnWindowClose(WindowCloseEvent& e);
 		bool OnWindowResize(WindowResizeEvent& e);
 		bool OnFramebufferResize(FramebufferResizeEvent& e);
@@ -85,6 +99,7 @@ namespace Helios {
 		bool m_Running = true;
 		bool m_Minimized = false;
 		LayerStack m_LayerStack;
+		FrameLimiter m_FrameLimiter;
 
 	private:
 		static Application* s_Instance;
@@ -24,6 +24,7 @@ namespace Helios::Assets {
 
 
 	std::vector<char> LoadRealFile(const std::string& filename);
+	bool ExistRealFile(const std::string& filename);
 
 
 	std::string s_BasePath;
@@ -62,6 +63,15 @@ namespace Helios::Assets {
 	}
 
 
+	bool Exist(const std::string& filename, const std::string& arcname)
+	{
+		if (arcname.empty())
+			return ExistRealFile(filename);
+		else
+			return ExistRealFile(arcname + "/" + filename);
+	}
+
+
     std::vector<char> LoadRealFile(const std::string& filename)
     {
 		// Open file
@@ -90,4 +100,14 @@ namespace Helios::Assets {
         return buffer;
     }
 
+
+	bool ExistRealFile(const std::string& filename)
+	{
+		std::string filepath = std::filesystem::path(s_BasePath + filename)
+			.make_preferred().string();
+
+		std::error_code err;
+		return std::filesystem::is_regular_file(filepath, err);
+	}
+
 } // namespace Helios::Asset
@@ -9,7 +9,7 @@ namespace Helios::Assets {
 	extern bool Close(const std::string& arcname);
 
 	extern std::vector<char> Load(const std::string& filename, const std::string& arcname = "");
-//	extern bool Exist(const std::string& filename, const std::string& arcname = "");
+	extern bool Exist(const std::string& filename, const std::string& arcname = "");
 
 //	extern bool Add(const std::string& filename, char* data, const std::string& arcname);
 //	extern bool Remove(const std::string& filename, const std::string& arcname);
@@ -22,6 +22,7 @@
 
 // Standart C/C++
 #include <algorithm>
+#include <numeric>
 #include <utility>
 #include <filesystem>
 #include <functional>
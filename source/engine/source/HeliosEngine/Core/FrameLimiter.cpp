@@ -0,0 +1,80 @@
+#include "pch.h"
+#include "FrameLimiter.h"
+
+#include <cmath>
+#include <thread>
+
+
+namespace Helios {
+
+
+	FrameLimiter::FrameLimiter(float fps)
+	{
+		SetLimit(fps);
+	}
+
+
+	void FrameLimiter::SetLimit(float fps)
+	{
+		m_Limit = std::max(fps, 0.0f);
+		if (m_Limit > 0.0f)
+			m_FrameTime = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / m_Limit));
+		else
+			m_FrameTime = std::chrono::steady_clock::duration::zero();
+		m_Last = std::chrono::steady_clock::now();
+	}
+
+
+	void FrameLimiter::Wait()
+	{
+		HE_PROFILER_FUNCTION();
+
+		if (m_FrameTime == std::chrono::steady_clock::duration::zero())
+			return;
+
+		auto target = m_Last + m_FrameTime;
+		auto now = std::chrono::steady_clock::now();
+
+		if (now < target)
+		{
+			SleepUntil(target);
+			m_Last = target;
+		}
+		else
+		{
+			// Keep the cadence if just a bit late, but don't try to catch up
+			// with frames which are lost anyway
+			m_Last = (now - target > m_FrameTime) ? now : target;
+		}
+	}
+
+
+	void FrameLimiter::SleepUntil(std::chrono::steady_clock::time_point target)
+	{
+		// Sleep in small steps as long as the remaining time is larger than
+		// the (pessimistic) estimation of how long a sleep really takes
+		while (true)
+		{
+			double remaining = std::chrono::duration<double>(target - std::chrono::steady_clock::now()).count();
+			if (remaining <= m_Estimate)
+				break;
+
+			auto start = std::chrono::steady_clock::now();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			double observed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			// Update mean and standard deviation (Welford)
+			++m_Count;
+			double delta = observed - m_Mean;
+			m_Mean += delta / m_Count;
+			m_M2 += delta * (observed - m_Mean);
+			m_Estimate = m_Mean + std::sqrt(m_M2 / (m_Count - 1));
+		}
+
+		// Spin for the rest
+		while (std::chrono::steady_clock::now() < target)
+			std::this_thread::yield();
+	}
+
+
+} // namespace Helios
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+
+
+namespace Helios {
+
+
+	class FrameLimiter
+	{
+	public:
+		FrameLimiter(float fps = 0.0f);
+
+		// Set the target framerate (0 = unlimited)
+		void SetLimit(float fps);
+		float GetLimit() const { return m_Limit; }
+
+		// Sleep until the target frame time of the current frame is reached
+		void Wait();
+
+	private:
+		void SleepUntil(std::chrono::steady_clock::time_point target);
+
+	private:
+		float m_Limit = 0.0f;
+		std::chrono::steady_clock::duration m_FrameTime{ 0 };
+		std::chrono::steady_clock::time_point m_Last;
+
+		// Estimation of the real duration of a 1ms sleep (in seconds)
+		double m_Estimate = 5e-3;
+		double m_Mean = 5e-3;
+		double m_M2 = 0.0;
+		int64_t m_Count = 1;
+	};
+
+
+} // namespace Helios
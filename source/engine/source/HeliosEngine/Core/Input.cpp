@@ -13,6 +13,10 @@ namespace Helios {
 	{
 		HE_PROFILER_FUNCTION();
 
+		// No input without a window
+		if (Application::Get().IsHeadless())
+			return false;
+
 		auto* window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
 		auto state = glfwGetKey(window, static_cast<int32_t>(key));
 
@@ -24,6 +28,9 @@ namespace Helios {
 	{
 		HE_PROFILER_FUNCTION();
 
+		if (Application::Get().IsHeadless())
+			return false;
+
 		auto* window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
 		auto state = glfwGetMouseButton(window, static_cast<int32_t>(button));
 
@@ -35,6 +42,9 @@ namespace Helios {
 	{
 		HE_PROFILER_FUNCTION();
 
+		if (Application::Get().IsHeadless())
+			return { 0.0f, 0.0f };
+
 		auto* window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
 		double xpos, ypos;
 		glfwGetCursorPos(window, &xpos, &ypos);
@@ -100,8 +100,7 @@ namespace Helios {
 //		m_Context->Init();
 
 		glfwSetWindowUserPointer(m_Window, &m_Data);
-		SetVSync(true);
-		SetVSync(false);
+		SetVSync(Renderer::IsVSync());
 
 		// Set GLFW callbacks
 		InitCallbacks();
@@ -129,6 +128,8 @@ namespace Helios {
 
 	void Window::SetVSync(bool enabled)
 	{
+		Renderer::SetVSync(enabled);
+
 		#ifdef BUILDWITH_RENDERER_OPENGL
 			if (Renderer::GetAPI() == RendererAPI::API::OpenGL)
 			{
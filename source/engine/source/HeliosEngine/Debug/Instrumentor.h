@@ -108,6 +108,41 @@ namespace Helios {
 		}
 
 
+		// GPU results are written to their own process track
+		void WriteGPUProfile(const std::string& name, FloatingPointMicroseconds start, std::chrono::microseconds elapsedTime)
+		{
+			std::stringstream json;
+
+			json << std::setprecision(3) << std::fixed;
+			if (!m_GPUTrackNamed)
+			{
+				json << ",{";
+				json << "\"args\":{\"name\":\"GPU\"},";
+				json << "\"name\":\"process_name\",";
+				json << "\"ph\":\"M\",";
+				json << "\"pid\":1";
+				json << "}";
+			}
+			json << ",{";
+			json << "\"cat\":\"gpu\",";
+			json << "\"dur\":" << (elapsedTime.count()) << ',';
+			json << "\"name\":\"" << name << "\",";
+			json << "\"ph\":\"X\",";
+			json << "\"pid\":1,";
+			json << "\"tid\":0,";
+			json << "\"ts\":" << start.count();
+			json << "}";
+
+			std::lock_guard lock(m_Mutex);
+			if (m_CurrentSession)
+			{
+				m_OutputStream << json.str();
+				m_OutputStream.flush();
+				m_GPUTrackNamed = true;
+			}
+		}
+
+
 		static Instrumentor& Get()
 		{
 			static Instrumentor instance;
@@ -152,6 +187,7 @@ namespace Helios {
 				m_OutputStream.close();
 				delete m_CurrentSession;
 				m_CurrentSession = nullptr;
+				m_GPUTrackNamed = false;
 			}
 		}
 
@@ -160,6 +196,7 @@ namespace Helios {
 		std::mutex m_Mutex;
 		InstrumentationSession* m_CurrentSession;
 		std::ofstream m_OutputStream;
+		bool m_GPUTrackNamed = false;
 	};
 
 
@@ -265,6 +302,7 @@ namespace Helios {
 #	define HE_PROFILER_SCOPE_LINE(name, line) HE_PROFILER_SCOPE_LINE2(name, line)
 #	define HE_PROFILER_SCOPE(name) HE_PROFILER_SCOPE_LINE(name, __LINE__)
 #	define HE_PROFILER_FUNCTION() HE_PROFILER_SCOPE(HE_FUNC_SIG)
+#	define HE_PROFILER_GPU_RESULT(name, start, elapsed) ::Helios::Instrumentor::Get().WriteGPUProfile(name, start, elapsed)
 
 #else // if HE_PROFILER_ENABLE == 0 or undefined
 
@@ -272,5 +310,6 @@ namespace Helios {
 #	define HE_PROFILER_END_SESSION()
 #	define HE_PROFILER_SCOPE(name)
 #	define HE_PROFILER_FUNCTION()
+#	define HE_PROFILER_GPU_RESULT(name, start, elapsed)
 
 #endif // if HE_PROFILER_ENABLE
@@ -55,4 +55,43 @@ namespace Helios::Component {
 	};
 
 
+	// Bounding volumes in model space, entities with Bounds and a Transform
+	// are culled by the CullingSystem
+	struct Bounds
+	{
+		glm::vec3 center = { 0.0f, 0.0f, 0.0f };
+		// Half size of the box around the center
+		glm::vec3 extents = { 0.0f, 0.0f, 0.0f };
+		// Sphere around the center (might be smaller than the box)
+		float radius = 0.0f;
+		// The box is solid and hides everything behind it (occlusion culling)
+		bool occluder = false;
+
+		Bounds() = default;
+		Bounds(const Bounds&) = default;
+		Bounds(const glm::vec3& center, const glm::vec3& extents, bool occluder = false)
+			: center(center), extents(extents), radius(glm::length(extents)), occluder(occluder) {}
+	};
+
+
+	// Level of detail of a mesh, selected by its projected error on the screen
+	// (see LODSelector, the entity also needs a Transform)
+	struct MeshLOD
+	{
+		// Geometric error of every LOD in model units (LOD 0 first)
+		std::vector<float> errors;
+		// Radius of the bounding sphere in model units
+		float radius = 0.0f;
+		// Largest error on the screen in pixels
+		float maxPixelError = 1.0f;
+		// Selected LOD
+		uint32_t current = 0;
+
+		MeshLOD() = default;
+		MeshLOD(const MeshLOD&) = default;
+		MeshLOD(const std::vector<float>& errors, float radius)
+			: errors(errors), radius(radius) {}
+	};
+
+
 } // namespace Helios::ECS::Component
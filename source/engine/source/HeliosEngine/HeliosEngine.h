@@ -31,7 +31,7 @@
 //#include <HeliosEngine/Renderer/Buffer.h>
 //#include <HeliosEngine/Renderer/Framebuffer.h>
 //#include <HeliosEngine/Renderer/Shader.h>
-//#include <HeliosEngine/Renderer/Texture.h>
+#include <HeliosEngine/Renderer/Texture.h>
 //#include <HeliosEngine/Renderer/VertexArray.h>
 // Renderer (abstract)
 //#include <HeliosEngine/Renderer/SubTexture2D.h>
@@ -40,6 +40,10 @@
 //#include <HeliosEngine/Renderer/Camera/OrthographicCameraController.h>
 //#include <HeliosEngine/Renderer/Camera/UICameraController.h>
 #include <HeliosEngine/Renderer/Model.h>
+#include <HeliosEngine/Renderer/MeshLoader.h>
+#include <HeliosEngine/Renderer/LODSelector.h>
+#include <HeliosEngine/Renderer/CullingSystem.h>
+#include <HeliosEngine/Renderer/RenderQueue.h>
 
 // EntryPoint for the Application
 #include <HeliosEngine/Core/EntryPoint.h>
@@ -0,0 +1,216 @@
+#include "pch.h"
+#include "CullingSystem.h"
+
+#include "HeliosEngine/ECS/ECS.h"
+#include "HeliosEngine/ECS/Components.h"
+#include "HeliosEngine/Core/Config.h"
+
+// AVX only if the compiler may use it, SSE2 is part of every x86_64 CPU
+#if defined(__AVX__)
+#	include <immintrin.h>
+#	define HE_CULLING_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#	include <emmintrin.h>
+#	define HE_CULLING_SSE
+#endif
+
+
+namespace Helios {
+
+
+	void CullingBounds::Clear()
+	{
+		centerX.clear(); centerY.clear(); centerZ.clear();
+		radius.clear();
+		extentX.clear(); extentY.clear(); extentZ.clear();
+	}
+
+
+	void CullingBounds::Add(const glm::vec3& center, float r, const glm::vec3& extents)
+	{
+		centerX.push_back(center.x); centerY.push_back(center.y); centerZ.push_back(center.z);
+		radius.push_back(r);
+		extentX.push_back(extents.x); extentY.push_back(extents.y); extentZ.push_back(extents.z);
+	}
+
+
+	CullingSystem::CullingSystem()
+	{
+		if (Config::Get("OcclusionCulling", "1") != "0")
+			m_occlusion = CreateScope<OcclusionBuffer>();
+	}
+
+
+	void CullingSystem::Update(const glm::mat4& viewProjection, bool testFrustum)
+	{
+		m_bounds.Clear();
+		m_entities.clear();
+		m_occluders.clear();
+		m_visible.clear();
+
+		// World space bounds of all renderable entities
+		auto view = ECS::GetAllWith<Component::Transform, Component::Bounds>();
+		for (auto entity : view)
+		{
+			const auto& transform = view.template get<Component::Transform>(entity);
+			const auto& bounds = view.template get<Component::Bounds>(entity);
+
+			glm::mat4 matrix = transform.GetTransform();
+			glm::mat3 axes = glm::mat3(matrix);
+			glm::vec3 center = glm::vec3(matrix * glm::vec4(bounds.center, 1.0f));
+			float scale = std::max(std::max(glm::length(axes[0]), glm::length(axes[1])), glm::length(axes[2]));
+			glm::vec3 extents = glm::abs(axes[0]) * bounds.extents.x + glm::abs(axes[1]) * bounds.extents.y + glm::abs(axes[2]) * bounds.extents.z;
+
+			m_bounds.Add(center, bounds.radius * scale, extents);
+			m_entities.push_back(entity);
+			if (bounds.occluder)
+				m_occluders.push_back({ matrix, bounds.center, bounds.extents });
+		}
+
+		if (testFrustum)
+			CullFrustum(viewProjection, m_bounds, m_mask);
+		else
+			m_mask.assign(m_entities.size(), 1);
+
+		// Objects behind the occluders (an occluder never hides itself, its
+		// rasterized depth is not nearer than its nearest corner)
+		m_occlusionCulled = 0;
+		if (m_occlusion and !m_occluders.empty())
+		{
+			m_occlusion->Clear(viewProjection);
+			for (const auto& occluder : m_occluders)
+				m_occlusion->RasterizeBox(occluder.transform, occluder.center, occluder.extents);
+
+			for (size_t i = 0; i < m_entities.size(); i++)
+			{
+				if (!m_mask[i])
+					continue;
+				glm::vec3 center = { m_bounds.centerX[i], m_bounds.centerY[i], m_bounds.centerZ[i] };
+				glm::vec3 extents = { m_bounds.extentX[i], m_bounds.extentY[i], m_bounds.extentZ[i] };
+				if (!m_occlusion->IsVisible(center, extents))
+				{
+					m_mask[i] = 0;
+					m_occlusionCulled++;
+				}
+			}
+		}
+
+		for (size_t i = 0; i < m_entities.size(); i++)
+			if (m_mask[i])
+				m_visible.push_back(m_entities[i]);
+		m_frustumCulled = static_cast<uint32_t>(m_entities.size() - m_visible.size()) - m_occlusionCulled;
+	}
+
+
+	void CullingSystem::CullFrustum(const glm::mat4& viewProjection, const CullingBounds& bounds, std::vector<uint8_t>& visible)
+	{
+		glm::vec4 planes[6];
+		ExtractFrustum(viewProjection, planes);
+		glm::vec3 absNormals[6];
+		for (int p = 0; p < 6; p++)
+			absNormals[p] = glm::abs(glm::vec3(planes[p]));
+
+		size_t count = bounds.Size();
+		visible.resize(count);
+
+		// Outside if the center is farther behind a plane than the sphere or the
+		// box reaches: d < -min(radius, box radius along the normal)
+		size_t i = 0;
+#if defined(HE_CULLING_AVX)
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 cx = _mm256_loadu_ps(&bounds.centerX[i]);
+			__m256 cy = _mm256_loadu_ps(&bounds.centerY[i]);
+			__m256 cz = _mm256_loadu_ps(&bounds.centerZ[i]);
+			__m256 r = _mm256_loadu_ps(&bounds.radius[i]);
+			__m256 ex = _mm256_loadu_ps(&bounds.extentX[i]);
+			__m256 ey = _mm256_loadu_ps(&bounds.extentY[i]);
+			__m256 ez = _mm256_loadu_ps(&bounds.extentZ[i]);
+
+			__m256 outside = _mm256_setzero_ps();
+			for (int p = 0; p < 6; p++)
+			{
+				__m256 d = _mm256_add_ps(
+					_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes[p].x), cx), _mm256_mul_ps(_mm256_set1_ps(planes[p].y), cy)),
+					_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes[p].z), cz), _mm256_set1_ps(planes[p].w)));
+				__m256 boxRadius = _mm256_add_ps(
+					_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(absNormals[p].x), ex), _mm256_mul_ps(_mm256_set1_ps(absNormals[p].y), ey)),
+					_mm256_mul_ps(_mm256_set1_ps(absNormals[p].z), ez));
+				__m256 limit = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_min_ps(r, boxRadius));
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(d, limit, _CMP_LT_OQ));
+			}
+
+			int mask = _mm256_movemask_ps(outside);
+			for (int j = 0; j < 8; j++)
+				visible[i + j] = (mask >> j) & 1 ? 0 : 1;
+		}
+#elif defined(HE_CULLING_SSE)
+		for (; i + 8 <= count; i += 8)
+		{
+			int mask = 0;
+			for (size_t half = 0; half < 8; half += 4)
+			{
+				size_t k = i + half;
+				__m128 cx = _mm_loadu_ps(&bounds.centerX[k]);
+				__m128 cy = _mm_loadu_ps(&bounds.centerY[k]);
+				__m128 cz = _mm_loadu_ps(&bounds.centerZ[k]);
+				__m128 r = _mm_loadu_ps(&bounds.radius[k]);
+				__m128 ex = _mm_loadu_ps(&bounds.extentX[k]);
+				__m128 ey = _mm_loadu_ps(&bounds.extentY[k]);
+				__m128 ez = _mm_loadu_ps(&bounds.extentZ[k]);
+
+				__m128 outside = _mm_setzero_ps();
+				for (int p = 0; p < 6; p++)
+				{
+					__m128 d = _mm_add_ps(
+						_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes[p].x), cx), _mm_mul_ps(_mm_set1_ps(planes[p].y), cy)),
+						_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes[p].z), cz), _mm_set1_ps(planes[p].w)));
+					__m128 boxRadius = _mm_add_ps(
+						_mm_add_ps(_mm_mul_ps(_mm_set1_ps(absNormals[p].x), ex), _mm_mul_ps(_mm_set1_ps(absNormals[p].y), ey)),
+						_mm_mul_ps(_mm_set1_ps(absNormals[p].z), ez));
+					__m128 limit = _mm_sub_ps(_mm_setzero_ps(), _mm_min_ps(r, boxRadius));
+					outside = _mm_or_ps(outside, _mm_cmplt_ps(d, limit));
+				}
+				mask |= _mm_movemask_ps(outside) << half;
+			}
+
+			for (int j = 0; j < 8; j++)
+				visible[i + j] = (mask >> j) & 1 ? 0 : 1;
+		}
+#endif
+
+		// Remaining objects (or all without SIMD)
+		for (; i < count; i++)
+		{
+			bool outside = false;
+			for (int p = 0; p < 6 and !outside; p++)
+			{
+				float d = planes[p].x * bounds.centerX[i] + planes[p].y * bounds.centerY[i] + planes[p].z * bounds.centerZ[i] + planes[p].w;
+				float boxRadius = absNormals[p].x * bounds.extentX[i] + absNormals[p].y * bounds.extentY[i] + absNormals[p].z * bounds.extentZ[i];
+				outside = d < -std::min(bounds.radius[i], boxRadius);
+			}
+			visible[i] = outside ? 0 : 1;
+		}
+	}
+
+
+	void CullingSystem::ExtractFrustum(const glm::mat4& viewProjection, glm::vec4 planes[6])
+	{
+		// Rows of the matrix (glm is column major), clip space depth is 0...1
+		glm::vec4 row[4];
+		for (int i = 0; i < 4; i++)
+			row[i] = { viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i] };
+
+		planes[0] = row[3] + row[0]; // left
+		planes[1] = row[3] - row[0]; // right
+		planes[2] = row[3] + row[1]; // bottom
+		planes[3] = row[3] - row[1]; // top
+		planes[4] = row[2];          // near
+		planes[5] = row[3] - row[2]; // far
+
+		for (int i = 0; i < 6; i++)
+			planes[i] /= glm::length(glm::vec3(planes[i]));
+	}
+
+
+} // namespace Helios
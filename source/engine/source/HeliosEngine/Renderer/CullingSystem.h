@@ -0,0 +1,70 @@
+#pragma once
+
+#include "HeliosEngine/Renderer/OcclusionBuffer.h"
+
+
+namespace Helios {
+
+
+	// World space bounding volumes of the tested objects (structure of arrays)
+	struct CullingBounds
+	{
+		std::vector<float> centerX, centerY, centerZ;
+		std::vector<float> radius;
+		// Half extents of the axis aligned box around the center
+		std::vector<float> extentX, extentY, extentZ;
+
+		void Clear();
+		void Add(const glm::vec3& center, float radius, const glm::vec3& extents);
+		size_t Size() const { return radius.size(); }
+	};
+
+
+	// Culls the renderable entities (Component::Transform and Component::Bounds)
+	// on the CPU before anything is recorded:
+	// - frustum test of the spheres and boxes, 8 objects per iteration (AVX if
+	//   the engine is built with it, otherwise two SSE halves)
+	// - optional occlusion test against the occluders in a coarse depth buffer
+	//   (Config "OcclusionCulling")
+	class CullingSystem
+	{
+	public:
+		CullingSystem();
+
+		// Tests all renderable entities against the camera
+		// (only against the occluders if the frustum is tested on the GPU)
+		void Update(const glm::mat4& viewProjection, bool testFrustum = true);
+		// Visible entities of the last update
+		const std::vector<entt::entity>& GetVisible() const { return m_visible; }
+
+		// Statistics of the last update
+		uint32_t GetTestedCount() const { return static_cast<uint32_t>(m_entities.size()); }
+		uint32_t GetFrustumCulledCount() const { return m_frustumCulled; }
+		uint32_t GetOcclusionCulledCount() const { return m_occlusionCulled; }
+
+		// Writes 1 for every object which intersects the frustum, 0 otherwise
+		static void CullFrustum(const glm::mat4& viewProjection, const CullingBounds& bounds, std::vector<uint8_t>& visible);
+		// Normalized planes (xyz normal, w distance) pointing inside, clip space depth is 0...1
+		static void ExtractFrustum(const glm::mat4& viewProjection, glm::vec4 planes[6]);
+
+	private:
+		struct Occluder
+		{
+			glm::mat4 transform;
+			glm::vec3 center;
+			glm::vec3 extents;
+		};
+
+		CullingBounds m_bounds;
+		std::vector<entt::entity> m_entities;
+		std::vector<Occluder> m_occluders;
+		std::vector<uint8_t> m_mask;
+		std::vector<entt::entity> m_visible;
+
+		Scope<OcclusionBuffer> m_occlusion;
+		uint32_t m_frustumCulled = 0;
+		uint32_t m_occlusionCulled = 0;
+	};
+
+
+} // namespace Helios
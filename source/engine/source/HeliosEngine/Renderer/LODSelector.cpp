@@ -0,0 +1,58 @@
+#include "pch.h"
+#include "LODSelector.h"
+
+#include "HeliosEngine/ECS/ECS.h"
+
+
+namespace Helios {
+
+
+	void LODSelector::Update(const glm::vec3& cameraPosition, float fovY, float viewportHeight)
+	{
+		float projectionScale = GetProjectionScale(fovY, viewportHeight);
+
+		auto view = ECS::GetAllWith<Component::Transform, Component::MeshLOD>();
+		view.each([&](Component::Transform& transform, Component::MeshLOD& lod)
+			{
+				lod.current = Select(lod, transform, cameraPosition, projectionScale);
+			});
+	}
+
+
+	float LODSelector::GetProjectionScale(float fovY, float viewportHeight)
+	{
+		return viewportHeight / (2.0f * std::tan(fovY * 0.5f));
+	}
+
+
+	uint32_t LODSelector::Select(const Component::MeshLOD& lod, const Component::Transform& transform,
+		const glm::vec3& cameraPosition, float projectionScale)
+	{
+		if (lod.errors.empty())
+			return 0;
+
+		// Distance to the nearest point of the bounding sphere (the sphere is
+		// centered at the origin of the entity, inside of it everything is full detail)
+		float scale = std::max(std::max(std::abs(transform.scale.x), std::abs(transform.scale.y)), std::abs(transform.scale.z));
+		float distance = glm::length(transform.translation - cameraPosition) - lod.radius * scale;
+		if (distance <= 0.0f)
+			return 0;
+
+		// Error in pixels per model unit of error
+		float pixelsPerUnit = scale * projectionScale / distance;
+		uint32_t current = std::min(lod.current, static_cast<uint32_t>(lod.errors.size()) - 1);
+
+		uint32_t selected = 0;
+		for (uint32_t i = 1; i < lod.errors.size(); i++)
+		{
+			float threshold = (i > current) ? lod.maxPixelError * HYSTERESIS : lod.maxPixelError;
+			if (lod.errors[i] * pixelsPerUnit > threshold)
+				break;
+			selected = i;
+		}
+
+		return selected;
+	}
+
+
+} // namespace Helios
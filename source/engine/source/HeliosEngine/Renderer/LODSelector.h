@@ -0,0 +1,31 @@
+#pragma once
+
+#include "HeliosEngine/ECS/Components.h"
+
+
+namespace Helios {
+
+
+	// Selects the LOD of meshes by the size of their geometric error on the
+	// screen: the coarsest LOD whose error stays below Component::MeshLOD::maxPixelError.
+	// Switching to a coarser LOD needs some headroom, so entities close to a
+	// threshold do not flip between two LODs every frame.
+	class LODSelector
+	{
+	public:
+		// Updates all entities with a Transform and a MeshLOD
+		// (vertical field of view in radians, viewport height in pixels)
+		static void Update(const glm::vec3& cameraPosition, float fovY, float viewportHeight);
+
+		// Pixels per model unit at a distance of one unit
+		static float GetProjectionScale(float fovY, float viewportHeight);
+		static uint32_t Select(const Component::MeshLOD& lod, const Component::Transform& transform,
+			const glm::vec3& cameraPosition, float projectionScale);
+
+	private:
+		// Fraction of the threshold a coarser LOD has to stay below
+		static constexpr float HYSTERESIS = 0.8f;
+	};
+
+
+} // namespace Helios
@@ -0,0 +1,134 @@
+#include "pch.h"
+#include "MeshLoader.h"
+
+#include "HeliosEngine/Renderer/MeshletBuilder.h"
+
+#include "HeliosEngine/Core/Assets.h"
+#include "HeliosEngine/Core/Config.h"
+
+
+namespace Helios {
+
+
+	bool MeshLoader::Load(const std::string& filename, const std::string& arcname, MeshData& data)
+	{
+		std::string ext = std::filesystem::path(filename).extension().string();
+		std::transform(ext.begin(), ext.end(), ext.begin(),
+			[](unsigned char c) { return std::tolower(c); });
+
+		std::vector<char> file = Assets::Load(filename, arcname);
+
+		bool result = false;
+		if (ext == ".hmesh")
+			result = LoadHMesh(file, data);
+		else
+			LOG_CORE_ERROR("Unsupported mesh file type: \"{}\"", filename);
+
+		if (!result)
+		{
+			LOG_CORE_ERROR("Failed to load mesh: \"{}\"", filename);
+			return false;
+		}
+
+		if (Config::Get("Meshlets", "1") != "0")
+			MeshletBuilder::Build(data);
+		return true;
+	}
+
+
+	namespace {
+
+		template<typename T>
+		T ReadValue(const std::vector<char>& file, size_t offset)
+		{
+			T value{};
+			if (offset + sizeof(T) <= file.size())
+				std::memcpy(&value, file.data() + offset, sizeof(T));
+			return value;
+		}
+
+	} // namespace
+
+
+	bool MeshLoader::LoadHMesh(const std::vector<char>& file, MeshData& data)
+	{
+		static const uint32_t HEADER_SIZE = 36;
+		static const uint32_t LOD_SIZE = 12;
+		static const uint32_t VERTEX_SIZE = 16;
+
+		if (file.size() < HEADER_SIZE or std::memcmp(file.data(), "HMSH", 4) != 0)
+			return false;
+
+		uint32_t version = ReadValue<uint32_t>(file, 4);
+		uint32_t vertexCount = ReadValue<uint32_t>(file, 8);
+		uint32_t indexCount = ReadValue<uint32_t>(file, 12);
+		uint32_t lodCount = ReadValue<uint32_t>(file, 16);
+		if (version != 1)
+		{
+			LOG_CORE_ERROR("Unsupported mesh version: {}", version);
+			return false;
+		}
+		if (vertexCount == 0 or indexCount == 0 or lodCount == 0)
+			return false;
+
+		size_t lodOffset = HEADER_SIZE;
+		size_t vertexOffset = lodOffset + static_cast<size_t>(lodCount) * LOD_SIZE;
+		size_t indexOffset = vertexOffset + static_cast<size_t>(vertexCount) * VERTEX_SIZE;
+		if (file.size() < indexOffset + static_cast<size_t>(indexCount) * sizeof(uint32_t))
+		{
+			LOG_CORE_ERROR("Mesh file is truncated!");
+			return false;
+		}
+
+		data.BoundingSphere = {
+			ReadValue<float>(file, 20),
+			ReadValue<float>(file, 24),
+			ReadValue<float>(file, 28),
+			ReadValue<float>(file, 32) };
+
+		data.LODs.resize(lodCount);
+		for (uint32_t i = 0; i < lodCount; i++)
+		{
+			size_t entry = lodOffset + static_cast<size_t>(i) * LOD_SIZE;
+			data.LODs[i].IndexOffset = ReadValue<uint32_t>(file, entry);
+			data.LODs[i].IndexCount = ReadValue<uint32_t>(file, entry + 4);
+			data.LODs[i].Error = ReadValue<float>(file, entry + 8);
+
+			if (static_cast<uint64_t>(data.LODs[i].IndexOffset) + data.LODs[i].IndexCount > indexCount)
+			{
+				LOG_CORE_ERROR("Mesh LOD #{} is out of range!", i);
+				return false;
+			}
+		}
+
+		data.Vertices.resize(vertexCount);
+		for (uint32_t i = 0; i < vertexCount; i++)
+		{
+			size_t entry = vertexOffset + static_cast<size_t>(i) * VERTEX_SIZE;
+			data.Vertices[i].pos = {
+				ReadValue<float>(file, entry),
+				ReadValue<float>(file, entry + 4),
+				ReadValue<float>(file, entry + 8) };
+			data.Vertices[i].color = glm::vec4(
+				static_cast<uint8_t>(file[entry + 12]),
+				static_cast<uint8_t>(file[entry + 13]),
+				static_cast<uint8_t>(file[entry + 14]),
+				static_cast<uint8_t>(file[entry + 15])) / 255.0f;
+		}
+
+		data.Indices.resize(indexCount);
+		std::memcpy(data.Indices.data(), file.data() + indexOffset, static_cast<size_t>(indexCount) * sizeof(uint32_t));
+		for (uint32_t index : data.Indices)
+		{
+			if (index >= vertexCount)
+			{
+				LOG_CORE_ERROR("Mesh index {} is out of range!", index);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+
+} // namespace Helios
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "HeliosEngine/Renderer/Model.h"
+
+
+namespace Helios {
+
+
+	struct MeshLODData
+	{
+		// Range in the index buffer
+		uint32_t IndexOffset = 0;
+		uint32_t IndexCount = 0;
+		// Largest distance of the simplified surface to the original one (model units)
+		float Error = 0.0f;
+	};
+
+
+	// Cluster of up to MAX_VERTICES vertices and MAX_TRIANGLES triangles of LOD 0
+	// (see MeshletBuilder)
+	struct MeshletData
+	{
+		// Range in MeshData::MeshletVertices
+		uint32_t VertexOffset = 0;
+		uint32_t VertexCount = 0;
+		// Range in MeshData::MeshletTriangles (three local vertex indices per triangle)
+		uint32_t TriangleOffset = 0;
+		uint32_t TriangleCount = 0;
+		// Bounding sphere in model space (xyz center, w radius)
+		glm::vec4 BoundingSphere{ 0.0f };
+		// Normal cone (xyz axis, w cutoff), the meshlet faces away from the camera if
+		// dot(center - camera, axis) >= cutoff * length(center - camera) + radius
+		glm::vec4 Cone{ 0.0f, 0.0f, 0.0f, 1.0f };
+	};
+
+
+	// Decoded mesh data, independent of the renderer API
+	struct MeshData
+	{
+		std::vector<ModelVertexData> Vertices;
+		// Indices of all LODs (every LOD indexes the same vertices)
+		std::vector<uint32_t> Indices;
+		// LOD 0 is the full detail, every following LOD is coarser
+		std::vector<MeshLODData> LODs;
+		// Bounding sphere in model space (xyz center, w radius)
+		glm::vec4 BoundingSphere{ 0.0f };
+
+		// Meshlets of LOD 0 (empty if Config "Meshlets" is 0)
+		std::vector<MeshletData> Meshlets;
+		// Indices into Vertices
+		std::vector<uint32_t> MeshletVertices;
+		// Indices into the vertices of the meshlet
+		std::vector<uint8_t> MeshletTriangles;
+	};
+
+
+	class MeshLoader
+	{
+	public:
+		// Supported: .hmesh (written by the mesh compiler tool)
+		// LOD 0 is split into meshlets unless Config "Meshlets" is 0
+		static bool Load(const std::string& filename, const std::string& arcname, MeshData& data);
+
+	private:
+		static bool LoadHMesh(const std::vector<char>& file, MeshData& data);
+	};
+
+
+} // namespace Helios
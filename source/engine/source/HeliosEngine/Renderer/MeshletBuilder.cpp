@@ -0,0 +1,119 @@
+#include "pch.h"
+#include "MeshletBuilder.h"
+
+
+namespace Helios {
+
+
+	void MeshletBuilder::Build(MeshData& data)
+	{
+		data.Meshlets.clear();
+		data.MeshletVertices.clear();
+		data.MeshletTriangles.clear();
+		if (data.LODs.empty())
+			return;
+
+		const MeshLODData& lod = data.LODs[0];
+
+		// Slot of every vertex in the current meshlet (0xFF if it is not used yet)
+		std::vector<uint8_t> slots(data.Vertices.size(), 0xFF);
+		MeshletData meshlet;
+
+		auto flush = [&]()
+			{
+				if (meshlet.TriangleCount == 0)
+					return;
+
+				for (uint32_t i = 0; i < meshlet.VertexCount; i++)
+					slots[data.MeshletVertices[meshlet.VertexOffset + i]] = 0xFF;
+				ComputeBounds(data, meshlet);
+				data.Meshlets.push_back(meshlet);
+
+				meshlet = MeshletData();
+				meshlet.VertexOffset = static_cast<uint32_t>(data.MeshletVertices.size());
+				meshlet.TriangleOffset = static_cast<uint32_t>(data.MeshletTriangles.size());
+			};
+
+		for (uint32_t i = 0; i + 2 < lod.IndexCount; i += 3)
+		{
+			const uint32_t* triangle = &data.Indices[lod.IndexOffset + i];
+
+			uint32_t newVertices = 0;
+			for (uint32_t j = 0; j < 3; j++)
+				if (slots[triangle[j]] == 0xFF and (j < 1 or triangle[j] != triangle[0]) and (j < 2 or triangle[j] != triangle[1]))
+					newVertices++;
+			if (meshlet.VertexCount + newVertices > MAX_VERTICES or meshlet.TriangleCount >= MAX_TRIANGLES)
+				flush();
+
+			for (uint32_t j = 0; j < 3; j++)
+			{
+				uint8_t& slot = slots[triangle[j]];
+				if (slot == 0xFF)
+				{
+					slot = static_cast<uint8_t>(meshlet.VertexCount++);
+					data.MeshletVertices.push_back(triangle[j]);
+				}
+				data.MeshletTriangles.push_back(slot);
+			}
+			meshlet.TriangleCount++;
+		}
+		flush();
+
+		LOG_CORE_DEBUG("Built {} meshlets from {} triangles", data.Meshlets.size(), lod.IndexCount / 3);
+	}
+
+
+	void MeshletBuilder::ComputeBounds(const MeshData& data, MeshletData& meshlet)
+	{
+		auto position = [&](uint32_t slot)
+			{
+				return data.Vertices[data.MeshletVertices[meshlet.VertexOffset + slot]].pos;
+			};
+
+		// Sphere around the center of the bounding box
+		glm::vec3 min = position(0);
+		glm::vec3 max = position(0);
+		for (uint32_t i = 1; i < meshlet.VertexCount; i++)
+		{
+			min = glm::min(min, position(i));
+			max = glm::max(max, position(i));
+		}
+		glm::vec3 center = (min + max) * 0.5f;
+		float radius = 0.0f;
+		for (uint32_t i = 0; i < meshlet.VertexCount; i++)
+			radius = std::max(radius, glm::length(position(i) - center));
+		meshlet.BoundingSphere = { center, radius };
+
+		// Normal cone around the average normal of the triangles
+		std::vector<glm::vec3> normals;
+		glm::vec3 axis(0.0f);
+		for (uint32_t i = 0; i < meshlet.TriangleCount; i++)
+		{
+			const uint8_t* triangle = &data.MeshletTriangles[meshlet.TriangleOffset + i * 3];
+			glm::vec3 normal = glm::cross(position(triangle[1]) - position(triangle[0]), position(triangle[2]) - position(triangle[0]));
+			float area = glm::length(normal);
+			if (area <= 0.0f)
+				continue;
+			normals.push_back(normal / area);
+			axis += normals.back();
+		}
+
+		// Without a common direction the meshlet is never culled (cutoff 1)
+		meshlet.Cone = { 0.0f, 0.0f, 0.0f, 1.0f };
+		float length = glm::length(axis);
+		if (normals.empty() or length <= 0.0f)
+			return;
+		axis /= length;
+
+		float minDot = 1.0f;
+		for (const auto& normal : normals)
+			minDot = std::min(minDot, glm::dot(axis, normal));
+		if (minDot <= 0.1f)
+			return;
+
+		// Sine of the largest angle between the axis and a normal
+		meshlet.Cone = { axis, std::sqrt(1.0f - minDot * minDot) };
+	}
+
+
+} // namespace Helios
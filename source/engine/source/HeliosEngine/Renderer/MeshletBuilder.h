@@ -0,0 +1,26 @@
+#pragma once
+
+#include "HeliosEngine/Renderer/MeshLoader.h"
+
+
+namespace Helios {
+
+
+	// Splits LOD 0 of a mesh into meshlets for cluster culling and mesh shaders.
+	// Triangles are added in index order (the mesh compiler keeps neighbours
+	// together) until a meshlet runs out of vertices or triangles.
+	class MeshletBuilder
+	{
+	public:
+		static constexpr uint32_t MAX_VERTICES = 64;
+		static constexpr uint32_t MAX_TRIANGLES = 124;
+
+		// Fills Meshlets, MeshletVertices and MeshletTriangles of the mesh
+		static void Build(MeshData& data);
+
+	private:
+		static void ComputeBounds(const MeshData& data, MeshletData& meshlet);
+	};
+
+
+} // namespace Helios
@@ -48,6 +48,31 @@ namespace Helios {
 	}
 
 
+	Ref<Model> Model::Create(const std::string& filename, const std::string& arcname)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None: LOG_CORE_EXCEPT("RendererAPI::None is not supported!"); return nullptr;
+
+		// related on build options and platform
+#		ifdef BUILDWITH_RENDERER_DIRECTX
+			case RendererAPI::API::DirectX: return CreateRef<DXModel>(filename, arcname);
+#		endif
+#		ifdef BUILDWITH_RENDERER_METAL
+			case RendererAPI::API::Metal: return CreateRef<MTModel>(filename, arcname);
+#		endif
+#		ifdef BUILDWITH_RENDERER_VULKAN
+			case RendererAPI::API::Vulkan: return CreateRef<VKModel>(filename, arcname);
+#		endif
+#		ifdef BUILDWITH_RENDERER_OPENGL
+			case RendererAPI::API::OpenGL: return CreateRef<GLModel>(filename, arcname);
+#		endif
+
+		default: LOG_CORE_EXCEPT("Unknown or not implemented RendererAPI!"); return nullptr;
+		}
+	}
+
+
 	void Model::Load(const std::string& filename, const std::string& arcname)
 	{
 		Assets::Load(filename, arcname);
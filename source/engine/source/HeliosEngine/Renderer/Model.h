@@ -15,6 +15,8 @@ namespace Helios {
 	{
 	public:
 		static Ref<Model> Create();
+		// Loads a mesh with all of its LODs (see MeshLoader)
+		static Ref<Model> Create(const std::string& filename, const std::string& arcname = "");
 
 		Model() { LOG_CORE_DEBUG("Model::Model()"); }
 		~Model() { LOG_CORE_DEBUG("Model::~Model()"); }
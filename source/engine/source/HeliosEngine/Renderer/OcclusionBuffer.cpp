@@ -0,0 +1,132 @@
+#include "pch.h"
+#include "OcclusionBuffer.h"
+
+
+namespace Helios {
+
+
+	OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height)
+		: m_width(width), m_height(height)
+	{
+		m_depth.resize(static_cast<size_t>(m_width) * m_height, 1.0f);
+	}
+
+
+	void OcclusionBuffer::Clear(const glm::mat4& viewProjection)
+	{
+		m_viewProjection = viewProjection;
+		std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+	}
+
+
+	void OcclusionBuffer::RasterizeBox(const glm::mat4& transform, const glm::vec3& center, const glm::vec3& extents)
+	{
+		// Boxes crossing the near plane are skipped (they would need clipping)
+		glm::vec3 corners[8];
+		if (!ProjectBox(transform, center, extents, corners))
+			return;
+
+		// Two triangles per face, corners are indexed by the sign bits of x, y and z
+		static const uint8_t faces[6][4] = {
+			{ 0, 2, 4, 6 }, { 1, 3, 5, 7 },
+			{ 0, 1, 4, 5 }, { 2, 3, 6, 7 },
+			{ 0, 1, 2, 3 }, { 4, 5, 6, 7 } };
+		for (const auto& face : faces)
+		{
+			RasterizeTriangle(corners[face[0]], corners[face[1]], corners[face[3]]);
+			RasterizeTriangle(corners[face[0]], corners[face[3]], corners[face[2]]);
+		}
+	}
+
+
+	bool OcclusionBuffer::IsVisible(const glm::vec3& center, const glm::vec3& extents) const
+	{
+		glm::vec3 corners[8];
+		if (!ProjectBox(glm::mat4(1.0f), center, extents, corners))
+			return true;
+
+		glm::vec3 min = corners[0];
+		glm::vec3 max = corners[0];
+		for (int i = 1; i < 8; i++)
+		{
+			min = glm::min(min, corners[i]);
+			max = glm::max(max, corners[i]);
+		}
+
+		int x0 = std::max(static_cast<int>(std::floor(min.x)), 0);
+		int y0 = std::max(static_cast<int>(std::floor(min.y)), 0);
+		int x1 = std::min(static_cast<int>(std::ceil(max.x)), static_cast<int>(m_width));
+		int y1 = std::min(static_cast<int>(std::ceil(max.y)), static_cast<int>(m_height));
+		if (x0 >= x1 or y0 >= y1)
+			return true;
+
+		// Visible as soon as one pixel is not covered by a nearer occluder
+		for (int y = y0; y < y1; y++)
+		{
+			const float* row = &m_depth[static_cast<size_t>(y) * m_width];
+			for (int x = x0; x < x1; x++)
+				if (row[x] >= min.z)
+					return true;
+		}
+		return false;
+	}
+
+
+	bool OcclusionBuffer::ProjectBox(const glm::mat4& transform, const glm::vec3& center, const glm::vec3& extents, glm::vec3 corners[8]) const
+	{
+		glm::mat4 matrix = m_viewProjection * transform;
+		for (int i = 0; i < 8; i++)
+		{
+			glm::vec3 corner = center + glm::vec3(
+				(i & 1) ? extents.x : -extents.x,
+				(i & 2) ? extents.y : -extents.y,
+				(i & 4) ? extents.z : -extents.z);
+			glm::vec4 clip = matrix * glm::vec4(corner, 1.0f);
+			if (clip.w <= 1e-5f or clip.z < 0.0f)
+				return false;
+
+			glm::vec3 ndc = glm::vec3(clip) / clip.w;
+			corners[i] = {
+				(ndc.x * 0.5f + 0.5f) * m_width,
+				(ndc.y * 0.5f + 0.5f) * m_height,
+				ndc.z };
+		}
+		return true;
+	}
+
+
+	void OcclusionBuffer::RasterizeTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+	{
+		// Edge functions, both windings are drawn
+		float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		if (std::abs(area) < 1e-6f)
+			return;
+		float invArea = 1.0f / area;
+
+		int x0 = std::max(static_cast<int>(std::floor(std::min({ a.x, b.x, c.x }))), 0);
+		int y0 = std::max(static_cast<int>(std::floor(std::min({ a.y, b.y, c.y }))), 0);
+		int x1 = std::min(static_cast<int>(std::ceil(std::max({ a.x, b.x, c.x }))), static_cast<int>(m_width));
+		int y1 = std::min(static_cast<int>(std::ceil(std::max({ a.y, b.y, c.y }))), static_cast<int>(m_height));
+
+		for (int y = y0; y < y1; y++)
+		{
+			float* row = &m_depth[static_cast<size_t>(y) * m_width];
+			float py = y + 0.5f;
+			for (int x = x0; x < x1; x++)
+			{
+				// Sampled at the pixel center
+				float px = x + 0.5f;
+				float w0 = ((c.x - b.x) * (py - b.y) - (c.y - b.y) * (px - b.x)) * invArea;
+				float w1 = ((a.x - c.x) * (py - c.y) - (a.y - c.y) * (px - c.x)) * invArea;
+				float w2 = 1.0f - w0 - w1;
+				if (w0 < 0.0f or w1 < 0.0f or w2 < 0.0f)
+					continue;
+
+				float depth = w0 * a.z + w1 * b.z + w2 * c.z;
+				row[x] = std::min(row[x], depth);
+			}
+		}
+	}
+
+
+} // namespace Helios
@@ -0,0 +1,38 @@
+#pragma once
+
+
+namespace Helios {
+
+
+	// Coarse software depth buffer for occlusion culling on the CPU.
+	// Occluders (solid boxes) are rasterized with their depth, an object is
+	// hidden if every pixel of its screen rectangle is covered by something
+	// nearer than its nearest point. Depth is in clip space (0 near, 1 far).
+	class OcclusionBuffer
+	{
+	public:
+		OcclusionBuffer(uint32_t width = 256, uint32_t height = 128);
+
+		void Clear(const glm::mat4& viewProjection);
+		// Oriented box (center and half extents in model space)
+		void RasterizeBox(const glm::mat4& transform, const glm::vec3& center, const glm::vec3& extents);
+		// Axis aligned box in world space
+		bool IsVisible(const glm::vec3& center, const glm::vec3& extents) const;
+
+		uint32_t GetWidth() const { return m_width; }
+		uint32_t GetHeight() const { return m_height; }
+
+	private:
+		// Corners in pixels (xy) and depth (z), false if one is behind the near plane
+		bool ProjectBox(const glm::mat4& transform, const glm::vec3& center, const glm::vec3& extents, glm::vec3 corners[8]) const;
+		void RasterizeTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+
+	private:
+		uint32_t m_width;
+		uint32_t m_height;
+		std::vector<float> m_depth;
+		glm::mat4 m_viewProjection{ 1.0f };
+	};
+
+
+} // namespace Helios
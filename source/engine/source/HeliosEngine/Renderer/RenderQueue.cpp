@@ -0,0 +1,123 @@
+#include "pch.h"
+#include "RenderQueue.h"
+
+
+namespace Helios {
+
+
+	uint64_t RenderKey::Make(uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth)
+	{
+		auto field = [](uint32_t value, uint32_t shift, uint32_t bits) { return (static_cast<uint64_t>(value) & ((1ull << bits) - 1)) << shift; };
+
+		// Quantized depth, out of range values are clamped
+		constexpr float maxDepth = static_cast<float>((1u << DEPTH_BITS) - 1);
+		uint32_t quantized = static_cast<uint32_t>(std::clamp(depth, 0.0f, 1.0f) * maxDepth);
+
+		return field(pass, PASS_SHIFT, PASS_BITS)
+			| field(pipeline, PIPELINE_SHIFT, PIPELINE_BITS)
+			| field(material, MATERIAL_SHIFT, MATERIAL_BITS)
+			| field(mesh, MESH_SHIFT, MESH_BITS)
+			| field(quantized, DEPTH_SHIFT, DEPTH_BITS);
+	}
+
+
+	void RenderQueue::Clear()
+	{
+		m_keys.clear();
+		m_order.clear();
+		m_boundPipeline = NONE;
+		m_boundVertexBuffers = NONE;
+		m_stats = RenderQueueStats();
+	}
+
+
+	uint32_t RenderQueue::Submit(uint64_t key)
+	{
+		m_keys.push_back(key);
+		return static_cast<uint32_t>(m_keys.size() - 1);
+	}
+
+
+	void RenderQueue::Sort()
+	{
+		RadixSort(m_keys, m_order, m_temp);
+
+		// Nothing is bound at the beginning of the recording
+		m_boundPipeline = NONE;
+		m_boundVertexBuffers = NONE;
+	}
+
+
+	bool RenderQueue::BindPipeline(uint64_t pipeline)
+	{
+		if (pipeline == m_boundPipeline)
+		{
+			m_stats.pipelineBindsSkipped++;
+			return false;
+		}
+
+		m_boundPipeline = pipeline;
+		// A new pipeline keeps the vertex buffers bound
+		m_stats.pipelineBinds++;
+		return true;
+	}
+
+
+	bool RenderQueue::BindVertexBuffers(uint64_t mesh)
+	{
+		if (mesh == m_boundVertexBuffers)
+		{
+			m_stats.vertexBufferBindsSkipped++;
+			return false;
+		}
+
+		m_boundVertexBuffers = mesh;
+		m_stats.vertexBufferBinds++;
+		return true;
+	}
+
+
+	void RenderQueue::RadixSort(const std::vector<uint64_t>& keys, std::vector<uint32_t>& order, std::vector<uint32_t>& temp)
+	{
+		uint32_t count = static_cast<uint32_t>(keys.size());
+		order.resize(count);
+		temp.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+			order[i] = i;
+		if (count < 2)
+			return;
+
+		// Histograms of all bytes in one pass over the keys
+		std::array<std::array<uint32_t, 256>, 8> histograms{};
+		for (uint64_t key : keys)
+		{
+			for (uint32_t byte = 0; byte < 8; byte++)
+				histograms[byte][(key >> (byte * 8)) & 0xFF]++;
+		}
+
+		// Least significant byte first, every pass is stable
+		for (uint32_t byte = 0; byte < 8; byte++)
+		{
+			std::array<uint32_t, 256>& histogram = histograms[byte];
+			uint32_t shift = byte * 8;
+
+			// All keys share this byte (e.g. unused fields), the order does not change
+			if (histogram[(keys[0] >> shift) & 0xFF] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (uint32_t& bucket : histogram)
+			{
+				uint32_t size = bucket;
+				bucket = offset;
+				offset += size;
+			}
+
+			for (uint32_t index : order)
+				temp[histogram[(keys[index] >> shift) & 0xFF]++] = index;
+			order.swap(temp);
+		}
+	}
+
+
+} // namespace Helios
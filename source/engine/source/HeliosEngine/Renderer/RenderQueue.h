@@ -0,0 +1,95 @@
+#pragma once
+
+
+namespace Helios {
+
+
+	// Packed sort key of a draw, the most significant field sorts first:
+	//   pass (4 bits) | pipeline (12) | material (16) | mesh (16) | depth (16)
+	// Draws of one pass are grouped by their state, so the expensive changes
+	// (pipelines) happen least often. The depth (0...1 in view) sorts the draws
+	// with equal state front to back; transparent passes should use 1 - depth.
+	struct RenderKey
+	{
+		static constexpr uint32_t PASS_BITS = 4;
+		static constexpr uint32_t PIPELINE_BITS = 12;
+		static constexpr uint32_t MATERIAL_BITS = 16;
+		static constexpr uint32_t MESH_BITS = 16;
+		static constexpr uint32_t DEPTH_BITS = 16;
+
+		static constexpr uint32_t DEPTH_SHIFT = 0;
+		static constexpr uint32_t MESH_SHIFT = DEPTH_SHIFT + DEPTH_BITS;
+		static constexpr uint32_t MATERIAL_SHIFT = MESH_SHIFT + MESH_BITS;
+		static constexpr uint32_t PIPELINE_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS;
+		static constexpr uint32_t PASS_SHIFT = PIPELINE_SHIFT + PIPELINE_BITS;
+
+		// Ids are masked to their number of bits
+		static uint64_t Make(uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth);
+
+		static uint32_t GetPass(uint64_t key) { return Get(key, PASS_SHIFT, PASS_BITS); }
+		static uint32_t GetPipeline(uint64_t key) { return Get(key, PIPELINE_SHIFT, PIPELINE_BITS); }
+		static uint32_t GetMaterial(uint64_t key) { return Get(key, MATERIAL_SHIFT, MATERIAL_BITS); }
+		static uint32_t GetMesh(uint64_t key) { return Get(key, MESH_SHIFT, MESH_BITS); }
+
+	private:
+		static uint32_t Get(uint64_t key, uint32_t shift, uint32_t bits) { return static_cast<uint32_t>((key >> shift) & ((1ull << bits) - 1)); }
+	};
+
+
+	// State changes of the recorded draws
+	struct RenderQueueStats
+	{
+		uint32_t draws = 0;
+		uint32_t pipelineBinds = 0;
+		uint32_t pipelineBindsSkipped = 0;
+		uint32_t vertexBufferBinds = 0;
+		uint32_t vertexBufferBindsSkipped = 0;
+	};
+
+
+	// Draws of a frame, ordered by their sort keys.
+	// The queue only stores the keys, the data of the draws stays with the
+	// renderer (addressed by the index returned from Submit). The keys are
+	// sorted with a radix sort (8 bits per pass, passes over bytes which are
+	// equal for all keys are skipped), which is stable and linear in the number
+	// of draws. While recording, the queue remembers the bound state, so
+	// redundant binds are skipped and counted.
+	class RenderQueue
+	{
+	public:
+		// Removes all draws and resets the statistics
+		void Clear();
+		// Returns the index of the draw
+		uint32_t Submit(uint64_t key);
+		void Sort();
+
+		// Indices of the draws in sorted order
+		const std::vector<uint32_t>& GetOrder() const { return m_order; }
+		uint64_t GetKey(uint32_t draw) const { return m_keys[draw]; }
+		size_t Size() const { return m_keys.size(); }
+
+		// Return true if the state has to be bound (ids are not limited to the key bits)
+		bool BindPipeline(uint64_t pipeline);
+		bool BindVertexBuffers(uint64_t mesh);
+		// Counts a recorded draw
+		void Draw() { m_stats.draws++; }
+
+		// Statistics since the last clear
+		const RenderQueueStats& GetStats() const { return m_stats; }
+
+		// Sorts the indices by the keys (exposed for other users of the sort)
+		static void RadixSort(const std::vector<uint64_t>& keys, std::vector<uint32_t>& order, std::vector<uint32_t>& temp);
+
+	private:
+		std::vector<uint64_t> m_keys;
+		std::vector<uint32_t> m_order;
+		std::vector<uint32_t> m_temp;
+
+		static constexpr uint64_t NONE = UINT64_MAX;
+		uint64_t m_boundPipeline = NONE;
+		uint64_t m_boundVertexBuffers = NONE;
+		RenderQueueStats m_stats;
+	};
+
+
+} // namespace Helios
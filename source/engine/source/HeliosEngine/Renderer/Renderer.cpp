@@ -103,6 +103,14 @@ namespace Helios {
 
 		// Update config
 		Config::Set("RendererAPI", RendererAPI::GetAPIString());
+
+		// Check previous used present mode
+		std::string modestr = Config::Get("PresentMode", RendererAPI::GetPresentModeString());
+		if (auto mode = RendererAPI::GetPresentModeFromString(modestr))
+			RendererAPI::SetPresentMode(mode.value());
+		else
+			LOG_RENDER_INFO("Previously used present mode \"{}\" is unknown!", modestr);
+		LOG_RENDER_INFO("Selected present mode: {}.", RendererAPI::GetPresentModeString());
 	}
 
 
@@ -140,4 +148,32 @@ namespace Helios {
 	}
 
 
+	void Renderer::SetPresentMode(RendererAPI::PresentMode mode)
+	{
+		HE_PROFILER_FUNCTION();
+
+		if (mode == RendererAPI::GetPresentMode())
+			return;
+
+		LOG_RENDER_INFO("Changing present mode: {} -> {}.",
+			RendererAPI::GetPresentModeString(),
+			RendererAPI::GetPresentModeString(mode));
+		RendererAPI::SetPresentMode(mode);
+		Config::Set("PresentMode", RendererAPI::GetPresentModeString(mode));
+
+		// The renderer might not exist yet (e.g. while creating the window)
+		if (s_RendererAPI)
+			s_RendererAPI->OnPresentModeChanged();
+	}
+
+
+	void Renderer::SetVSync(bool enabled)
+	{
+		if (enabled == IsVSync())
+			return;
+
+		SetPresentMode(enabled ? RendererAPI::PresentMode::Fifo : RendererAPI::PresentMode::Mailbox);
+	}
+
+
 } // namespace Helios
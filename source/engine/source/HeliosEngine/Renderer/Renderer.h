@@ -16,6 +16,10 @@ namespace Helios {
 		static void OnWindowResize(uint32_t width, uint32_t height);
 		static void OnFramebufferResize(uint32_t width, uint32_t height);
 
+		static void SetPresentMode(RendererAPI::PresentMode mode);
+		static void SetVSync(bool enabled);
+		static bool IsVSync() { return RendererAPI::IsVSync(); }
+
 		static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
 		static RendererAPI* Get() { return s_RendererAPI.get(); }
 
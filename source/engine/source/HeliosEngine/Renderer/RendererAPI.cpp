@@ -20,6 +20,7 @@ namespace Helios {
 
 
 	RendererAPI::API RendererAPI::s_API = RendererAPI::API::None;
+	RendererAPI::PresentMode RendererAPI::s_PresentMode = RendererAPI::PresentMode::Mailbox;
 
 
 	const char* RendererAPI::GetAPIString(API api)
@@ -35,6 +36,29 @@ namespace Helios {
 		}
 	}
 
+	const char* RendererAPI::GetPresentModeString(PresentMode mode)
+	{
+		switch (mode)
+		{
+		case RendererAPI::PresentMode::Fifo:        return "Fifo";
+		case RendererAPI::PresentMode::FifoRelaxed: return "FifoRelaxed";
+		case RendererAPI::PresentMode::Mailbox:     return "Mailbox";
+		case RendererAPI::PresentMode::Immediate:   return "Immediate";
+		default: return "Unknown";
+		}
+	}
+
+
+	std::optional<RendererAPI::PresentMode> RendererAPI::GetPresentModeFromString(const std::string& mode)
+	{
+		if (mode == "Fifo")        return RendererAPI::PresentMode::Fifo;
+		if (mode == "FifoRelaxed") return RendererAPI::PresentMode::FifoRelaxed;
+		if (mode == "Mailbox")     return RendererAPI::PresentMode::Mailbox;
+		if (mode == "Immediate")   return RendererAPI::PresentMode::Immediate;
+		return std::nullopt;
+	}
+
+
 	Ref<RendererAPI> RendererAPI::Create()
 	{
 		switch (s_API)
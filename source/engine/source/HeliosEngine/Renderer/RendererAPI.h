@@ -1,5 +1,7 @@
 #pragma once
 
+#include "HeliosEngine/Renderer/RenderQueue.h"
+
 
 namespace Helios {
 
@@ -31,6 +33,14 @@ namespace Helios {
 			OpenGL
 		};
 
+		enum class PresentMode
+		{
+			Fifo = 0,    // V-Sync
+			FifoRelaxed, // V-Sync, but late frames are shown immediately
+			Mailbox,     // No tearing, newest frame replaces the queued one
+			Immediate    // No V-Sync, tearing possible
+		};
+
 	public:
 		virtual void Init() = 0;
 		virtual void Shutdown() = 0;
@@ -38,16 +48,36 @@ namespace Helios {
 		virtual void Render() = 0;
 		virtual void OnWindowResize(uint32_t width, uint32_t height) = 0;
 		virtual void OnFramebufferResize(uint32_t width, uint32_t height) = 0;
+		virtual void OnPresentModeChanged() = 0;
+
+		// GPU time of the last finished frame in ms (0 if not measured)
+		virtual float GetGPUFrameTime() = 0;
+		// State changes of the draws in the last recorded frame
+		virtual RenderQueueStats GetRenderQueueStats() = 0;
+
+		// Writes the next rendered frame to a file (.ppm or .raw)
+		virtual void CaptureFrame(const std::string& path) = 0;
+		// Writes every Nth frame to "<prefix>_<frame>.<format>" (format: "ppm" or "raw")
+		virtual void StartCaptureStream(const std::string& prefix, uint32_t interval, const std::string& format = "ppm") = 0;
+		virtual void StopCaptureStream() = 0;
 
 		static API GetAPI() { return s_API; }
 		static void SetAPI(API api) { s_API = api; }
 
 		static const char* GetAPIString(API api = GetAPI());
 
+		static PresentMode GetPresentMode() { return s_PresentMode; }
+		static void SetPresentMode(PresentMode mode) { s_PresentMode = mode; }
+		static bool IsVSync(PresentMode mode = GetPresentMode()) { return mode == PresentMode::Fifo or mode == PresentMode::FifoRelaxed; }
+
+		static const char* GetPresentModeString(PresentMode mode = GetPresentMode());
+		static std::optional<PresentMode> GetPresentModeFromString(const std::string& mode);
+
 		static Ref<RendererAPI> Create();
 
 	private:
 		static API s_API;
+		static PresentMode s_PresentMode;
 	};
 
 
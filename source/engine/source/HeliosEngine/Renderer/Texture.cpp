@@ -0,0 +1,74 @@
+#include "pch.h"
+#include "Texture.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+
+// related on build options and platform
+#ifdef BUILDWITH_RENDERER_DIRECTX
+#	include "Platform/Renderer/DirectX/DXTexture.h"
+#endif
+#ifdef BUILDWITH_RENDERER_METAL
+#	include "Platform/Renderer/Metal/MTTexture.h"
+#endif
+#ifdef BUILDWITH_RENDERER_VULKAN
+#	include "Platform/Renderer/Vulkan/VKTexture.h"
+#endif
+#ifdef BUILDWITH_RENDERER_OPENGL
+#	include "Platform/Renderer/OpenGL/GLTexture.h"
+#endif
+
+
+namespace Helios {
+
+
+	Ref<Texture2D> Texture2D::Create(const TextureSpecification& specification)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None: LOG_CORE_EXCEPT("RendererAPI::None is not supported!"); return nullptr;
+
+		// related on build options and platform
+#		ifdef BUILDWITH_RENDERER_DIRECTX
+			case RendererAPI::API::DirectX: return CreateRef<DXTexture2D>(specification);
+#		endif
+#		ifdef BUILDWITH_RENDERER_METAL
+			case RendererAPI::API::Metal: return CreateRef<MTTexture2D>(specification);
+#		endif
+#		ifdef BUILDWITH_RENDERER_VULKAN
+			case RendererAPI::API::Vulkan: return CreateRef<VKTexture2D>(specification);
+#		endif
+#		ifdef BUILDWITH_RENDERER_OPENGL
+			case RendererAPI::API::OpenGL: return CreateRef<GLTexture2D>(specification);
+#		endif
+
+		default: LOG_CORE_EXCEPT("Unknown or not implemented RendererAPI!"); return nullptr;
+		}
+	}
+
+
+	Ref<Texture2D> Texture2D::Create(const std::string& filename, const std::string& arcname)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None: LOG_CORE_EXCEPT("RendererAPI::None is not supported!"); return nullptr;
+
+		// related on build options and platform
+#		ifdef BUILDWITH_RENDERER_DIRECTX
+			case RendererAPI::API::DirectX: return CreateRef<DXTexture2D>(filename, arcname);
+#		endif
+#		ifdef BUILDWITH_RENDERER_METAL
+			case RendererAPI::API::Metal: return CreateRef<MTTexture2D>(filename, arcname);
+#		endif
+#		ifdef BUILDWITH_RENDERER_VULKAN
+			case RendererAPI::API::Vulkan: return CreateRef<VKTexture2D>(filename, arcname);
+#		endif
+#		ifdef BUILDWITH_RENDERER_OPENGL
+			case RendererAPI::API::OpenGL: return CreateRef<GLTexture2D>(filename, arcname);
+#		endif
+
+		default: LOG_CORE_EXCEPT("Unknown or not implemented RendererAPI!"); return nullptr;
+		}
+	}
+
+
+} // namespace Helios
@@ -0,0 +1,69 @@
+#pragma once
+
+
+namespace Helios {
+
+
+	enum class ImageFormat
+	{
+		None = 0,
+
+		RGBA8,
+		RGBA8_SRGB,
+
+		// Block compressed (4x4 blocks)
+		BC1,
+		BC1_SRGB,
+		BC3,
+		BC3_SRGB,
+		BC4,
+		BC5,
+		BC7,
+		BC7_SRGB,
+		ASTC_4x4,
+		ASTC_4x4_SRGB
+	};
+
+
+	struct TextureSpecification
+	{
+		uint32_t Width = 1;
+		uint32_t Height = 1;
+		ImageFormat Format = ImageFormat::RGBA8_SRGB;
+		// Generate the mip chain on the GPU (if the data has no mips)
+		bool GenerateMips = true;
+	};
+
+
+	class Texture
+	{
+	public:
+		virtual ~Texture() = default;
+
+		virtual const TextureSpecification& GetSpecification() const = 0;
+
+		virtual uint32_t GetWidth() const = 0;
+		virtual uint32_t GetHeight() const = 0;
+		virtual uint32_t GetMipLevels() const = 0;
+
+		// Most detailed mip level which can be sampled (UINT32_MAX if none yet)
+		virtual uint32_t GetResidentMip() const = 0;
+		// All mip levels are uploaded
+		virtual bool IsLoaded() const = 0;
+
+		virtual const std::string& GetPath() const = 0;
+
+		// Data of the base level, tightly packed (in blocks for compressed formats)
+		virtual void SetData(const void* data, uint32_t size) = 0;
+	};
+
+
+	class Texture2D : public Texture
+	{
+	public:
+		static Ref<Texture2D> Create(const TextureSpecification& specification);
+		static Ref<Texture2D> Create(const std::string& filename, const std::string& arcname = "");
+	};
+
+
+} // namespace Helios
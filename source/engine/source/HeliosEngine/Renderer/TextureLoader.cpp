@@ -0,0 +1,369 @@
+#include "pch.h"
+#include "TextureLoader.h"
+
+#include "HeliosEngine/Core/Assets.h"
+
+
+namespace Helios {
+
+
+	bool TextureLoader::Load(const std::string& filename, const std::string& arcname, TextureData& data)
+	{
+		std::string ext = std::filesystem::path(filename).extension().string();
+		std::transform(ext.begin(), ext.end(), ext.begin(),
+			[](unsigned char c) { return std::tolower(c); });
+
+		std::vector<char> file = Assets::Load(filename, arcname);
+
+		bool result = false;
+		if (ext == ".ppm")
+			result = LoadPPM(file, data);
+		else if (ext == ".ktx2")
+			result = LoadKTX2(file, data);
+		else if (ext == ".dds")
+			result = LoadDDS(file, data);
+		else
+			LOG_CORE_ERROR("Unsupported texture file type: \"{}\"", filename);
+
+		if (!result)
+			LOG_CORE_ERROR("Failed to load texture: \"{}\"", filename);
+		return result;
+	}
+
+
+	uint32_t TextureLoader::GetPixelSize(ImageFormat format)
+	{
+		switch (format)
+		{
+		case ImageFormat::RGBA8:      return 4;
+		case ImageFormat::RGBA8_SRGB: return 4;
+		default:                      return 0;
+		}
+	}
+
+
+	void TextureLoader::GetBlockSize(ImageFormat format, uint32_t& width, uint32_t& height, uint32_t& bytes)
+	{
+		switch (format)
+		{
+		case ImageFormat::BC1:
+		case ImageFormat::BC1_SRGB:
+		case ImageFormat::BC4:
+			width = 4; height = 4; bytes = 8;
+			return;
+		case ImageFormat::BC3:
+		case ImageFormat::BC3_SRGB:
+		case ImageFormat::BC5:
+		case ImageFormat::BC7:
+		case ImageFormat::BC7_SRGB:
+		case ImageFormat::ASTC_4x4:
+		case ImageFormat::ASTC_4x4_SRGB:
+			width = 4; height = 4; bytes = 16;
+			return;
+		default:
+			width = 1; height = 1; bytes = GetPixelSize(format);
+			return;
+		}
+	}
+
+
+	size_t TextureLoader::GetLevelSize(ImageFormat format, uint32_t width, uint32_t height)
+	{
+		uint32_t blockWidth, blockHeight, blockBytes;
+		GetBlockSize(format, blockWidth, blockHeight, blockBytes);
+
+		size_t blocksX = (std::max(width, 1u) + blockWidth - 1) / blockWidth;
+		size_t blocksY = (std::max(height, 1u) + blockHeight - 1) / blockHeight;
+		return blocksX * blocksY * blockBytes;
+	}
+
+
+	uint32_t TextureLoader::GetMaxLevelCount(uint32_t width, uint32_t height)
+	{
+		uint32_t count = 1;
+		for (uint32_t size = std::max(width, height); size > 1; size >>= 1)
+			count++;
+		return count;
+	}
+
+
+	bool TextureLoader::IsCompressed(ImageFormat format)
+	{
+		return format != ImageFormat::None and GetPixelSize(format) == 0;
+	}
+
+
+	bool TextureLoader::LoadPPM(const std::vector<char>& file, TextureData& data)
+	{
+		// Header: "P6" <width> <height> <maxval> (whitespace separated, '#' comments)
+		size_t pos = 0;
+		auto next = [&]() -> std::string
+		{
+			while (pos < file.size())
+			{
+				if (file[pos] == '#')
+					while (pos < file.size() and file[pos] != '\n') pos++;
+				else if (std::isspace(static_cast<unsigned char>(file[pos])))
+					pos++;
+				else
+					break;
+			}
+			size_t start = pos;
+			while (pos < file.size() and !std::isspace(static_cast<unsigned char>(file[pos])))
+				pos++;
+			return std::string(file.data() + start, pos - start);
+		};
+
+		if (next() != "P6")
+			return false;
+		uint32_t width = static_cast<uint32_t>(std::strtoul(next().c_str(), nullptr, 10));
+		uint32_t height = static_cast<uint32_t>(std::strtoul(next().c_str(), nullptr, 10));
+		uint32_t maxval = static_cast<uint32_t>(std::strtoul(next().c_str(), nullptr, 10));
+		// Exactly one whitespace before the data
+		pos++;
+
+		size_t pixelCount = static_cast<size_t>(width) * height;
+		if (width == 0 or height == 0 or maxval != 255 or pos > file.size() or pixelCount > (file.size() - pos) / 3)
+			return false;
+
+		data.Specification.Width = width;
+		data.Specification.Height = height;
+		data.Specification.Format = ImageFormat::RGBA8_SRGB;
+		data.Levels.resize(1);
+		data.Levels[0].resize(pixelCount * 4);
+		const uint8_t* src = reinterpret_cast<const uint8_t*>(file.data() + pos);
+		for (size_t i = 0; i < pixelCount; i++)
+		{
+			data.Levels[0][i * 4 + 0] = src[i * 3 + 0];
+			data.Levels[0][i * 4 + 1] = src[i * 3 + 1];
+			data.Levels[0][i * 4 + 2] = src[i * 3 + 2];
+			data.Levels[0][i * 4 + 3] = 255;
+		}
+
+		return true;
+	}
+
+
+	namespace {
+
+		template<typename T>
+		T ReadValue(const std::vector<char>& file, size_t offset)
+		{
+			T value{};
+			if (offset + sizeof(T) <= file.size())
+				std::memcpy(&value, file.data() + offset, sizeof(T));
+			return value;
+		}
+
+		constexpr uint32_t FourCC(char a, char b, char c, char d)
+		{
+			return uint32_t(uint8_t(a)) | (uint32_t(uint8_t(b)) << 8) | (uint32_t(uint8_t(c)) << 16) | (uint32_t(uint8_t(d)) << 24);
+		}
+
+		// Values of VkFormat (the loader does not depend on the vulkan headers)
+		ImageFormat FromVkFormat(uint32_t format)
+		{
+			switch (format)
+			{
+			case 37:  return ImageFormat::RGBA8;
+			case 43:  return ImageFormat::RGBA8_SRGB;
+			case 133: return ImageFormat::BC1;
+			case 134: return ImageFormat::BC1_SRGB;
+			case 137: return ImageFormat::BC3;
+			case 138: return ImageFormat::BC3_SRGB;
+			case 139: return ImageFormat::BC4;
+			case 141: return ImageFormat::BC5;
+			case 145: return ImageFormat::BC7;
+			case 146: return ImageFormat::BC7_SRGB;
+			case 157: return ImageFormat::ASTC_4x4;
+			case 158: return ImageFormat::ASTC_4x4_SRGB;
+			default:  return ImageFormat::None;
+			}
+		}
+
+		// Values of DXGI_FORMAT
+		ImageFormat FromDXGIFormat(uint32_t format)
+		{
+			switch (format)
+			{
+			case 28: return ImageFormat::RGBA8;
+			case 29: return ImageFormat::RGBA8_SRGB;
+			case 71: return ImageFormat::BC1;
+			case 72: return ImageFormat::BC1_SRGB;
+			case 77: return ImageFormat::BC3;
+			case 78: return ImageFormat::BC3_SRGB;
+			case 80: return ImageFormat::BC4;
+			case 83: return ImageFormat::BC5;
+			case 98: return ImageFormat::BC7;
+			case 99: return ImageFormat::BC7_SRGB;
+			default: return ImageFormat::None;
+			}
+		}
+
+	}
+
+
+	bool TextureLoader::LoadKTX2(const std::vector<char>& file, TextureData& data)
+	{
+		static const uint8_t identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+		// Header (80 bytes) followed by the level index
+		if (file.size() < 80 or std::memcmp(file.data(), identifier, sizeof(identifier)) != 0)
+			return false;
+
+		uint32_t vkFormat = ReadValue<uint32_t>(file, 12);
+		uint32_t width = ReadValue<uint32_t>(file, 20);
+		uint32_t height = ReadValue<uint32_t>(file, 24);
+		uint32_t depth = ReadValue<uint32_t>(file, 28);
+		uint32_t layerCount = ReadValue<uint32_t>(file, 32);
+		uint32_t faceCount = ReadValue<uint32_t>(file, 36);
+		uint32_t levelCount = std::max(ReadValue<uint32_t>(file, 40), 1u);
+		uint32_t supercompression = ReadValue<uint32_t>(file, 44);
+
+		ImageFormat format = FromVkFormat(vkFormat);
+		if (format == ImageFormat::None)
+		{
+			LOG_CORE_ERROR("Unsupported KTX2 format: {}", vkFormat);
+			return false;
+		}
+		if (supercompression != 0)
+		{
+			LOG_CORE_ERROR("KTX2 supercompression is not supported (scheme {})!", supercompression);
+			return false;
+		}
+		if (width == 0 or height == 0 or depth > 1 or layerCount > 1 or faceCount != 1)
+		{
+			LOG_CORE_ERROR("Only 2D KTX2 textures are supported!");
+			return false;
+		}
+		// Validated before anything is allocated for the levels
+		if (levelCount > GetMaxLevelCount(width, height) or 80 + static_cast<size_t>(levelCount) * 24 > file.size())
+		{
+			LOG_CORE_ERROR("Invalid KTX2 level count: {}", levelCount);
+			return false;
+		}
+
+		data.Specification.Width = width;
+		data.Specification.Height = height;
+		data.Specification.Format = format;
+		data.Levels.resize(levelCount);
+
+		// Level index: byteOffset, byteLength, uncompressedByteLength (level 0 first)
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			size_t entry = 80 + static_cast<size_t>(level) * 24;
+			uint64_t offset = ReadValue<uint64_t>(file, entry);
+			uint64_t length = ReadValue<uint64_t>(file, entry + 8);
+
+			size_t expected = GetLevelSize(format, std::max(1u, width >> level), std::max(1u, height >> level));
+			// Offsets come from the file, so they must not wrap around
+			if (length < expected or offset > file.size() or expected > file.size() - offset)
+				return false;
+
+			data.Levels[level].assign(file.data() + offset, file.data() + offset + expected);
+		}
+
+		return true;
+	}
+
+
+	bool TextureLoader::LoadDDS(const std::vector<char>& file, TextureData& data)
+	{
+		// Magic (4 bytes) followed by DDS_HEADER (124 bytes)
+		if (file.size() < 128 or ReadValue<uint32_t>(file, 0) != FourCC('D', 'D', 'S', ' '))
+			return false;
+
+		uint32_t height = ReadValue<uint32_t>(file, 12);
+		uint32_t width = ReadValue<uint32_t>(file, 16);
+		uint32_t mipCount = std::max(ReadValue<uint32_t>(file, 28), 1u);
+		uint32_t pfFlags = ReadValue<uint32_t>(file, 80);
+		uint32_t fourCC = ReadValue<uint32_t>(file, 84);
+		uint32_t caps2 = ReadValue<uint32_t>(file, 112);
+
+		constexpr uint32_t DDPF_FOURCC = 0x4;
+		constexpr uint32_t DDPF_RGB = 0x40;
+		constexpr uint32_t DDSCAPS2_CUBEMAP = 0x200;
+		constexpr uint32_t DDSCAPS2_VOLUME = 0x200000;
+
+		ImageFormat format = ImageFormat::None;
+		size_t offset = 128;
+		if (pfFlags & DDPF_FOURCC)
+		{
+			switch (fourCC)
+			{
+			case FourCC('D', 'X', 'T', '1'): format = ImageFormat::BC1; break;
+			case FourCC('D', 'X', 'T', '5'): format = ImageFormat::BC3; break;
+			case FourCC('A', 'T', 'I', '1'):
+			case FourCC('B', 'C', '4', 'U'): format = ImageFormat::BC4; break;
+			case FourCC('A', 'T', 'I', '2'):
+			case FourCC('B', 'C', '5', 'U'): format = ImageFormat::BC5; break;
+			case FourCC('D', 'X', '1', '0'):
+			{
+				// DDS_HEADER_DXT10 (20 bytes)
+				if (file.size() < 148)
+					return false;
+				format = FromDXGIFormat(ReadValue<uint32_t>(file, 128));
+				uint32_t dimension = ReadValue<uint32_t>(file, 132);
+				uint32_t arraySize = ReadValue<uint32_t>(file, 140);
+				// D3D10_RESOURCE_DIMENSION_TEXTURE2D
+				if (dimension != 3 or arraySize > 1)
+				{
+					LOG_CORE_ERROR("Only 2D DDS textures are supported!");
+					return false;
+				}
+				offset = 148;
+				break;
+			}
+			}
+		}
+		else if ((pfFlags & DDPF_RGB) and ReadValue<uint32_t>(file, 88) == 32
+			and ReadValue<uint32_t>(file, 92) == 0x000000FF
+			and ReadValue<uint32_t>(file, 96) == 0x0000FF00
+			and ReadValue<uint32_t>(file, 100) == 0x00FF0000)
+		{
+			format = ImageFormat::RGBA8;
+		}
+
+		if (format == ImageFormat::None)
+		{
+			LOG_CORE_ERROR("Unsupported DDS pixel format!");
+			return false;
+		}
+		if (width == 0 or height == 0 or (caps2 & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME)))
+		{
+			LOG_CORE_ERROR("Only 2D DDS textures are supported!");
+			return false;
+		}
+		if (mipCount > GetMaxLevelCount(width, height))
+		{
+			LOG_CORE_ERROR("Invalid DDS mip count: {}", mipCount);
+			return false;
+		}
+
+		data.Specification.Width = width;
+		data.Specification.Height = height;
+		data.Specification.Format = format;
+		return ReadLevels(file, offset, mipCount, data);
+	}
+
+
+	bool TextureLoader::ReadLevels(const std::vector<char>& file, size_t offset, uint32_t levelCount, TextureData& data)
+	{
+		const TextureSpecification& spec = data.Specification;
+
+		data.Levels.resize(levelCount);
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			size_t size = GetLevelSize(spec.Format, std::max(1u, spec.Width >> level), std::max(1u, spec.Height >> level));
+			if (offset > file.size() or size > file.size() - offset)
+				return false;
+
+			data.Levels[level].assign(file.data() + offset, file.data() + offset + size);
+			offset += size;
+		}
+
+		return true;
+	}
+
+
+} // namespace Helios
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "HeliosEngine/Renderer/Texture.h"
+
+
+namespace Helios {
+
+
+	// Decoded image data, independent of the renderer API
+	struct TextureData
+	{
+		TextureSpecification Specification;
+		// Tightly packed data per mip level (level 0 first)
+		std::vector<std::vector<uint8_t>> Levels;
+	};
+
+
+	class TextureLoader
+	{
+	public:
+		// Supported: .ppm (binary, P6), .ktx2 and .dds (uncompressed RGBA8,
+		// BC1/3/4/5/7 and ASTC 4x4 without supercompression)
+		static bool Load(const std::string& filename, const std::string& arcname, TextureData& data);
+
+		// Bytes of a single pixel (0 for compressed formats)
+		static uint32_t GetPixelSize(ImageFormat format);
+		// Size of a block in pixels and bytes (1x1 for uncompressed formats)
+		static void GetBlockSize(ImageFormat format, uint32_t& width, uint32_t& height, uint32_t& bytes);
+		// Bytes of a tightly packed level
+		static size_t GetLevelSize(ImageFormat format, uint32_t width, uint32_t height);
+		// Levels of a full mip chain (down to 1x1)
+		static uint32_t GetMaxLevelCount(uint32_t width, uint32_t height);
+		static bool IsCompressed(ImageFormat format);
+
+	private:
+		static bool LoadPPM(const std::vector<char>& file, TextureData& data);
+		static bool LoadKTX2(const std::vector<char>& file, TextureData& data);
+		static bool LoadDDS(const std::vector<char>& file, TextureData& data);
+		// Copies the levels (largest first) which are stored one after another
+		static bool ReadLevels(const std::vector<char>& file, size_t offset, uint32_t levelCount, TextureData& data);
+	};
+
+
+} // namespace Helios
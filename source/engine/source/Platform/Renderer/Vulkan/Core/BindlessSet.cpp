@@ -0,0 +1,239 @@
+#include "pch.h"
+#include "BindlessSet.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+
+
+namespace Helios::Vulkan {
+
+
+	BindlessSet::BindlessSet()
+	{
+		Create();
+	}
+
+
+	BindlessSet::~BindlessSet()
+	{
+		Destroy();
+	}
+
+
+	void BindlessSet::Create()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Creating bindless descriptor objects...");
+
+		// Size the arrays within the limits of the device
+		auto chain = device->GetPhysicalDevice().getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceDescriptorIndexingPropertiesEXT>();
+		auto& limits = chain.get<vk::PhysicalDeviceDescriptorIndexingPropertiesEXT>();
+		m_textures.capacity = std::min({ MAX_TEXTURES,
+			limits.maxDescriptorSetUpdateAfterBindSampledImages,
+			limits.maxPerStageDescriptorUpdateAfterBindSampledImages });
+		m_buffers.capacity = std::min({ MAX_BUFFERS,
+			limits.maxDescriptorSetUpdateAfterBindStorageBuffers,
+			limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers });
+		LOG_RENDER_DEBUG("Bindless capacity: {} textures, {} buffers", m_textures.capacity, m_buffers.capacity);
+
+		// Layout
+		std::array<vk::DescriptorSetLayoutBinding, 2> bindings;
+		bindings[0] = vk::DescriptorSetLayoutBinding();
+		{
+			bindings[0].binding = TEXTURE_BINDING;
+			bindings[0].descriptorType = vk::DescriptorType::eCombinedImageSampler;
+			bindings[0].descriptorCount = m_textures.capacity;
+			bindings[0].stageFlags = vk::ShaderStageFlagBits::eAll;
+		}
+		bindings[1] = vk::DescriptorSetLayoutBinding();
+		{
+			bindings[1].binding = BUFFER_BINDING;
+			bindings[1].descriptorType = vk::DescriptorType::eStorageBuffer;
+			bindings[1].descriptorCount = m_buffers.capacity;
+			bindings[1].stageFlags = vk::ShaderStageFlagBits::eAll;
+		}
+		// Not all slots are written and unused ones can be written while frames are in flight
+		vk::DescriptorBindingFlagsEXT flags =
+			vk::DescriptorBindingFlagBitsEXT::ePartiallyBound |
+			vk::DescriptorBindingFlagBitsEXT::eUpdateAfterBind |
+			vk::DescriptorBindingFlagBitsEXT::eUpdateUnusedWhilePending;
+		std::array<vk::DescriptorBindingFlagsEXT, 2> bindingFlags = { flags, flags };
+		vk::DescriptorSetLayoutBindingFlagsCreateInfoEXT flagsInfo = vk::DescriptorSetLayoutBindingFlagsCreateInfoEXT();
+		{
+			flagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+			flagsInfo.pBindingFlags = bindingFlags.data();
+		}
+		vk::DescriptorSetLayoutCreateInfo layoutInfo = vk::DescriptorSetLayoutCreateInfo();
+		{
+			layoutInfo.pNext = &flagsInfo;
+			layoutInfo.flags = vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPoolEXT;
+			layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+			layoutInfo.pBindings = bindings.data();
+		}
+		try {
+			LOG_RENDER_TRACE("Creating bindless descriptor set layout...");
+			m_vkLayout = device->GetLogicalDevice().createDescriptorSetLayout(layoutInfo);
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to create bindless descriptor set layout!");
+		}
+
+		// Pool
+		std::array<vk::DescriptorPoolSize, 2> sizes = {
+			vk::DescriptorPoolSize(vk::DescriptorType::eCombinedImageSampler, m_textures.capacity),
+			vk::DescriptorPoolSize(vk::DescriptorType::eStorageBuffer, m_buffers.capacity),
+		};
+		vk::DescriptorPoolCreateInfo poolInfo = vk::DescriptorPoolCreateInfo();
+		{
+			poolInfo.flags = vk::DescriptorPoolCreateFlagBits::eUpdateAfterBindEXT;
+			poolInfo.maxSets = 1;
+			poolInfo.poolSizeCount = static_cast<uint32_t>(sizes.size());
+			poolInfo.pPoolSizes = sizes.data();
+		}
+		try {
+			LOG_RENDER_TRACE("Creating bindless descriptor pool...");
+			m_vkPool = device->GetLogicalDevice().createDescriptorPool(poolInfo);
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to create bindless descriptor pool!");
+		}
+
+		// Set
+		vk::DescriptorSetAllocateInfo allocInfo = vk::DescriptorSetAllocateInfo();
+		{
+			allocInfo.descriptorPool = m_vkPool;
+			allocInfo.descriptorSetCount = 1;
+			allocInfo.pSetLayouts = &m_vkLayout;
+		}
+		try {
+			m_vkSet = device->GetLogicalDevice().allocateDescriptorSets(allocInfo)[0];
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to allocate bindless descriptor set!");
+		}
+	}
+
+
+	void BindlessSet::Destroy()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Destroying bindless descriptor objects...");
+
+		// The set is freed with the pool
+		if (m_vkPool)
+			device->GetLogicalDevice().destroyDescriptorPool(m_vkPool);
+		if (m_vkLayout)
+			device->GetLogicalDevice().destroyDescriptorSetLayout(m_vkLayout);
+	}
+
+
+	uint32_t BindlessSet::AddTexture(vk::ImageView view, vk::Sampler sampler, vk::ImageLayout layout)
+	{
+		uint32_t index = AcquireSlot(m_textures);
+		if (index == INVALID_INDEX)
+		{
+			LOG_RENDER_ERROR("Bindless texture capacity ({}) exceeded!", m_textures.capacity);
+			return INVALID_INDEX;
+		}
+
+		UpdateTexture(index, view, sampler, layout);
+		return index;
+	}
+
+
+	uint32_t BindlessSet::AddBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::DeviceSize range)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		uint32_t index = AcquireSlot(m_buffers);
+		if (index == INVALID_INDEX)
+		{
+			LOG_RENDER_ERROR("Bindless buffer capacity ({}) exceeded!", m_buffers.capacity);
+			return INVALID_INDEX;
+		}
+
+		vk::DescriptorBufferInfo bufferInfo(buffer, offset, range);
+		vk::WriteDescriptorSet write = vk::WriteDescriptorSet();
+		{
+			write.dstSet = m_vkSet;
+			write.dstBinding = BUFFER_BINDING;
+			write.dstArrayElement = index;
+			write.descriptorCount = 1;
+			write.descriptorType = vk::DescriptorType::eStorageBuffer;
+			write.pBufferInfo = &bufferInfo;
+		}
+		device->GetLogicalDevice().updateDescriptorSets(write, nullptr);
+
+		return index;
+	}
+
+
+	void BindlessSet::UpdateTexture(uint32_t index, vk::ImageView view, vk::Sampler sampler, vk::ImageLayout layout)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		vk::DescriptorImageInfo imageInfo(sampler, view, layout);
+		vk::WriteDescriptorSet write = vk::WriteDescriptorSet();
+		{
+			write.dstSet = m_vkSet;
+			write.dstBinding = TEXTURE_BINDING;
+			write.dstArrayElement = index;
+			write.descriptorCount = 1;
+			write.descriptorType = vk::DescriptorType::eCombinedImageSampler;
+			write.pImageInfo = &imageInfo;
+		}
+		device->GetLogicalDevice().updateDescriptorSets(write, nullptr);
+	}
+
+
+	void BindlessSet::RemoveTexture(uint32_t index, uint64_t lastFrame)
+	{
+		if (index != INVALID_INDEX)
+			m_textures.retired.push_back({ lastFrame, index });
+	}
+
+
+	void BindlessSet::RemoveBuffer(uint32_t index, uint64_t lastFrame)
+	{
+		if (index != INVALID_INDEX)
+			m_buffers.retired.push_back({ lastFrame, index });
+	}
+
+
+	void BindlessSet::BeginFrame(uint64_t completedFrame)
+	{
+		for (Slots* slots : { &m_textures, &m_buffers })
+		{
+			std::erase_if(slots->retired, [&](const auto& entry) {
+				if (entry.first > completedFrame)
+					return false;
+				slots->free.push_back(entry.second);
+				return true;
+			});
+		}
+	}
+
+
+	void BindlessSet::Bind(vk::CommandBuffer commandBuffer, vk::PipelineLayout layout, uint32_t set, vk::PipelineBindPoint bindPoint)
+	{
+		commandBuffer.bindDescriptorSets(bindPoint, layout, set, m_vkSet, nullptr);
+	}
+
+
+	uint32_t BindlessSet::AcquireSlot(Slots& slots)
+	{
+		if (!slots.free.empty())
+		{
+			uint32_t index = slots.free.back();
+			slots.free.pop_back();
+			return index;
+		}
+		if (slots.next < slots.capacity)
+			return slots.next++;
+		return INVALID_INDEX;
+	}
+
+
+} // namespace Helios::Vulkan
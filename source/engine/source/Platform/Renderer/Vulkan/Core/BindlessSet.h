@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+namespace Helios::Vulkan {
+
+
+	// One global descriptor set with all textures and storage buffers
+	// (requires descriptor indexing, see DeviceFeatures::descriptorIndexing).
+	// Shaders select the resources with indices from push constants or
+	// instance data instead of binding a set per material:
+	//
+	//   layout (set = 1, binding = 0) uniform sampler2D textures[];
+	//   layout (set = 1, binding = 1) buffer Buffers { uint data[]; } buffers[];
+	//   texture(textures[nonuniformEXT(index)], uv);
+	//
+	// The main pass samples the textures of its objects this way (set 1 of the
+	// uniform pipeline layout). Without descriptor indexing the objects are
+	// drawn without textures.
+	class BindlessSet
+	{
+	public:
+		BindlessSet();
+		~BindlessSet();
+
+		void Create();
+		void Destroy();
+
+	public:
+		static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+		static constexpr uint32_t TEXTURE_BINDING = 0;
+		static constexpr uint32_t BUFFER_BINDING = 1;
+
+		uint32_t AddTexture(vk::ImageView view, vk::Sampler sampler, vk::ImageLayout layout = vk::ImageLayout::eShaderReadOnlyOptimal);
+		uint32_t AddBuffer(vk::Buffer buffer, vk::DeviceSize offset = 0, vk::DeviceSize range = VK_WHOLE_SIZE);
+		// Replaces the descriptor (e.g. after more mip levels are streamed in)
+		void UpdateTexture(uint32_t index, vk::ImageView view, vk::Sampler sampler, vk::ImageLayout layout = vk::ImageLayout::eShaderReadOnlyOptimal);
+		// The index is reused after the frame is finished
+		void RemoveTexture(uint32_t index, uint64_t lastFrame);
+		void RemoveBuffer(uint32_t index, uint64_t lastFrame);
+
+		// Recycles the indices of resources which are no longer used
+		void BeginFrame(uint64_t completedFrame);
+		void Bind(vk::CommandBuffer commandBuffer, vk::PipelineLayout layout, uint32_t set, vk::PipelineBindPoint bindPoint = vk::PipelineBindPoint::eGraphics);
+
+		uint32_t GetTextureCapacity() const { return m_textures.capacity; }
+		uint32_t GetBufferCapacity() const { return m_buffers.capacity; }
+
+	// Getter for vulkan objects
+	public:
+		vk::DescriptorSetLayout& GetLayout() { return m_vkLayout; }
+		vk::DescriptorSet& GetSet() { return m_vkSet; }
+
+	// Vulkan objects
+	private:
+		vk::DescriptorPool m_vkPool;
+		vk::DescriptorSetLayout m_vkLayout;
+		vk::DescriptorSet m_vkSet;
+
+	// Internal helper
+	private:
+		struct Slots;
+		static uint32_t AcquireSlot(Slots& slots);
+
+	// Internal data
+	private:
+		static constexpr uint32_t MAX_TEXTURES = 16384;
+		static constexpr uint32_t MAX_BUFFERS = 4096;
+
+		struct Slots
+		{
+			uint32_t capacity = 0;
+			uint32_t next = 0;
+			std::vector<uint32_t> free;
+			// Removed indices paired with the last frame which could use them
+			std::vector<std::pair<uint64_t, uint32_t>> retired;
+		};
+
+		Slots m_textures;
+		Slots m_buffers;
+	};
+
+
+} // namespace Helios::Vulkan
@@ -0,0 +1,339 @@
+#include "pch.h"
+#include "ClusterCulling.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+#include "Platform/Renderer/Vulkan/VKModel.h"
+#include "Platform/Renderer/Vulkan/Core/GPUCulling.h"
+
+#include "HeliosEngine/Core/Assets.h"
+
+
+namespace Helios::Vulkan {
+
+
+	namespace {
+
+		// Same layout in cluster.comp, meshlet.task and meshlet.mesh
+		struct ClusterInstance
+		{
+			glm::mat4 transform;
+			glm::mat4 viewProjection;
+		};
+
+		struct ClusterPushConstants
+		{
+			glm::vec4 planes[6];
+			glm::vec4 cameraPosition;
+			uint32_t meshletCount;
+			uint32_t instance;
+			uint32_t firstDraw;
+			uint32_t padding;
+		};
+
+	}
+
+
+	ClusterCulling::ClusterCulling(uint32_t framesInFlight)
+	{
+		Create(framesInFlight);
+	}
+
+
+	ClusterCulling::~ClusterCulling()
+	{
+		Destroy();
+	}
+
+
+	void ClusterCulling::Create(uint32_t framesInFlight)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Creating cluster culling objects...");
+
+		m_meshShader = device->GetFeatures().meshShader and
+			Assets::Exist("Shader/meshlet.task.spv", "RendererVulkan") and
+			Assets::Exist("Shader/meshlet.mesh.spv", "RendererVulkan") and
+			Assets::Exist("Shader/meshlet.frag.spv", "RendererVulkan");
+		if (device->GetFeatures().meshShader and !m_meshShader)
+			LOG_RENDER_WARN("Mesh shaders not found, using indirect draws for the meshlets!");
+		LOG_RENDER_DEBUG("Cluster culling: {}", m_meshShader ? "mesh shaders" : "indirect draws");
+
+		// Meshlets, instances, draw commands
+		m_cullSetLayout = CreateScope<DescriptorSetLayout>(std::vector<vk::DescriptorSetLayoutBinding>{
+			DescriptorSetLayout::Binding(0, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute),
+			DescriptorSetLayout::Binding(1, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute),
+			DescriptorSetLayout::Binding(2, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute),
+		});
+
+		vk::PushConstantRange pushConstantRange = vk::PushConstantRange();
+		{
+			pushConstantRange.stageFlags = vk::ShaderStageFlagBits::eCompute;
+			pushConstantRange.offset = 0;
+			pushConstantRange.size = sizeof(ClusterPushConstants);
+		}
+		vk::PipelineLayoutCreateInfo layoutInfo = vk::PipelineLayoutCreateInfo();
+		{
+			layoutInfo.setLayoutCount = 1;
+			layoutInfo.pSetLayouts = &m_cullSetLayout->GetLayout();
+			layoutInfo.pushConstantRangeCount = 1;
+			layoutInfo.pPushConstantRanges = &pushConstantRange;
+		}
+		try {
+			LOG_RENDER_TRACE("Creating cluster culling pipeline layout...");
+			m_vkCullPipelineLayout = device->GetLogicalDevice().createPipelineLayout(layoutInfo);
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to create pipeline layout!");
+		}
+		m_cullPipeline = CreateScope<ComputePipeline>("Shader/cluster.comp.spv", m_vkCullPipelineLayout);
+
+		if (m_meshShader)
+		{
+			// Meshlets, instances, meshlet vertices, meshlet triangles, vertices
+			vk::ShaderStageFlags stages = vk::ShaderStageFlagBits::eTaskEXT | vk::ShaderStageFlagBits::eMeshEXT;
+			m_meshSetLayout = CreateScope<DescriptorSetLayout>(std::vector<vk::DescriptorSetLayoutBinding>{
+				DescriptorSetLayout::Binding(0, vk::DescriptorType::eStorageBuffer, stages),
+				DescriptorSetLayout::Binding(1, vk::DescriptorType::eStorageBuffer, stages),
+				DescriptorSetLayout::Binding(2, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eMeshEXT),
+				DescriptorSetLayout::Binding(3, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eMeshEXT),
+				DescriptorSetLayout::Binding(4, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eMeshEXT),
+			});
+
+			pushConstantRange.stageFlags = stages;
+			layoutInfo.pSetLayouts = &m_meshSetLayout->GetLayout();
+			try {
+				LOG_RENDER_TRACE("Creating mesh shading pipeline layout...");
+				m_vkMeshPipelineLayout = device->GetLogicalDevice().createPipelineLayout(layoutInfo);
+			}
+			catch (vk::SystemError err) {
+				LOG_RENDER_EXCEPT("Failed to create pipeline layout!");
+			}
+		}
+
+		device->CreateBuffer(
+			sizeof(ClusterInstance) * MAX_INSTANCES * framesInFlight,
+			vk::BufferUsageFlagBits::eStorageBuffer,
+			vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+			m_vkInstanceBuffer, m_vkInstanceMemory);
+		device->CreateBuffer(
+			sizeof(vk::DrawIndexedIndirectCommand) * MAX_DRAWS * framesInFlight,
+			vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer,
+			vk::MemoryPropertyFlagBits::eDeviceLocal,
+			m_vkDrawBuffer, m_vkDrawMemory);
+
+		// Stays mapped for the lifetime of the buffer
+		m_mapped = static_cast<uint8_t*>(device->GetLogicalDevice().mapMemory(m_vkInstanceMemory, 0, VK_WHOLE_SIZE));
+	}
+
+
+	void ClusterCulling::Destroy()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Destroying cluster culling objects...");
+
+		if (m_mapped)
+			device->GetLogicalDevice().unmapMemory(m_vkInstanceMemory);
+		m_mapped = nullptr;
+
+		if (m_vkDrawBuffer)
+			device->GetLogicalDevice().destroyBuffer(m_vkDrawBuffer);
+		if (m_vkDrawMemory)
+			device->GetLogicalDevice().freeMemory(m_vkDrawMemory);
+		if (m_vkInstanceBuffer)
+			device->GetLogicalDevice().destroyBuffer(m_vkInstanceBuffer);
+		if (m_vkInstanceMemory)
+			device->GetLogicalDevice().freeMemory(m_vkInstanceMemory);
+
+		m_meshPipeline.reset();
+		m_cullPipeline.reset();
+		if (m_vkMeshPipelineLayout)
+			device->GetLogicalDevice().destroyPipelineLayout(m_vkMeshPipelineLayout);
+		if (m_vkCullPipelineLayout)
+			device->GetLogicalDevice().destroyPipelineLayout(m_vkCullPipelineLayout);
+		m_meshSetLayout.reset();
+		m_cullSetLayout.reset();
+	}
+
+
+	uint32_t ClusterCulling::Cull(FrameContext& frame, VKModel& model, const glm::mat4& transform,
+		const glm::mat4& viewProjection, const glm::vec3& cameraPosition)
+	{
+		Scope<DescriptorAllocator>& descriptors = static_cast<VKRendererAPI*>(Renderer::Get())->GetDescriptors();
+
+		uint32_t count = model.GetMeshletCount();
+		uint32_t instance = PushInstance(frame, transform, viewProjection);
+		if (count == 0 or instance == UINT32_MAX)
+			return UINT32_MAX;
+		if (m_drawCount + count > MAX_DRAWS)
+		{
+			LOG_RENDER_WARN("Too many meshlets for cluster culling, only {} are drawn!", MAX_DRAWS);
+			return UINT32_MAX;
+		}
+		uint32_t firstDraw = m_drawCount;
+		m_drawCount += count;
+
+		vk::DeviceSize drawRegion = sizeof(vk::DrawIndexedIndirectCommand) * MAX_DRAWS * frame.index;
+		vk::DescriptorSet set = descriptors->Allocate(frame, m_cullSetLayout->GetLayout());
+		WriteDescriptors(set, {
+			vk::DescriptorBufferInfo(model.GetMeshletBuffer(), 0, VK_WHOLE_SIZE),
+			vk::DescriptorBufferInfo(m_vkInstanceBuffer, sizeof(ClusterInstance) * MAX_INSTANCES * frame.index, sizeof(ClusterInstance) * MAX_INSTANCES),
+			vk::DescriptorBufferInfo(m_vkDrawBuffer, drawRegion, sizeof(vk::DrawIndexedIndirectCommand) * MAX_DRAWS),
+		});
+
+		ClusterPushConstants push{};
+		GPUCulling::ExtractFrustum(viewProjection, push.planes);
+		push.cameraPosition = glm::vec4(cameraPosition, 1.0f);
+		push.meshletCount = count;
+		push.instance = instance;
+		push.firstDraw = firstDraw;
+
+		m_cullPipeline->Bind(frame.commandBuffer);
+		frame.commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_vkCullPipelineLayout, 0, set, nullptr);
+		frame.commandBuffer.pushConstants(m_vkCullPipelineLayout, vk::ShaderStageFlagBits::eCompute, 0, sizeof(ClusterPushConstants), &push);
+		frame.commandBuffer.dispatch((count + GROUP_SIZE - 1) / GROUP_SIZE, 1, 1);
+
+		// Draw commands are read by the draws of the same command buffer
+		vk::BufferMemoryBarrier barrier = vk::BufferMemoryBarrier();
+		{
+			barrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
+			barrier.dstAccessMask = vk::AccessFlagBits::eIndirectCommandRead;
+			barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.buffer = m_vkDrawBuffer;
+			barrier.offset = drawRegion + sizeof(vk::DrawIndexedIndirectCommand) * firstDraw;
+			barrier.size = sizeof(vk::DrawIndexedIndirectCommand) * count;
+		}
+		frame.commandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eDrawIndirect,
+			{}, nullptr, barrier, nullptr);
+
+		return firstDraw;
+	}
+
+
+	void ClusterCulling::DrawIndirect(FrameContext& frame, vk::CommandBuffer commandBuffer, VKModel& model, uint32_t firstDraw)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		if (firstDraw == UINT32_MAX)
+			return;
+
+		uint32_t count = model.GetMeshletCount();
+		vk::DeviceSize offset = sizeof(vk::DrawIndexedIndirectCommand) * (MAX_DRAWS * frame.index + firstDraw);
+		uint32_t maxCount = device->GetFeatures().multiDrawIndirect ? device->GetCaps().properties.limits.maxDrawIndirectCount : 1;
+		for (uint32_t i = 0; i < count; i += maxCount)
+		{
+			uint32_t drawCount = std::min(maxCount, count - i);
+			commandBuffer.drawIndexedIndirect(m_vkDrawBuffer, offset + sizeof(vk::DrawIndexedIndirectCommand) * i,
+				drawCount, sizeof(vk::DrawIndexedIndirectCommand));
+		}
+	}
+
+
+	void ClusterCulling::CreateMeshPipeline(PipelineConfigInfo& configInfo)
+	{
+		if (!m_meshShader)
+			return;
+
+		// Frames in flight may still use the old pipeline
+		if (m_meshPipeline)
+			static_cast<VKRendererAPI*>(Renderer::Get())->RetireObject(Ref<Pipeline>(std::move(m_meshPipeline)));
+
+		configInfo.pipelineLayout = m_vkMeshPipelineLayout;
+		m_meshPipeline = CreateScope<Pipeline>(
+			"Shader/meshlet.task.spv",
+			"Shader/meshlet.mesh.spv",
+			"Shader/meshlet.frag.spv",
+			configInfo);
+	}
+
+
+	void ClusterCulling::DrawMeshTasks(FrameContext& frame, vk::CommandBuffer commandBuffer, VKModel& model, const glm::mat4& transform,
+		const glm::mat4& viewProjection, const glm::vec3& cameraPosition)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+		Scope<DescriptorAllocator>& descriptors = static_cast<VKRendererAPI*>(Renderer::Get())->GetDescriptors();
+
+		LOG_RENDER_ASSERT(m_meshPipeline, "Mesh shading pipeline is not created!");
+
+		// Models loaded without mesh shaders have no vertex storage buffers
+		uint32_t count = model.GetMeshletCount();
+		uint32_t instance = PushInstance(frame, transform, viewProjection);
+		if (count == 0 or instance == UINT32_MAX or !model.GetVertexStorageBuffer())
+			return;
+
+		vk::DescriptorSet set = descriptors->Allocate(frame, m_meshSetLayout->GetLayout());
+		WriteDescriptors(set, {
+			vk::DescriptorBufferInfo(model.GetMeshletBuffer(), 0, VK_WHOLE_SIZE),
+			vk::DescriptorBufferInfo(m_vkInstanceBuffer, sizeof(ClusterInstance) * MAX_INSTANCES * frame.index, sizeof(ClusterInstance) * MAX_INSTANCES),
+			vk::DescriptorBufferInfo(model.GetMeshletVertexBuffer(), 0, VK_WHOLE_SIZE),
+			vk::DescriptorBufferInfo(model.GetMeshletTriangleBuffer(), 0, VK_WHOLE_SIZE),
+			vk::DescriptorBufferInfo(model.GetVertexStorageBuffer(), 0, VK_WHOLE_SIZE),
+		});
+
+		ClusterPushConstants push{};
+		GPUCulling::ExtractFrustum(viewProjection, push.planes);
+		push.cameraPosition = glm::vec4(cameraPosition, 1.0f);
+		push.meshletCount = count;
+		push.instance = instance;
+
+		commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_vkMeshPipelineLayout, 0, set, nullptr);
+		commandBuffer.pushConstants(m_vkMeshPipelineLayout, vk::ShaderStageFlagBits::eTaskEXT | vk::ShaderStageFlagBits::eMeshEXT,
+			0, sizeof(ClusterPushConstants), &push);
+		device->CmdDrawMeshTasks(commandBuffer, (count + TASK_GROUP_SIZE - 1) / TASK_GROUP_SIZE);
+	}
+
+
+	bool ClusterCulling::IsAvailable()
+	{
+		return Assets::Exist("Shader/cluster.comp.spv", "RendererVulkan");
+	}
+
+
+	uint32_t ClusterCulling::PushInstance(FrameContext& frame, const glm::mat4& transform, const glm::mat4& viewProjection)
+	{
+		// The buffers of the context are free again with a new frame
+		if (m_frameNumber != frame.number)
+		{
+			m_frameNumber = frame.number;
+			m_instanceCount = 0;
+			m_drawCount = 0;
+		}
+
+		if (m_instanceCount >= MAX_INSTANCES)
+		{
+			LOG_RENDER_WARN("Too many instances for cluster culling, only {} are drawn!", MAX_INSTANCES);
+			return UINT32_MAX;
+		}
+
+		ClusterInstance data{ transform, viewProjection };
+		memcpy(m_mapped + sizeof(ClusterInstance) * (MAX_INSTANCES * frame.index + m_instanceCount), &data, sizeof(ClusterInstance));
+		return m_instanceCount++;
+	}
+
+
+	void ClusterCulling::WriteDescriptors(vk::DescriptorSet set, const std::vector<vk::DescriptorBufferInfo>& bufferInfos)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		std::vector<vk::WriteDescriptorSet> writes(bufferInfos.size());
+		for (uint32_t i = 0; i < writes.size(); i++)
+		{
+			writes[i] = vk::WriteDescriptorSet();
+			{
+				writes[i].dstSet = set;
+				writes[i].dstBinding = i;
+				writes[i].dstArrayElement = 0;
+				writes[i].descriptorCount = 1;
+				writes[i].descriptorType = vk::DescriptorType::eStorageBuffer;
+				writes[i].pBufferInfo = &bufferInfos[i];
+			}
+		}
+		device->GetLogicalDevice().updateDescriptorSets(writes, nullptr);
+	}
+
+
+} // namespace Helios::Vulkan
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "Platform/Renderer/Vulkan/Core/FrameRing.h"
+#include "Platform/Renderer/Vulkan/Core/DescriptorSetLayout.h"
+#include "Platform/Renderer/Vulkan/Core/ComputePipeline.h"
+#include "Platform/Renderer/Vulkan/Core/Pipeline.h"
+
+namespace Helios {
+	class VKModel;
+}
+
+namespace Helios::Vulkan {
+
+
+	// Meshlet as read by the cluster culling shaders (std430 layout)
+	struct ClusterMeshlet
+	{
+		// Bounding sphere in model space (xyz center, w radius)
+		glm::vec4 sphere{0.f};
+		// Normal cone in model space (xyz axis, w cutoff)
+		glm::vec4 cone{0.f, 0.f, 0.f, 1.f};
+		uint32_t vertexOffset = 0;
+		uint32_t vertexCount = 0;
+		uint32_t triangleOffset = 0;
+		uint32_t triangleCount = 0;
+	};
+
+
+	// Culling of the meshlets of a model against the frustum and their normal cones.
+	// Without mesh shaders a compute shader writes one indexed indirect draw per
+	// meshlet (without instances if it is culled), drawn from the meshlet index
+	// buffer of the model with the pipeline of the caller.
+	// With mesh shaders (VK_EXT_mesh_shader) a task shader runs the same test and
+	// only launches mesh shader groups for the visible meshlets.
+	class ClusterCulling
+	{
+	public:
+		ClusterCulling(uint32_t framesInFlight);
+		~ClusterCulling();
+
+		void Create(uint32_t framesInFlight);
+		void Destroy();
+
+	public:
+		// Culls the meshlets of an instance of the model (outside of a render pass),
+		// returns the first draw command of the instance (UINT32_MAX if it does not fit)
+		uint32_t Cull(FrameContext& frame, VKModel& model, const glm::mat4& transform,
+			const glm::mat4& viewProjection, const glm::vec3& cameraPosition);
+		// Draws the meshlets with the commands written by Cull (with the buffers of
+		// VKModel::vkBindMeshlets and a pipeline with the vertex layout of the model)
+		void DrawIndirect(FrameContext& frame, vk::CommandBuffer commandBuffer, VKModel& model, uint32_t firstDraw);
+
+		// Creates the mesh shading pipeline for the pass of the config
+		// (again after the render graph was compiled)
+		void CreateMeshPipeline(PipelineConfigInfo& configInfo);
+		// Culls and draws the meshlets of an instance with the task and mesh shaders
+		// (with the mesh shading pipeline bound, binds its own set 0)
+		void DrawMeshTasks(FrameContext& frame, vk::CommandBuffer commandBuffer, VKModel& model, const glm::mat4& transform,
+			const glm::mat4& viewProjection, const glm::vec3& cameraPosition);
+
+		bool UsesMeshShader() const { return m_meshShader; }
+		// Mesh shading pipeline (nullptr without mesh shaders)
+		Pipeline* GetMeshPipeline() { return m_meshPipeline.get(); }
+		// The shaders are optional until all platforms ship them
+		static bool IsAvailable();
+
+	// Vulkan objects
+	private:
+		vk::PipelineLayout m_vkCullPipelineLayout;
+		vk::PipelineLayout m_vkMeshPipelineLayout;
+		// Instances (host visible) and draw commands of all frames in flight
+		vk::Buffer m_vkInstanceBuffer;
+		vk::DeviceMemory m_vkInstanceMemory;
+		vk::Buffer m_vkDrawBuffer;
+		vk::DeviceMemory m_vkDrawMemory;
+
+	// Internal helper
+	private:
+		// Stores the instance in the buffer of the frame, returns its index
+		uint32_t PushInstance(FrameContext& frame, const glm::mat4& transform, const glm::mat4& viewProjection);
+		void WriteDescriptors(vk::DescriptorSet set, const std::vector<vk::DescriptorBufferInfo>& bufferInfos);
+
+	// Internal data
+	private:
+		static constexpr uint32_t MAX_INSTANCES = 1024;
+		static constexpr uint32_t MAX_DRAWS = 65536;
+		static constexpr uint32_t GROUP_SIZE = 64;
+		// Meshlets per task shader group
+		static constexpr uint32_t TASK_GROUP_SIZE = 32;
+
+		Scope<DescriptorSetLayout> m_cullSetLayout;
+		Scope<DescriptorSetLayout> m_meshSetLayout;
+		Scope<ComputePipeline> m_cullPipeline;
+		Scope<Pipeline> m_meshPipeline;
+		uint8_t* m_mapped = nullptr;
+		bool m_meshShader = false;
+
+		// Usage of the buffers by the current frame
+		uint64_t m_frameNumber = 0;
+		uint32_t m_instanceCount = 0;
+		uint32_t m_drawCount = 0;
+	};
+
+
+} // namespace Helios::Vulkan
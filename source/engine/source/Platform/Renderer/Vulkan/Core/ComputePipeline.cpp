@@ -0,0 +1,74 @@
+#include "pch.h"
+#include "ComputePipeline.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+
+#include "HeliosEngine/Core/Assets.h"
+
+
+namespace Helios::Vulkan {
+
+
+	ComputePipeline::ComputePipeline(const std::string &compShader, vk::PipelineLayout pipelineLayout)
+	{
+		Create(compShader, pipelineLayout);
+	}
+
+
+	ComputePipeline::~ComputePipeline()
+	{
+		Destroy();
+	}
+
+
+	void ComputePipeline::Create(const std::string &compShader, vk::PipelineLayout pipelineLayout)
+	{
+		Scope<Device> &device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Creating compute pipeline objects...");
+
+		auto compCode = Assets::Load(compShader, "RendererVulkan");
+		m_vkCompShaderModule = Pipeline::CreateShaderModule(compCode);
+
+		vk::ComputePipelineCreateInfo pipelineInfo = vk::ComputePipelineCreateInfo();
+		{
+			pipelineInfo.stage.stage = vk::ShaderStageFlagBits::eCompute;
+			pipelineInfo.stage.module = m_vkCompShaderModule;
+			pipelineInfo.stage.pName = "main";
+			pipelineInfo.layout = pipelineLayout;
+
+			pipelineInfo.basePipelineIndex = -1;
+			pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+		}
+
+		try {
+			LOG_RENDER_TRACE("Creating compute pipeline...");
+			m_vkComputePipeline = device->GetLogicalDevice().createComputePipeline(nullptr, pipelineInfo).value;
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to create compute pipeline!");
+		}
+	}
+
+
+	void ComputePipeline::Destroy()
+	{
+		Scope<Device> &device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Destroying compute pipeline objects...");
+
+		if (m_vkCompShaderModule)
+			device->GetLogicalDevice().destroyShaderModule(m_vkCompShaderModule);
+		if (m_vkComputePipeline)
+			device->GetLogicalDevice().destroyPipeline(m_vkComputePipeline);
+	}
+
+
+	void ComputePipeline::Bind(vk::CommandBuffer commandBuffer)
+	{
+		commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, m_vkComputePipeline);
+	}
+
+
+} // namespace Helios::Vulkan
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+namespace Helios::Vulkan {
+
+
+	class ComputePipeline
+	{
+	public:
+		ComputePipeline(const std::string &compShader, vk::PipelineLayout pipelineLayout);
+		~ComputePipeline();
+
+		void Create(const std::string &compShader, vk::PipelineLayout pipelineLayout);
+		void Destroy();
+
+	public:
+		void Bind(vk::CommandBuffer commandBuffer);
+
+	// Getter for vulkan objects
+	public:
+		vk::Pipeline& GetComputePipeline() { return m_vkComputePipeline; }
+
+	// Vulkan objects
+	private:
+		vk::Pipeline m_vkComputePipeline;
+		vk::ShaderModule m_vkCompShaderModule;
+	};
+
+
+} // namespace Helios::Vulkan
@@ -0,0 +1,51 @@
+#include "pch.h"
+#include "DeletionQueue.h"
+
+
+namespace Helios::Vulkan {
+
+
+	DeletionQueue::DeletionQueue()
+	{
+	}
+
+
+	DeletionQueue::~DeletionQueue()
+	{
+		ReleaseAll();
+	}
+
+
+	void DeletionQueue::Push(uint64_t frame, Ref<void> object)
+	{
+		m_entries.push_back({ frame, std::move(object), nullptr });
+	}
+
+
+	void DeletionQueue::Push(uint64_t frame, std::function<void()> deleter)
+	{
+		m_entries.push_back({ frame, nullptr, std::move(deleter) });
+	}
+
+
+	void DeletionQueue::Release(uint64_t completedFrame)
+	{
+		while (!m_entries.empty() and m_entries.front().frame <= completedFrame)
+		{
+			// Taken out first, releasing an object might retire further objects
+			Entry entry = std::move(m_entries.front());
+			m_entries.pop_front();
+
+			if (entry.deleter)
+				entry.deleter();
+		}
+	}
+
+
+	void DeletionQueue::ReleaseAll()
+	{
+		Release(std::numeric_limits<uint64_t>::max());
+	}
+
+
+} // namespace Helios::Vulkan
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <deque>
+
+namespace Helios::Vulkan {
+
+
+	// Objects which are destroyed on the CPU but might still be used by
+	// frames in flight. Every entry is tagged with the number of the last
+	// frame which could use it and released once the GPU finished that frame,
+	// so no runtime path has to wait for the device to be idle.
+	class DeletionQueue
+	{
+	public:
+		DeletionQueue();
+		~DeletionQueue();
+
+	public:
+		// Keeps the object alive until the frame is finished
+		void Push(uint64_t frame, Ref<void> object);
+		// Calls the function once the frame is finished (for raw vulkan handles)
+		void Push(uint64_t frame, std::function<void()> deleter);
+
+		// Releases all entries of finished frames
+		void Release(uint64_t completedFrame);
+		// Releases everything (the device has to be idle)
+		void ReleaseAll();
+
+		size_t GetSize() const { return m_entries.size(); }
+
+	// Internal data
+	private:
+		struct Entry
+		{
+			uint64_t frame;
+			Ref<void> object;
+			std::function<void()> deleter;
+		};
+
+		// Ordered by the frame number (frames only count up)
+		std::deque<Entry> m_entries;
+	};
+
+
+} // namespace Helios::Vulkan
@@ -0,0 +1,139 @@
+#include "pch.h"
+#include "DescriptorAllocator.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+
+
+namespace Helios::Vulkan {
+
+
+	DescriptorAllocator::DescriptorAllocator(uint32_t framesInFlight)
+	{
+		Create(framesInFlight);
+	}
+
+
+	DescriptorAllocator::~DescriptorAllocator()
+	{
+		Destroy();
+	}
+
+
+	void DescriptorAllocator::Create(uint32_t framesInFlight)
+	{
+		LOG_RENDER_TRACE("Creating descriptor allocator objects...");
+
+		m_frames.resize(framesInFlight);
+	}
+
+
+	void DescriptorAllocator::Destroy()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Destroying descriptor allocator objects...");
+
+		for (auto& frame : m_frames)
+		{
+			for (auto pool : frame.used)
+				device->GetLogicalDevice().destroyDescriptorPool(pool);
+		}
+		m_frames.clear();
+
+		for (auto pool : m_freePools)
+			device->GetLogicalDevice().destroyDescriptorPool(pool);
+		m_freePools.clear();
+	}
+
+
+	void DescriptorAllocator::BeginFrame(FrameContext& frame)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		FramePools& pools = m_frames[frame.index];
+		for (auto pool : pools.used)
+		{
+			device->GetLogicalDevice().resetDescriptorPool(pool);
+			m_freePools.push_back(pool);
+		}
+		pools.used.clear();
+		pools.current = nullptr;
+	}
+
+
+	vk::DescriptorSet DescriptorAllocator::Allocate(FrameContext& frame, vk::DescriptorSetLayout layout)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		FramePools& pools = m_frames[frame.index];
+
+		vk::DescriptorSetAllocateInfo allocInfo = vk::DescriptorSetAllocateInfo();
+		{
+			allocInfo.descriptorSetCount = 1;
+			allocInfo.pSetLayouts = &layout;
+		}
+
+		// Second try with a fresh pool if the current one is exhausted
+		for (int attempt = 0; attempt < 2; attempt++)
+		{
+			if (!pools.current)
+			{
+				pools.current = GetPool();
+				pools.used.push_back(pools.current);
+			}
+			allocInfo.descriptorPool = pools.current;
+
+			try {
+				return device->GetLogicalDevice().allocateDescriptorSets(allocInfo)[0];
+			}
+			catch (vk::OutOfPoolMemoryError err) {
+				pools.current = nullptr;
+			}
+			catch (vk::FragmentedPoolError err) {
+				pools.current = nullptr;
+			}
+			catch (vk::SystemError err) {
+				LOG_RENDER_EXCEPT("Failed to allocate descriptor set!");
+			}
+		}
+
+		LOG_RENDER_EXCEPT("Failed to allocate descriptor set!");
+	}
+
+
+	vk::DescriptorPool DescriptorAllocator::GetPool()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		if (!m_freePools.empty())
+		{
+			vk::DescriptorPool pool = m_freePools.back();
+			m_freePools.pop_back();
+			return pool;
+		}
+
+		std::vector<vk::DescriptorPoolSize> sizes;
+		for (auto& [type, ratio] : POOL_RATIOS)
+			sizes.push_back({ type, static_cast<uint32_t>(ratio * SETS_PER_POOL) });
+
+		vk::DescriptorPoolCreateInfo poolInfo = vk::DescriptorPoolCreateInfo();
+		{
+			poolInfo.maxSets = SETS_PER_POOL;
+			poolInfo.poolSizeCount = static_cast<uint32_t>(sizes.size());
+			poolInfo.pPoolSizes = sizes.data();
+		}
+
+		vk::DescriptorPool pool;
+		try {
+			LOG_RENDER_TRACE("Creating descriptor pool...");
+			pool = device->GetLogicalDevice().createDescriptorPool(poolInfo);
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to create descriptor pool!");
+		}
+		return pool;
+	}
+
+
+} // namespace Helios::Vulkan
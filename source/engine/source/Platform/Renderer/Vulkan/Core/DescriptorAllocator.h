@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "Platform/Renderer/Vulkan/Core/FrameRing.h"
+
+namespace Helios::Vulkan {
+
+
+	// Allocates descriptor sets which are only valid for one frame.
+	// Every frame in flight has its own list of pools, which are reset as a
+	// whole when the context is used again, so sets are never freed one by one.
+	// New pools are created on demand if the current one is exhausted.
+	class DescriptorAllocator
+	{
+	public:
+		DescriptorAllocator(uint32_t framesInFlight);
+		~DescriptorAllocator();
+
+		void Create(uint32_t framesInFlight);
+		void Destroy();
+
+	public:
+		// Resets all pools of the context (the fence of the context has to be signaled)
+		void BeginFrame(FrameContext& frame);
+
+		vk::DescriptorSet Allocate(FrameContext& frame, vk::DescriptorSetLayout layout);
+
+	// Internal helper
+	private:
+		vk::DescriptorPool GetPool();
+
+	// Internal data
+	private:
+		static constexpr uint32_t SETS_PER_POOL = 256;
+		// Descriptors per type and pool (relative to the number of sets)
+		static constexpr std::array<std::pair<vk::DescriptorType, float>, 4> POOL_RATIOS = {{
+			{ vk::DescriptorType::eUniformBuffer,        1.0f },
+			{ vk::DescriptorType::eUniformBufferDynamic, 4.0f },
+			{ vk::DescriptorType::eStorageBuffer,        1.0f },
+			{ vk::DescriptorType::eCombinedImageSampler, 4.0f },
+		}};
+
+		struct FramePools
+		{
+			std::vector<vk::DescriptorPool> used;
+			vk::DescriptorPool current;
+		};
+
+		std::vector<FramePools> m_frames;
+		// Reset pools which are not used by any frame
+		std::vector<vk::DescriptorPool> m_freePools;
+	};
+
+
+} // namespace Helios::Vulkan
@@ -0,0 +1,69 @@
+#include "pch.h"
+#include "DescriptorSetLayout.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+
+
+namespace Helios::Vulkan {
+
+
+	DescriptorSetLayout::DescriptorSetLayout(const std::vector<vk::DescriptorSetLayoutBinding>& bindings)
+	{
+		Create(bindings);
+	}
+
+
+	DescriptorSetLayout::~DescriptorSetLayout()
+	{
+		Destroy();
+	}
+
+
+	void DescriptorSetLayout::Create(const std::vector<vk::DescriptorSetLayoutBinding>& bindings)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		m_bindings = bindings;
+
+		vk::DescriptorSetLayoutCreateInfo layoutInfo = vk::DescriptorSetLayoutCreateInfo();
+		{
+			layoutInfo.bindingCount = static_cast<uint32_t>(m_bindings.size());
+			layoutInfo.pBindings = m_bindings.data();
+		}
+
+		try {
+			LOG_RENDER_TRACE("Creating descriptor set layout ({} bindings)...", m_bindings.size());
+			m_vkLayout = device->GetLogicalDevice().createDescriptorSetLayout(layoutInfo);
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to create descriptor set layout!");
+		}
+	}
+
+
+	void DescriptorSetLayout::Destroy()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		if (m_vkLayout)
+			device->GetLogicalDevice().destroyDescriptorSetLayout(m_vkLayout);
+		m_vkLayout = nullptr;
+	}
+
+
+	vk::DescriptorSetLayoutBinding DescriptorSetLayout::Binding(uint32_t binding, vk::DescriptorType type, vk::ShaderStageFlags stages, uint32_t count)
+	{
+		vk::DescriptorSetLayoutBinding layoutBinding = vk::DescriptorSetLayoutBinding();
+		{
+			layoutBinding.binding = binding;
+			layoutBinding.descriptorType = type;
+			layoutBinding.descriptorCount = count;
+			layoutBinding.stageFlags = stages;
+			layoutBinding.pImmutableSamplers = nullptr;
+		}
+		return layoutBinding;
+	}
+
+
+} // namespace Helios::Vulkan
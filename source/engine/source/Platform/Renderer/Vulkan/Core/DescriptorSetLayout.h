@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+namespace Helios::Vulkan {
+
+
+	class DescriptorSetLayout
+	{
+	public:
+		DescriptorSetLayout(const std::vector<vk::DescriptorSetLayoutBinding>& bindings);
+		~DescriptorSetLayout();
+
+		void Create(const std::vector<vk::DescriptorSetLayoutBinding>& bindings);
+		void Destroy();
+
+	// Getter for vulkan objects
+	public:
+		vk::DescriptorSetLayout& GetLayout() { return m_vkLayout; }
+		const std::vector<vk::DescriptorSetLayoutBinding>& GetBindings() const { return m_bindings; }
+
+		// Shortcut for a single binding
+		static vk::DescriptorSetLayoutBinding Binding(uint32_t binding, vk::DescriptorType type, vk::ShaderStageFlags stages, uint32_t count = 1);
+
+	// Vulkan objects
+	private:
+		vk::DescriptorSetLayout m_vkLayout;
+
+	// Internal data
+	private:
+		std::vector<vk::DescriptorSetLayoutBinding> m_bindings;
+	};
+
+
+} // namespace Helios::Vulkan
@@ -4,6 +4,9 @@
 #include "HeliosEngine/Renderer/Renderer.h"
 #include "Platform/Renderer/Vulkan/VKRendererAPI.h"
 
+#include "HeliosEngine/Core/Config.h"
+#include "HeliosEngine/Core/Timer.h"
+
 #include <GLFW/glfw3.h>
 
 
@@ -26,10 +29,15 @@ namespace Helios::Vulkan {
 	{
 		LOG_RENDER_TRACE("Creating device objects...");
 
+		Timer timer;
 		PickPhysicalDevice();
+		LOG_RENDER_DEBUG("Startup: physical device selection took {:.2f} ms", timer.ElapsedMillis());
+
+		timer.Reset();
 		CreateLogicalDevice();
 		GetQueues();
 		CreateCommandPool();
+		LOG_RENDER_DEBUG("Startup: logical device creation took {:.2f} ms", timer.ElapsedMillis());
 	}
 
 
@@ -37,6 +45,8 @@ namespace Helios::Vulkan {
 	{
 		LOG_RENDER_TRACE("Destroying device objects...");
 
+		if (m_vkComputeCommandPool)
+			m_vkLogicalDevice.destroyCommandPool(m_vkComputeCommandPool);
 		if (m_vkCommandPool)
 			m_vkLogicalDevice.destroyCommandPool(m_vkCommandPool);
 		if (m_vkLogicalDevice)
@@ -44,15 +54,27 @@ namespace Helios::Vulkan {
 	}
 
 
-	QueueFamilyIndices Device::QueryQueueFamilies(vk::PhysicalDevice device)
+	const SurfaceSupport& Device::GetSurfaceSupport()
 	{
 		Scope<Instance> &instance = static_cast<VKRendererAPI*>(Renderer::Get())->GetInstance();
 
-		if (!device)
-			device = m_vkPhysicalDevice;
+		if (!m_surfaceSupport.has_value())
+		{
+			SurfaceSupport support;
+			support.formats = m_vkPhysicalDevice.getSurfaceFormatsKHR(instance->GetSurface());
+			support.presentModes = m_vkPhysicalDevice.getSurfacePresentModesKHR(instance->GetSurface());
+			m_surfaceSupport = support;
+		}
+
+		return m_surfaceSupport.value();
+	}
+
+
+	QueueFamilyIndices Device::QueryQueueFamilies(const vk::PhysicalDevice &device, const std::vector<vk::QueueFamilyProperties> &queueFamilies)
+	{
+		Scope<Instance> &instance = static_cast<VKRendererAPI*>(Renderer::Get())->GetInstance();
 
 		QueueFamilyIndices indices;
-		std::vector<vk::QueueFamilyProperties> queueFamilies = device.getQueueFamilyProperties();
 
 		uint32_t i = 0;
 		for (auto& q : queueFamilies)
@@ -62,7 +84,10 @@ namespace Helios::Vulkan {
 				indices.graphicsFamily = i;
 
 			// Check presentation support (both: GLFW, native)
-			if (glfwGetPhysicalDevicePresentationSupport(instance->GetInstance(), device, i) == GLFW_TRUE)
+			// Without a surface nothing is presented, so the graphics queue is used
+			if (!instance->HasSurface())
+				indices.presentFamily = indices.graphicsFamily;
+			else if (glfwGetPhysicalDevicePresentationSupport(instance->GetInstance(), device, i) == GLFW_TRUE)
 			{
 				if (device.getSurfaceSupportKHR(i, instance->GetSurface()))
 					indices.presentFamily = i;
@@ -76,35 +101,104 @@ namespace Helios::Vulkan {
 			i++;
 		}
 
+		// A compute family without graphics runs independent of the graphics queue
+		for (i = 0; i < static_cast<uint32_t>(queueFamilies.size()); i++)
+		{
+			vk::QueueFlags flags = queueFamilies[i].queueFlags;
+			if ((flags & vk::QueueFlagBits::eCompute) and !(flags & vk::QueueFlagBits::eGraphics))
+			{
+				indices.computeFamily = i;
+				break;
+			}
+		}
+
 		return indices;
 	}
 
 
+	bool Device::IsFormatSupported(vk::Format format, vk::ImageTiling tiling, vk::FormatFeatureFlags features)
+	{
+		vk::FormatProperties props = m_vkPhysicalDevice.getFormatProperties(format);
+
+		if (tiling == vk::ImageTiling::eLinear)
+			return (props.linearTilingFeatures & features) == features;
+		else if (tiling == vk::ImageTiling::eOptimal)
+			return (props.optimalTilingFeatures & features) == features;
+		return false;
+	}
+
+
 	vk::Format Device::QuerySupportedFormat(const std::vector<vk::Format> &candidates, vk::ImageTiling tiling, vk::FormatFeatureFlags features)
 	{
 		for (vk::Format format : candidates)
 		{
-			vk::FormatProperties props = m_vkPhysicalDevice.getFormatProperties(format);
-
-			if (tiling == vk::ImageTiling::eLinear && (props.linearTilingFeatures & features) == features)
-				return format;
-			else if (tiling == vk::ImageTiling::eOptimal && (props.optimalTilingFeatures & features) == features)
+			if (IsFormatSupported(format, tiling, features))
 				return format;
 		}
 		LOG_RENDER_EXCEPT("Failed to find supported format!");
 	}
 
 
+	vk::Format Device::QueryDepthFormat()
+	{
+		return QuerySupportedFormat(
+			{
+				vk::Format::eD32Sfloat,
+				vk::Format::eD32SfloatS8Uint,
+				vk::Format::eD24UnormS8Uint
+			},
+			vk::ImageTiling::eOptimal,
+			vk::FormatFeatureFlagBits::eDepthStencilAttachment
+		);
+	}
+
+
 	uint32_t Device::QueryMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags props)
 	{
-		vk::PhysicalDeviceMemoryProperties memProps = m_vkPhysicalDevice.getMemoryProperties();
+		std::optional<uint32_t> type = FindMemoryType(typeFilter, props);
+		if (type.has_value())
+			return type.value();
+
+		LOG_RENDER_EXCEPT("Failed to query suitable memory type!");
+	}
+
+
+	std::optional<uint32_t> Device::FindMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags props)
+	{
+		const vk::PhysicalDeviceMemoryProperties& memProps = m_info.caps.memoryProperties;
 		for (uint32_t i = 0; i < memProps.memoryTypeCount; i++)
 		{
 			if ((typeFilter & (1 << i)) && (memProps.memoryTypes[i].propertyFlags & props) == props)
 				return i;
 		}
 
-		LOG_RENDER_EXCEPT("Failed to query suitable memory type!");
+		return {};
+	}
+
+
+	vk::SampleCountFlagBits Device::QueryMSAASamples()
+	{
+		uint32_t requested = static_cast<uint32_t>(std::strtoul(Config::Get("MSAA", "1").c_str(), nullptr, 10));
+
+		const vk::PhysicalDeviceProperties& props = m_info.caps.properties;
+		vk::SampleCountFlags supported =
+			props.limits.framebufferColorSampleCounts &
+			props.limits.framebufferDepthSampleCounts;
+
+		// Highest supported count not above the requested one
+		for (uint32_t samples = 64; samples > 1; samples /= 2)
+		{
+			vk::SampleCountFlagBits count = static_cast<vk::SampleCountFlagBits>(samples);
+			if (samples > requested or !(supported & count))
+				continue;
+			if (samples != requested)
+				LOG_RENDER_WARN("MSAA with {} samples is not supported, using {} samples!", requested, samples);
+			return count;
+		}
+
+		if (requested > 1)
+			LOG_RENDER_WARN("MSAA is not supported!");
+		return vk::SampleCountFlagBits::e1;
 	}
 
 
@@ -140,13 +234,20 @@ namespace Helios::Vulkan {
 	}
 
 
-	void Device::CreateBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage, vk::MemoryPropertyFlags props, vk::Buffer& buffer, vk::DeviceMemory& bufferMemory)
+	void Device::CreateBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage, vk::MemoryPropertyFlags props, vk::Buffer& buffer, vk::DeviceMemory& bufferMemory,
+		const std::vector<uint32_t>& queueFamilies)
 	{
 		vk::BufferCreateInfo bufferInfo = vk::BufferCreateInfo();
 		{
 			bufferInfo.size = size;
 			bufferInfo.usage = usage;
 			bufferInfo.sharingMode = vk::SharingMode::eExclusive;
+			if (queueFamilies.size() > 1)
+			{
+				bufferInfo.sharingMode = vk::SharingMode::eConcurrent;
+				bufferInfo.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilies.size());
+				bufferInfo.pQueueFamilyIndices = queueFamilies.data();
+			}
 		}
 
 		if (m_vkLogicalDevice.createBuffer(&bufferInfo, nullptr, &buffer) != vk::Result::eSuccess) {
@@ -170,6 +271,74 @@ namespace Helios::Vulkan {
 	}
 
 
+	void Device::CmdBeginRendering(vk::CommandBuffer commandBuffer, const vk::RenderingInfoKHR &renderingInfo)
+	{
+		m_pfnCmdBeginRendering(commandBuffer, reinterpret_cast<const VkRenderingInfoKHR*>(&renderingInfo));
+	}
+
+
+	void Device::CmdEndRendering(vk::CommandBuffer commandBuffer)
+	{
+		m_pfnCmdEndRendering(commandBuffer);
+	}
+
+
+	vk::Semaphore Device::CreateTimelineSemaphore(uint64_t initialValue)
+	{
+		vk::SemaphoreTypeCreateInfoKHR typeInfo = vk::SemaphoreTypeCreateInfoKHR();
+		{
+			typeInfo.semaphoreType = vk::SemaphoreTypeKHR::eTimeline;
+			typeInfo.initialValue = initialValue;
+		}
+		vk::SemaphoreCreateInfo semInfo = vk::SemaphoreCreateInfo();
+		{
+			semInfo.pNext = &typeInfo;
+		}
+
+		vk::Semaphore semaphore;
+		try {
+			semaphore = m_vkLogicalDevice.createSemaphore(semInfo);
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to create timeline semaphore!");
+		}
+		return semaphore;
+	}
+
+
+	uint64_t Device::GetSemaphoreCounterValue(vk::Semaphore semaphore)
+	{
+		uint64_t value = 0;
+		if (m_pfnGetSemaphoreCounterValue(m_vkLogicalDevice, semaphore, &value) != VK_SUCCESS)
+			LOG_RENDER_EXCEPT("Failed to query timeline semaphore value!");
+		return value;
+	}
+
+
+	bool Device::WaitSemaphore(vk::Semaphore semaphore, uint64_t value, uint64_t timeout)
+	{
+		VkSemaphore handle = semaphore;
+		VkSemaphoreWaitInfoKHR waitInfo = {};
+		{
+			waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+			waitInfo.semaphoreCount = 1;
+			waitInfo.pSemaphores = &handle;
+			waitInfo.pValues = &value;
+		}
+
+		VkResult result = m_pfnWaitSemaphores(m_vkLogicalDevice, &waitInfo, timeout);
+		if (result != VK_SUCCESS and result != VK_TIMEOUT)
+			LOG_RENDER_EXCEPT("Failed to wait for timeline semaphore!");
+		return result == VK_SUCCESS;
+	}
+
+
+	void Device::CmdDrawMeshTasks(vk::CommandBuffer commandBuffer, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+	{
+		m_pfnCmdDrawMeshTasks(commandBuffer, groupCountX, groupCountY, groupCountZ);
+	}
+
+
 	std::vector<const char*> Device::GetRequiredLayers()
 	{
 		std::vector<const char*> layers;
@@ -185,36 +354,165 @@ namespace Helios::Vulkan {
 
 	std::vector<const char*> Device::GetRequiredExtensions()
 	{
+		Scope<Instance> &instance = static_cast<VKRendererAPI*>(Renderer::Get())->GetInstance();
+
 		std::vector<const char*> extensions;
 
 		// Setup list of extensions
-		extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+		if (instance->HasSurface())
+			extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
 
 		return extensions;
 	}
 
 
+	bool Device::CheckSupportedExtension(const PhysicalDeviceInfo &info, const char* extension)
+	{
+		return info.caps.extensions.contains(extension);
+	}
+
+
+	bool Device::QueryDescriptorIndexing(const PhysicalDeviceInfo &info)
+	{
+		if (Config::Get("Bindless", "1") == "0")
+			return false;
+
+		if (!CheckSupportedExtension(info, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME))
+			return false;
+
+		auto chain = info.device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceDescriptorIndexingFeaturesEXT>();
+		auto& indexing = chain.get<vk::PhysicalDeviceDescriptorIndexingFeaturesEXT>();
+
+		return
+			indexing.shaderSampledImageArrayNonUniformIndexing and
+			indexing.runtimeDescriptorArray and
+			indexing.descriptorBindingPartiallyBound and
+			indexing.descriptorBindingSampledImageUpdateAfterBind and
+			indexing.descriptorBindingStorageBufferUpdateAfterBind and
+			indexing.descriptorBindingUpdateUnusedWhilePending;
+	}
+
+
+	bool Device::QueryDynamicRendering(const PhysicalDeviceInfo &info, bool &core)
+	{
+		Scope<Instance> &instance = static_cast<VKRendererAPI*>(Renderer::Get())->GetInstance();
+
+		core = false;
+		if (Config::Get("DynamicRendering", "1") == "0")
+			return false;
+
+		// Part of Vulkan 1.3 (if the instance is created with 1.3 as well)
+		uint32_t apiVersion = std::min(info.caps.properties.apiVersion, instance->GetApiVersion());
+		if (VK_API_VERSION_MAJOR(apiVersion) == 1 and VK_API_VERSION_MINOR(apiVersion) >= 3)
+			core = true;
+		else if (!CheckSupportedExtension(info, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME) or
+			!CheckSupportedExtension(info, VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME) or
+			!CheckSupportedExtension(info, VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME))
+			return false;
+
+		auto chain = info.device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceDynamicRenderingFeaturesKHR>();
+		return chain.get<vk::PhysicalDeviceDynamicRenderingFeaturesKHR>().dynamicRendering;
+	}
+
+
+	bool Device::QueryTimelineSemaphore(const PhysicalDeviceInfo &info, bool &core)
+	{
+		Scope<Instance> &instance = static_cast<VKRendererAPI*>(Renderer::Get())->GetInstance();
+
+		core = false;
+		if (Config::Get("TimelineSemaphore", "1") == "0")
+			return false;
+
+		// Part of Vulkan 1.2 (if the instance is created with 1.2 as well)
+		uint32_t apiVersion = std::min(info.caps.properties.apiVersion, instance->GetApiVersion());
+		if (VK_API_VERSION_MAJOR(apiVersion) == 1 and VK_API_VERSION_MINOR(apiVersion) >= 2)
+			core = true;
+		else if (!CheckSupportedExtension(info, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME))
+			return false;
+
+		auto chain = info.device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>();
+		return chain.get<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>().timelineSemaphore;
+	}
+
+
+	bool Device::QueryMeshShader(const PhysicalDeviceInfo &info, bool &spirv14Core)
+	{
+		Scope<Instance> &instance = static_cast<VKRendererAPI*>(Renderer::Get())->GetInstance();
+
+		spirv14Core = false;
+		if (Config::Get("MeshShader", "1") == "0")
+			return false;
+		if (!CheckSupportedExtension(info, VK_EXT_MESH_SHADER_EXTENSION_NAME))
+			return false;
+
+		// The shaders need SPIR-V 1.4 (part of Vulkan 1.2)
+		uint32_t apiVersion = std::min(info.caps.properties.apiVersion, instance->GetApiVersion());
+		if (VK_API_VERSION_MAJOR(apiVersion) == 1 and VK_API_VERSION_MINOR(apiVersion) >= 2)
+			spirv14Core = true;
+		else if (!CheckSupportedExtension(info, VK_KHR_SPIRV_1_4_EXTENSION_NAME) or
+			!CheckSupportedExtension(info, VK_KHR_SHADER_FLOAT_CONTROLS_EXTENSION_NAME))
+			return false;
+
+		auto chain = info.device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceMeshShaderFeaturesEXT>();
+		const auto& features = chain.get<vk::PhysicalDeviceMeshShaderFeaturesEXT>();
+		return features.meshShader and features.taskShader;
+	}
+
+
+	void Device::QueryOptionalFeatures(PhysicalDeviceInfo &info)
+	{
+		PhysicalDeviceCaps& caps = info.caps;
+		caps.descriptorIndexing = QueryDescriptorIndexing(info);
+		caps.dynamicRendering = QueryDynamicRendering(info, caps.dynamicRenderingCore);
+		caps.timelineSemaphore = QueryTimelineSemaphore(info, caps.timelineSemaphoreCore);
+		caps.meshShader = QueryMeshShader(info, caps.spirv14Core);
+	}
+
+
 	void Device::PickPhysicalDevice()
 	{
 		// Get all suitable devices
 		GetPhysicalDevices();
 
-		// Pick the most suitable device
-		PhysicalDeviceInfo current = {};
-		for (auto entry : m_ListPhysicalDevices)
+		// A device can be pinned by "vendor:device" (hex IDs as logged) or
+		// only by the vendor, e.g. to force the discrete GPU of a laptop
+		std::string pinned = Config::Get("PhysicalDevice", "");
+		std::optional<uint32_t> pinnedVendor;
+		std::optional<uint32_t> pinnedDevice;
+		if (!pinned.empty())
 		{
-			if (current.score < entry.score)
-			{
-				m_vkPhysicalDevice = entry.device;
-				current = entry;
-			}
+			size_t separator = pinned.find(':');
+			pinnedVendor = static_cast<uint32_t>(std::strtoul(pinned.substr(0, separator).c_str(), nullptr, 16));
+			if (separator != std::string::npos)
+				pinnedDevice = static_cast<uint32_t>(std::strtoul(pinned.substr(separator + 1).c_str(), nullptr, 16));
+		}
+		auto isPinned = [&](const PhysicalDeviceInfo& entry) {
+			return
+				pinnedVendor.has_value() and entry.vendorID == pinnedVendor.value() and
+				(!pinnedDevice.has_value() or entry.deviceID == pinnedDevice.value());
+		};
+		bool anyPinned = std::any_of(m_ListPhysicalDevices.begin(), m_ListPhysicalDevices.end(), isPinned);
+		if (pinnedVendor.has_value() and !anyPinned)
+			LOG_RENDER_WARN("Pinned physical device \"{}\" is not available or not suitable!", pinned);
+
+		// Pick the most suitable device (among the pinned ones)
+		const PhysicalDeviceInfo* current = nullptr;
+		for (auto& entry : m_ListPhysicalDevices)
+		{
+			if (anyPinned and !isPinned(entry))
+				continue;
+			if (!current or current->score < entry.score)
+				current = &entry;
 		}
 
-		if (!m_vkPhysicalDevice)
+		if (!current)
 			LOG_RENDER_EXCEPT("Failed to find a suitable physical device!");
 
+		m_info = *current;
+		m_vkPhysicalDevice = m_info.device;
+
 		LOG_RENDER_INFO("Selected physical device: ({:04X}:{:04X}) \"{}\"",
-			current.vendorID, current.deviceID, current.name);
+			m_info.vendorID, m_info.deviceID, m_info.name);
 	}
 
 
@@ -231,8 +529,18 @@ namespace Helios::Vulkan {
 		std::vector<vk::PhysicalDevice> available = instance->GetInstance().enumeratePhysicalDevices();
 		for (auto dev : available)
 		{
-			// Get device properties
-			vk::PhysicalDeviceProperties props = dev.getProperties();
+			// Query everything needed about the device once
+			PhysicalDeviceInfo newEntry;
+			newEntry.device = dev;
+			PhysicalDeviceCaps& caps = newEntry.caps;
+			caps.properties = dev.getProperties();
+			caps.features = dev.getFeatures();
+			caps.memoryProperties = dev.getMemoryProperties();
+			caps.queueFamilies = dev.getQueueFamilyProperties();
+			std::vector<vk::ExtensionProperties> supported = dev.enumerateDeviceExtensionProperties();
+			for (auto& ext : supported)
+				caps.extensions.insert(ext.extensionName.data());
+			const vk::PhysicalDeviceProperties& props = caps.properties;
 
 			// Log device
 			LOG_RENDER_INFO("Physical device:");
@@ -257,10 +565,10 @@ namespace Helios::Vulkan {
 			auto extensions = GetRequiredExtensions();
 			std::set<std::string> required(extensions.begin(), extensions.end());
 			if (LOG_LEVEL < LOG_LEVEL_DEBUG)
-				LOG_RENDER_TRACE("Supported device extensions ({}):", dev.enumerateDeviceExtensionProperties().size());
+				LOG_RENDER_TRACE("Supported device extensions ({}):", supported.size());
 			else
-				LOG_RENDER_DEBUG("Required device extensions ({}/{}):", required.size(), dev.enumerateDeviceExtensionProperties().size());
-			for (auto& ext : dev.enumerateDeviceExtensionProperties())
+				LOG_RENDER_DEBUG("Required device extensions ({}/{}):", required.size(), supported.size());
+			for (auto& ext : supported)
 			{
 				if (required.contains(ext.extensionName))
 					LOG_RENDER_DEBUG("[  OK  ] \"{}\"", ext.extensionName);
@@ -277,7 +585,8 @@ namespace Helios::Vulkan {
 			}
 
 			// Find suitable queue families
-			QueueFamilyIndices indices = QueryQueueFamilies(dev);
+			caps.queueFamilyIndices = QueryQueueFamilies(dev, caps.queueFamilies);
+			const QueueFamilyIndices& indices = caps.queueFamilyIndices;
 			if (!indices.complete())
 			{
 				LOG_RENDER_DEBUG("Unsupported queue families:");
@@ -290,13 +599,12 @@ namespace Helios::Vulkan {
 
 
 			// Setup device entry
-			PhysicalDeviceInfo newEntry;
-			newEntry.device = dev;
+			QueryOptionalFeatures(newEntry);
 			newEntry.name = props.deviceName.data();
 			newEntry.deviceID = props.deviceID;
 			newEntry.vendorID = props.vendorID;
 			newEntry.type = props.deviceType;
-			newEntry.score = RateSuitability(dev);
+			newEntry.score = RateSuitability(newEntry);
 			LOG_RENDER_INFO("[ INFO ] Device is suitable (score: {}).", newEntry.score);
 
 			// Add device entry to the list
@@ -308,12 +616,15 @@ namespace Helios::Vulkan {
 	}
 
 
-	int Device::RateSuitability(const vk::PhysicalDevice &device)
+	int Device::RateSuitability(const PhysicalDeviceInfo &info)
 	{
 		int score = 0;
 
 		// Get device properties
-		vk::PhysicalDeviceProperties props = device.getProperties();
+		const vk::PhysicalDeviceProperties& props = info.caps.properties;
+		const vk::PhysicalDeviceFeatures& features = info.caps.features;
+		const vk::PhysicalDeviceMemoryProperties& memProps = info.caps.memoryProperties;
+		const std::vector<vk::QueueFamilyProperties>& queueFamilies = info.caps.queueFamilies;
 
 		// Score based on type
 		switch (props.deviceType)
@@ -325,14 +636,56 @@ namespace Helios::Vulkan {
 		case vk::PhysicalDeviceType::eOther:         score = 0; break;
 		}
 
+		// Dedicated memory: 1 point per 64 MiB (up to 16 GiB), integrated GPUs
+		// report shared system memory as device local, so it counts half
+		vk::DeviceSize vram = 0;
+		for (uint32_t i = 0; i < memProps.memoryHeapCount; i++)
+		{
+			if (memProps.memoryHeaps[i].flags & vk::MemoryHeapFlagBits::eDeviceLocal)
+				vram += memProps.memoryHeaps[i].size;
+		}
+		int memoryScore = static_cast<int>(std::min<vk::DeviceSize>(vram >> 20, 16384) / 64);
+		if (props.deviceType != vk::PhysicalDeviceType::eDiscreteGpu)
+			memoryScore /= 2;
+		score += memoryScore;
+
+		// Queues which run beside the graphics queue
+		bool dedicatedCompute = false;
+		bool dedicatedTransfer = false;
+		for (auto& q : queueFamilies)
+		{
+			if ((q.queueFlags & vk::QueueFlagBits::eCompute) and !(q.queueFlags & vk::QueueFlagBits::eGraphics))
+				dedicatedCompute = true;
+			if ((q.queueFlags & vk::QueueFlagBits::eTransfer) and !(q.queueFlags & (vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute)))
+				dedicatedTransfer = true;
+		}
+		if (dedicatedCompute)
+			score += 100;
+		if (dedicatedTransfer)
+			score += 50;
+
+		// Optional features the renderer makes use of
+		const PhysicalDeviceCaps& caps = info.caps;
+		if (caps.descriptorIndexing)
+			score += 100;
+		if (caps.dynamicRendering)
+			score += 50;
+		if (caps.timelineSemaphore)
+			score += 50;
+		if (caps.meshShader)
+			score += 25;
+		if (features.textureCompressionBC or features.textureCompressionASTC_LDR)
+			score += 25;
+
 		// 128 bytes garanteed
 		// 256 bytes more common
 		if (props.limits.maxPushConstantsSize >= 256)
 			score += 100;
 
-		// TODO...
-		// TODO...
-		// TODO...
+		LOG_RENDER_DEBUG("[ INFO ] VRAM: {} MiB, dedicated compute: {}, dedicated transfer: {}",
+			vram >> 20, dedicatedCompute, dedicatedTransfer);
+		LOG_RENDER_DEBUG("[ INFO ] Descriptor indexing: {}, dynamic rendering: {}, timeline semaphores: {}, mesh shaders: {}",
+			caps.descriptorIndexing, caps.dynamicRendering, caps.timelineSemaphore, caps.meshShader);
 
 		return score;
 	}
@@ -341,11 +694,15 @@ namespace Helios::Vulkan {
 	void Device::CreateLogicalDevice()
 	{
 		// Setup QueueInfo
-		QueueFamilyIndices indices = QueryQueueFamilies(m_vkPhysicalDevice);
+		const QueueFamilyIndices& indices = GetQueueFamilies();
 		std::vector<uint32_t> uniqueIndices;
 		uniqueIndices.push_back(indices.graphicsFamily.value());
 		if (indices.graphicsFamily.value() != indices.presentFamily.value())
 			uniqueIndices.push_back(indices.presentFamily.value());
+		m_features.asyncCompute = indices.computeFamily.has_value() and Config::Get("AsyncCompute", "1") != "0";
+		if (m_features.asyncCompute and std::find(uniqueIndices.begin(), uniqueIndices.end(), indices.computeFamily.value()) == uniqueIndices.end())
+			uniqueIndices.push_back(indices.computeFamily.value());
+		LOG_RENDER_DEBUG("Async compute: {}", m_features.asyncCompute ? "enabled" : "not available");
 		float queuePriority = 1.0f;
 		std::vector<vk::DeviceQueueCreateInfo> QueueInfo;
 		for (uint32_t index : uniqueIndices)
@@ -363,13 +720,97 @@ namespace Helios::Vulkan {
 		vk::PhysicalDeviceFeatures DeviceFeatures = vk::PhysicalDeviceFeatures();
 		{
 			DeviceFeatures.setSamplerAnisotropy(VK_TRUE);
+
+			// Compressed textures are used if available
+			const vk::PhysicalDeviceFeatures& supported = m_info.caps.features;
+			m_features.textureCompressionBC = supported.textureCompressionBC;
+			m_features.textureCompressionASTC = supported.textureCompressionASTC_LDR;
+			DeviceFeatures.setTextureCompressionBC(supported.textureCompressionBC);
+			DeviceFeatures.setTextureCompressionASTC_LDR(supported.textureCompressionASTC_LDR);
+
+			// Cluster culling draws all meshlets of a model at once
+			m_features.multiDrawIndirect = supported.multiDrawIndirect;
+			DeviceFeatures.setMultiDrawIndirect(supported.multiDrawIndirect);
+		}
+		LOG_RENDER_DEBUG("Texture compression: BC {}, ASTC {}",
+			m_features.textureCompressionBC ? "enabled" : "not available",
+			m_features.textureCompressionASTC ? "enabled" : "not available");
+
+		// Setup optional features
+		auto extensions = GetRequiredExtensions();
+		void* pNextFeature = nullptr;
+
+		vk::PhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures = vk::PhysicalDeviceDescriptorIndexingFeaturesEXT();
+		// Support was queried while enumerating the devices
+		const PhysicalDeviceCaps& caps = m_info.caps;
+		m_features.descriptorIndexing = caps.descriptorIndexing;
+		if (m_features.descriptorIndexing)
+		{
+			indexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			indexingFeatures.runtimeDescriptorArray = VK_TRUE;
+			indexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+			indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			indexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+			indexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+			indexingFeatures.pNext = pNextFeature;
+			pNextFeature = &indexingFeatures;
+			extensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+		}
+		LOG_RENDER_DEBUG("Descriptor indexing (bindless): {}", m_features.descriptorIndexing ? "enabled" : "not available");
+
+		vk::PhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures = vk::PhysicalDeviceDynamicRenderingFeaturesKHR();
+		bool dynamicRenderingCore = caps.dynamicRenderingCore;
+		m_features.dynamicRendering = caps.dynamicRendering;
+		if (m_features.dynamicRendering)
+		{
+			dynamicRenderingFeatures.dynamicRendering = VK_TRUE;
+			dynamicRenderingFeatures.pNext = pNextFeature;
+			pNextFeature = &dynamicRenderingFeatures;
+			if (!dynamicRenderingCore)
+			{
+				extensions.push_back(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME);
+				extensions.push_back(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME);
+				extensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+			}
+		}
+		LOG_RENDER_DEBUG("Dynamic rendering: {}", !m_features.dynamicRendering ? "not available" : dynamicRenderingCore ? "enabled (core)" : "enabled (extension)");
+
+		vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR timelineFeatures = vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR();
+		bool timelineSemaphoreCore = caps.timelineSemaphoreCore;
+		m_features.timelineSemaphore = caps.timelineSemaphore;
+		if (m_features.timelineSemaphore)
+		{
+			timelineFeatures.timelineSemaphore = VK_TRUE;
+			timelineFeatures.pNext = pNextFeature;
+			pNextFeature = &timelineFeatures;
+			if (!timelineSemaphoreCore)
+				extensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+		}
+		LOG_RENDER_DEBUG("Timeline semaphores: {}", !m_features.timelineSemaphore ? "not available" : timelineSemaphoreCore ? "enabled (core)" : "enabled (extension)");
+
+		vk::PhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures = vk::PhysicalDeviceMeshShaderFeaturesEXT();
+		bool spirv14Core = caps.spirv14Core;
+		m_features.meshShader = caps.meshShader;
+		if (m_features.meshShader)
+		{
+			meshShaderFeatures.taskShader = VK_TRUE;
+			meshShaderFeatures.meshShader = VK_TRUE;
+			meshShaderFeatures.pNext = pNextFeature;
+			pNextFeature = &meshShaderFeatures;
+			extensions.push_back(VK_EXT_MESH_SHADER_EXTENSION_NAME);
+			if (!spirv14Core)
+			{
+				extensions.push_back(VK_KHR_SPIRV_1_4_EXTENSION_NAME);
+				extensions.push_back(VK_KHR_SHADER_FLOAT_CONTROLS_EXTENSION_NAME);
+			}
 		}
+		LOG_RENDER_DEBUG("Mesh shaders: {}", m_features.meshShader ? "enabled" : "not available");
 
 		// Setup DeviceInfo
 		auto layers = GetRequiredLayers();
-		auto extensions = GetRequiredExtensions();
 		vk::DeviceCreateInfo deviceInfo = vk::DeviceCreateInfo();
 		{
+			deviceInfo.pNext = pNextFeature;
 			deviceInfo.queueCreateInfoCount = static_cast<uint32_t>(QueueInfo.size());
 			deviceInfo.pQueueCreateInfos = QueueInfo.data();
 			deviceInfo.enabledLayerCount = static_cast<uint32_t>(layers.size());
@@ -387,20 +828,58 @@ namespace Helios::Vulkan {
 		catch (vk::SystemError err) {
 			LOG_RENDER_EXCEPT("Failed to create logical device!");
 		}
+
+		// The engine links the loader statically, so commands of extensions
+		// (and of newer versions) are loaded from the device
+		if (m_features.dynamicRendering)
+		{
+			const char* begin = dynamicRenderingCore ? "vkCmdBeginRendering" : "vkCmdBeginRenderingKHR";
+			const char* end = dynamicRenderingCore ? "vkCmdEndRendering" : "vkCmdEndRenderingKHR";
+			m_pfnCmdBeginRendering = reinterpret_cast<PFN_vkCmdBeginRenderingKHR>(m_vkLogicalDevice.getProcAddr(begin));
+			m_pfnCmdEndRendering = reinterpret_cast<PFN_vkCmdEndRenderingKHR>(m_vkLogicalDevice.getProcAddr(end));
+			if (!m_pfnCmdBeginRendering or !m_pfnCmdEndRendering)
+			{
+				LOG_RENDER_WARN("Failed to load dynamic rendering commands, using render passes!");
+				m_features.dynamicRendering = false;
+			}
+		}
+		if (m_features.timelineSemaphore)
+		{
+			const char* getValue = timelineSemaphoreCore ? "vkGetSemaphoreCounterValue" : "vkGetSemaphoreCounterValueKHR";
+			const char* wait = timelineSemaphoreCore ? "vkWaitSemaphores" : "vkWaitSemaphoresKHR";
+			m_pfnGetSemaphoreCounterValue = reinterpret_cast<PFN_vkGetSemaphoreCounterValueKHR>(m_vkLogicalDevice.getProcAddr(getValue));
+			m_pfnWaitSemaphores = reinterpret_cast<PFN_vkWaitSemaphoresKHR>(m_vkLogicalDevice.getProcAddr(wait));
+			if (!m_pfnGetSemaphoreCounterValue or !m_pfnWaitSemaphores)
+			{
+				LOG_RENDER_WARN("Failed to load timeline semaphore commands, using fences!");
+				m_features.timelineSemaphore = false;
+			}
+		}
+		if (m_features.meshShader)
+		{
+			m_pfnCmdDrawMeshTasks = reinterpret_cast<PFN_vkCmdDrawMeshTasksEXT>(m_vkLogicalDevice.getProcAddr("vkCmdDrawMeshTasksEXT"));
+			if (!m_pfnCmdDrawMeshTasks)
+			{
+				LOG_RENDER_WARN("Failed to load mesh shader commands, using indirect draws!");
+				m_features.meshShader = false;
+			}
+		}
 	}
 
 
 	void Device::GetQueues()
 	{
-		QueueFamilyIndices indices = QueryQueueFamilies(m_vkPhysicalDevice);
+		const QueueFamilyIndices& indices = GetQueueFamilies();
 		m_vkGraphicsQueue = m_vkLogicalDevice.getQueue(indices.graphicsFamily.value(), 0);
 		m_vkPresentQueue = m_vkLogicalDevice.getQueue(indices.presentFamily.value(), 0);
+		if (m_features.asyncCompute)
+			m_vkComputeQueue = m_vkLogicalDevice.getQueue(indices.computeFamily.value(), 0);
 	}
 
 
 	void Device::CreateCommandPool()
 	{
-		QueueFamilyIndices indices = QueryQueueFamilies(m_vkPhysicalDevice);
+		const QueueFamilyIndices& indices = GetQueueFamilies();
 		vk::CommandPoolCreateInfo poolInfo = vk::CommandPoolCreateInfo();
 		{
 			poolInfo.queueFamilyIndex = indices.graphicsFamily.value();
@@ -416,6 +895,18 @@ namespace Helios::Vulkan {
 		catch (vk::SystemError err) {
 			LOG_RENDER_EXCEPT("Failed to create command pool!");
 		}
+
+		if (!m_features.asyncCompute)
+			return;
+
+		poolInfo.queueFamilyIndex = indices.computeFamily.value();
+		try {
+			LOG_RENDER_TRACE("Creating compute command pool...");
+			m_vkComputeCommandPool = m_vkLogicalDevice.createCommandPool(poolInfo);
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to create command pool!");
+		}
 	}
 
 
@@ -9,11 +9,68 @@ namespace Helios::Vulkan {
 	{
 		std::optional<uint32_t> graphicsFamily;
 		std::optional<uint32_t> presentFamily;
+		// Family without graphics support (async compute, optional)
+		std::optional<uint32_t> computeFamily;
 
 		bool complete() { return graphicsFamily.has_value() && presentFamily.has_value(); }
 	};
 
 
+	// Optional features which are enabled if the device supports them
+	struct DeviceFeatures
+	{
+		// Bindless descriptors (VK_EXT_descriptor_indexing)
+		bool descriptorIndexing = false;
+		// Block compressed texture formats
+		bool textureCompressionBC = false;
+		bool textureCompressionASTC = false;
+		// Rendering without render pass and framebuffer objects
+		// (Vulkan 1.3 or VK_KHR_dynamic_rendering)
+		bool dynamicRendering = false;
+		// Dedicated compute queue which runs beside the graphics queue
+		bool asyncCompute = false;
+		// Semaphores with a 64 bit counter, used to track frames on the GPU
+		// (Vulkan 1.2 or VK_KHR_timeline_semaphore)
+		bool timelineSemaphore = false;
+		// Several indirect draws with one command
+		bool multiDrawIndirect = false;
+		// Task and mesh shaders (VK_EXT_mesh_shader)
+		bool meshShader = false;
+	};
+
+
+	// Everything about a physical device which does not change,
+	// queried once while enumerating the devices
+	struct PhysicalDeviceCaps
+	{
+		vk::PhysicalDeviceProperties properties;
+		vk::PhysicalDeviceFeatures features;
+		vk::PhysicalDeviceMemoryProperties memoryProperties;
+		std::vector<vk::QueueFamilyProperties> queueFamilies;
+		QueueFamilyIndices queueFamilyIndices;
+		std::set<std::string> extensions;
+
+		// Support of the optional features (false if turned off by the config),
+		// "core" if no extension is needed for them
+		bool descriptorIndexing = false;
+		bool dynamicRendering = false;
+		bool dynamicRenderingCore = false;
+		bool timelineSemaphore = false;
+		bool timelineSemaphoreCore = false;
+		bool meshShader = false;
+		bool spirv14Core = false;
+	};
+
+
+	// Formats and present modes of the surface (the capabilities are not
+	// cached, the current extent changes with the window)
+	struct SurfaceSupport
+	{
+		std::vector<vk::SurfaceFormatKHR> formats;
+		std::vector<vk::PresentModeKHR> presentModes;
+	};
+
+
 	struct PhysicalDeviceInfo
 	{
 		vk::PhysicalDevice device = {};
@@ -21,7 +78,8 @@ namespace Helios::Vulkan {
 		uint32_t vendorID;
 		uint32_t deviceID;
 		vk::PhysicalDeviceType type;
-		int score;
+		int score = 0;
+		PhysicalDeviceCaps caps;
 	};
 
 
@@ -41,13 +99,41 @@ namespace Helios::Vulkan {
 		vk::Queue& GetGraphicsQueue() { return m_vkGraphicsQueue; }
 		vk::Queue& GetPresentQueue() { return m_vkPresentQueue; }
 		vk::CommandPool& GetCommandPool() { return m_vkCommandPool; }
-
-		QueueFamilyIndices QueryQueueFamilies(vk::PhysicalDevice device = nullptr);
+		// Async compute queue and its pool (the graphics ones without async compute)
+		vk::Queue& GetComputeQueue() { return m_features.asyncCompute ? m_vkComputeQueue : m_vkGraphicsQueue; }
+		vk::CommandPool& GetComputeCommandPool() { return m_features.asyncCompute ? m_vkComputeCommandPool : m_vkCommandPool; }
+
+		const DeviceFeatures& GetFeatures() const { return m_features; }
+		const PhysicalDeviceCaps& GetCaps() const { return m_info.caps; }
+		const QueueFamilyIndices& GetQueueFamilies() const { return m_info.caps.queueFamilyIndices; }
+		// Queried with the first call (needs the surface)
+		const SurfaceSupport& GetSurfaceSupport();
+
+		bool IsFormatSupported(vk::Format format, vk::ImageTiling tiling, vk::FormatFeatureFlags features);
+		vk::Format QueryDepthFormat();
 		vk::Format QuerySupportedFormat(const std::vector<vk::Format> &candidates, vk::ImageTiling tiling, vk::FormatFeatureFlags features);
 		uint32_t QueryMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags props);
+		std::optional<uint32_t> FindMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags props);
+		// Samples of the color and depth attachments (Config "MSAA", clamped to the device limits)
+		vk::SampleCountFlagBits QueryMSAASamples();
 
 		void CreateImageWithMemory(const vk::ImageCreateInfo &imageInfo, vk::MemoryPropertyFlags props, vk::Image &image, vk::DeviceMemory &imageMemory);
-		void CreateBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage, vk::MemoryPropertyFlags props, vk::Buffer &buffer, vk::DeviceMemory &bufferMemory);
+		// Buffers used by several queue families (e.g. async compute) are shared concurrently
+		void CreateBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage, vk::MemoryPropertyFlags props, vk::Buffer &buffer, vk::DeviceMemory &bufferMemory,
+			const std::vector<uint32_t> &queueFamilies = {});
+
+		// Dynamic rendering (only if the feature is enabled)
+		void CmdBeginRendering(vk::CommandBuffer commandBuffer, const vk::RenderingInfoKHR &renderingInfo);
+		void CmdEndRendering(vk::CommandBuffer commandBuffer);
+
+		// Timeline semaphores (only if the feature is enabled)
+		vk::Semaphore CreateTimelineSemaphore(uint64_t initialValue = 0);
+		uint64_t GetSemaphoreCounterValue(vk::Semaphore semaphore);
+		// Returns false on timeout
+		bool WaitSemaphore(vk::Semaphore semaphore, uint64_t value, uint64_t timeout = std::numeric_limits<uint64_t>::max());
+
+		// Mesh shaders (only if the feature is enabled)
+		void CmdDrawMeshTasks(vk::CommandBuffer commandBuffer, uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1);
 
 	// Vulkan objects
 	private:
@@ -56,14 +142,24 @@ namespace Helios::Vulkan {
 		vk::Queue m_vkGraphicsQueue;
 		vk::Queue m_vkPresentQueue;
 		vk::CommandPool m_vkCommandPool;
+		vk::Queue m_vkComputeQueue;
+		vk::CommandPool m_vkComputeCommandPool;
 
 	// Internal helper
 	private:
 		std::vector<const char*> GetRequiredLayers();
 		std::vector<const char*> GetRequiredExtensions();
+		bool CheckSupportedExtension(const PhysicalDeviceInfo &info, const char* extension);
+		bool QueryDescriptorIndexing(const PhysicalDeviceInfo &info);
+		bool QueryDynamicRendering(const PhysicalDeviceInfo &info, bool &core);
+		bool QueryTimelineSemaphore(const PhysicalDeviceInfo &info, bool &core);
+		bool QueryMeshShader(const PhysicalDeviceInfo &info, bool &spirv14Core);
+		// Fills the optional features of the caps
+		void QueryOptionalFeatures(PhysicalDeviceInfo &info);
+		QueueFamilyIndices QueryQueueFamilies(const vk::PhysicalDevice &device, const std::vector<vk::QueueFamilyProperties> &queueFamilies);
 		void PickPhysicalDevice();
 		std::vector<PhysicalDeviceInfo>& GetPhysicalDevices();
-		int RateSuitability(const vk::PhysicalDevice &device);
+		int RateSuitability(const PhysicalDeviceInfo &info);
 		void CreateLogicalDevice();
 		void GetQueues();
 		void CreateCommandPool();
@@ -71,6 +167,17 @@ namespace Helios::Vulkan {
 	// Internal data
 	private:
 		std::vector<PhysicalDeviceInfo> m_ListPhysicalDevices;
+		// The selected device
+		PhysicalDeviceInfo m_info;
+		DeviceFeatures m_features;
+		std::optional<SurfaceSupport> m_surfaceSupport;
+
+		// Loaded at runtime, the commands are not exported by older loaders
+		PFN_vkCmdBeginRenderingKHR m_pfnCmdBeginRendering = nullptr;
+		PFN_vkCmdEndRenderingKHR m_pfnCmdEndRendering = nullptr;
+		PFN_vkGetSemaphoreCounterValueKHR m_pfnGetSemaphoreCounterValue = nullptr;
+		PFN_vkWaitSemaphoresKHR m_pfnWaitSemaphores = nullptr;
+		PFN_vkCmdDrawMeshTasksEXT m_pfnCmdDrawMeshTasks = nullptr;
 	};
 
 
@@ -0,0 +1,431 @@
+#include "pch.h"
+#include "FrameCapture.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+
+
+namespace Helios::Vulkan {
+
+
+	FrameCapture::FrameCapture(uint32_t framesInFlight)
+	{
+		Create(framesInFlight);
+	}
+
+
+	FrameCapture::~FrameCapture()
+	{
+		Destroy();
+	}
+
+
+	void FrameCapture::Create(uint32_t framesInFlight)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Creating frame capture objects...");
+
+		// Reading from uncached memory is slow, so prefer cached memory
+		m_memoryProps = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+		const vk::PhysicalDeviceMemoryProperties& memProps = device->GetCaps().memoryProperties;
+		for (uint32_t i = 0; i < memProps.memoryTypeCount; i++)
+		{
+			vk::MemoryPropertyFlags cached = m_memoryProps | vk::MemoryPropertyFlagBits::eHostCached;
+			if ((memProps.memoryTypes[i].propertyFlags & cached) == cached)
+			{
+				m_memoryProps = cached;
+				break;
+			}
+		}
+
+		m_slots.resize(framesInFlight);
+
+		m_stopWriter = false;
+		m_writer = std::thread(&FrameCapture::WriterThread, this);
+	}
+
+
+	void FrameCapture::Destroy()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Destroying frame capture objects...");
+
+		// The device is idle, so outstanding captures are complete
+		for (auto& slot : m_slots)
+			ReadBack(slot);
+
+		// Finish all queued files
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopWriter = true;
+		}
+		m_condition.notify_one();
+		if (m_writer.joinable())
+			m_writer.join();
+
+		for (auto& readback : m_readbacks)
+			ResizeReadback(readback, 0);
+		m_readbacks.clear();
+		m_freeReadbacks.clear();
+		m_slots.clear();
+	}
+
+
+	void FrameCapture::RequestCapture(const std::string& path)
+	{
+		if (!GetFormatFromPath(path))
+		{
+			LOG_RENDER_WARN("Unsupported capture file type: \"{}\" (use .ppm or .raw)", path);
+			return;
+		}
+		CreateParentPath(path);
+		m_requestPath = path;
+	}
+
+
+	void FrameCapture::StartStream(const std::string& prefix, uint32_t interval, Format format)
+	{
+		LOG_RENDER_INFO("Capturing every {}. frame to \"{}_*.{}\"", interval, prefix, GetFormatExtension(format));
+
+		CreateParentPath(prefix);
+		m_streamPrefix = prefix;
+		m_streamInterval = interval;
+		m_streamFormat = format;
+	}
+
+
+	void FrameCapture::StopStream()
+	{
+		m_streamInterval = 0;
+	}
+
+
+	void FrameCapture::BeginFrame(FrameContext& frame)
+	{
+		ReadBack(m_slots[frame.index]);
+	}
+
+
+	void FrameCapture::ReadBack(Slot& slot)
+	{
+		if (!slot.pending)
+			return;
+		slot.pending = false;
+
+		// The writer owns the buffer until the file is written
+		Job job;
+		job.readback = slot.readback;
+		job.path = std::move(slot.path);
+		job.format = slot.format;
+		job.extent = slot.extent;
+		job.bgra = slot.bgra;
+		slot.readback = UINT32_MAX;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_jobs.push_back(std::move(job));
+		}
+		m_condition.notify_one();
+	}
+
+
+	void FrameCapture::Record(FrameContext& frame, RenderTarget& target, uint32_t imageIndex)
+	{
+		// Should this frame be captured?
+		Slot& slot = m_slots[frame.index];
+		bool stream = false;
+		if (!m_requestPath.empty())
+		{
+			slot.path = m_requestPath;
+			slot.format = GetFormatFromPath(m_requestPath).value();
+			m_requestPath.clear();
+		}
+		else if (m_streamInterval > 0 and frame.number % m_streamInterval == 0)
+		{
+			stream = true;
+			std::ostringstream path;
+			path << m_streamPrefix << "_" << std::setw(6) << std::setfill('0') << frame.number << "." << GetFormatExtension(m_streamFormat);
+			slot.path = path.str();
+			slot.format = m_streamFormat;
+		}
+		else
+			return;
+
+		// Only 8 bit RGBA/BGRA images are supported
+		vk::Format format = target.GetImageFormat();
+		bool rgba = format == vk::Format::eR8G8B8A8Srgb or format == vk::Format::eR8G8B8A8Unorm;
+		bool bgra = format == vk::Format::eB8G8R8A8Srgb or format == vk::Format::eB8G8R8A8Unorm;
+		if (!(rgba or bgra) or !(target.GetImageUsage() & vk::ImageUsageFlagBits::eTransferSrc))
+		{
+			LOG_RENDER_WARN("Frame capture is not supported by the render target ({})!", vk::to_string(format));
+			StopStream();
+			return;
+		}
+
+		// Never slow down the render loop for the stream, requested
+		// captures get a new buffer if all are in use
+		vk::Extent2D extent = target.GetExtent();
+		uint32_t readback = AcquireReadback(static_cast<vk::DeviceSize>(extent.width) * extent.height * 4, !stream);
+		if (readback == UINT32_MAX)
+		{
+			if (m_dropped++ == 0)
+				LOG_RENDER_WARN("Frame capture can not keep up, dropping frames!");
+			return;
+		}
+
+		slot.pending = true;
+		slot.readback = readback;
+		slot.extent = extent;
+		slot.bgra = bgra;
+		vk::Buffer buffer = m_readbacks[readback].buffer;
+
+		vk::CommandBuffer& commandBuffer = frame.commandBuffer;
+		vk::Image image = target.GetImage(imageIndex);
+		vk::ImageLayout finalLayout = target.GetFinalLayout();
+
+		vk::ImageSubresourceRange range;
+		{
+			range.aspectMask = vk::ImageAspectFlagBits::eColor;
+			range.baseMipLevel = 0;
+			range.levelCount = 1;
+			range.baseArrayLayer = 0;
+			range.layerCount = 1;
+		}
+
+		// Wait for the render pass
+		vk::ImageMemoryBarrier toTransfer = vk::ImageMemoryBarrier();
+		{
+			toTransfer.srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite;
+			toTransfer.dstAccessMask = vk::AccessFlagBits::eTransferRead;
+			toTransfer.oldLayout = finalLayout;
+			toTransfer.newLayout = vk::ImageLayout::eTransferSrcOptimal;
+			toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			toTransfer.image = image;
+			toTransfer.subresourceRange = range;
+		}
+		commandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eColorAttachmentOutput,
+			vk::PipelineStageFlagBits::eTransfer,
+			{}, nullptr, nullptr, toTransfer);
+
+		vk::BufferImageCopy region = vk::BufferImageCopy();
+		{
+			region.bufferOffset = 0;
+			region.bufferRowLength = 0;
+			region.bufferImageHeight = 0;
+			region.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+			region.imageSubresource.mipLevel = 0;
+			region.imageSubresource.baseArrayLayer = 0;
+			region.imageSubresource.layerCount = 1;
+			region.imageOffset = vk::Offset3D{ 0, 0, 0 };
+			region.imageExtent = vk::Extent3D{ slot.extent.width, slot.extent.height, 1 };
+		}
+		commandBuffer.copyImageToBuffer(image, vk::ImageLayout::eTransferSrcOptimal, buffer, region);
+
+		// Make the copy visible to the host after the fence
+		vk::BufferMemoryBarrier toHost = vk::BufferMemoryBarrier();
+		{
+			toHost.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+			toHost.dstAccessMask = vk::AccessFlagBits::eHostRead;
+			toHost.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			toHost.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			toHost.buffer = buffer;
+			toHost.offset = 0;
+			toHost.size = VK_WHOLE_SIZE;
+		}
+		commandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eTransfer,
+			vk::PipelineStageFlagBits::eHost,
+			{}, nullptr, toHost, nullptr);
+
+		// Give the image back (e.g. for presentation)
+		if (finalLayout != vk::ImageLayout::eTransferSrcOptimal)
+		{
+			vk::ImageMemoryBarrier toFinal = vk::ImageMemoryBarrier();
+			{
+				toFinal.srcAccessMask = vk::AccessFlagBits::eTransferRead;
+				toFinal.dstAccessMask = {};
+				toFinal.oldLayout = vk::ImageLayout::eTransferSrcOptimal;
+				toFinal.newLayout = finalLayout;
+				toFinal.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				toFinal.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				toFinal.image = image;
+				toFinal.subresourceRange = range;
+			}
+			commandBuffer.pipelineBarrier(
+				vk::PipelineStageFlagBits::eTransfer,
+				vk::PipelineStageFlagBits::eBottomOfPipe,
+				{}, nullptr, nullptr, toFinal);
+		}
+	}
+
+
+	uint32_t FrameCapture::AcquireReadback(vk::DeviceSize size, bool grow)
+	{
+		uint32_t index = UINT32_MAX;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_freeReadbacks.empty())
+			{
+				index = m_freeReadbacks.back();
+				m_freeReadbacks.pop_back();
+			}
+			// One buffer per frame in flight plus the queue of the writer
+			else if (grow or m_readbacks.size() < m_slots.size() + MAX_QUEUED)
+			{
+				index = static_cast<uint32_t>(m_readbacks.size());
+				m_readbacks.emplace_back();
+			}
+		}
+		if (index == UINT32_MAX)
+			return index;
+
+		// Not used by the writer, so no lock is needed
+		ResizeReadback(m_readbacks[index], size);
+		return index;
+	}
+
+
+	void FrameCapture::ResizeReadback(Readback& readback, vk::DeviceSize size)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		if (readback.size == size)
+			return;
+
+		if (readback.memory)
+		{
+			device->GetLogicalDevice().unmapMemory(readback.memory);
+			device->GetLogicalDevice().destroyBuffer(readback.buffer);
+			device->GetLogicalDevice().freeMemory(readback.memory);
+			readback.buffer = nullptr;
+			readback.memory = nullptr;
+			readback.mapped = nullptr;
+		}
+
+		readback.size = size;
+		if (size == 0)
+			return;
+
+		LOG_RENDER_TRACE("Creating frame capture buffer ({} bytes)...", size);
+		device->CreateBuffer(size, vk::BufferUsageFlagBits::eTransferDst, m_memoryProps, readback.buffer, readback.memory);
+
+		// Stays mapped for the lifetime of the buffer
+		readback.mapped = static_cast<uint8_t*>(device->GetLogicalDevice().mapMemory(readback.memory, 0, size));
+	}
+
+
+	void FrameCapture::WriterThread()
+	{
+		while (true)
+		{
+			Job job;
+			const uint8_t* pixels;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [this] { return m_stopWriter or !m_jobs.empty(); });
+				if (m_jobs.empty())
+					return;
+				job = std::move(m_jobs.front());
+				m_jobs.pop_front();
+				// Elements of the deque stay in place when new buffers are added
+				pixels = m_readbacks[job.readback].mapped;
+			}
+
+			std::ofstream file(job.path, std::ios::binary);
+			if (file)
+			{
+				size_t pixelCount = static_cast<size_t>(job.extent.width) * job.extent.height;
+				switch (job.format)
+				{
+				case Format::PPM:
+				{
+					std::vector<uint8_t> rgb(pixelCount * 3);
+					for (size_t i = 0; i < pixelCount; i++)
+					{
+						rgb[i * 3 + 0] = pixels[i * 4 + (job.bgra ? 2 : 0)];
+						rgb[i * 3 + 1] = pixels[i * 4 + 1];
+						rgb[i * 3 + 2] = pixels[i * 4 + (job.bgra ? 0 : 2)];
+					}
+					file << "P6\n" << job.extent.width << " " << job.extent.height << "\n255\n";
+					file.write(reinterpret_cast<const char*>(rgb.data()), rgb.size());
+					break;
+				}
+				case Format::Raw:
+				{
+					if (job.bgra)
+					{
+						std::vector<uint8_t> rgba(pixels, pixels + pixelCount * 4);
+						for (size_t i = 0; i < pixelCount; i++)
+							std::swap(rgba[i * 4 + 0], rgba[i * 4 + 2]);
+						file.write(reinterpret_cast<const char*>(rgba.data()), rgba.size());
+					}
+					else
+						file.write(reinterpret_cast<const char*>(pixels), pixelCount * 4);
+					break;
+				}
+				}
+
+				LOG_RENDER_DEBUG("Frame captured: \"{}\" ({}x{})", job.path, job.extent.width, job.extent.height);
+			}
+			else
+				LOG_RENDER_ERROR("Failed to write frame capture \"{}\"!", job.path);
+
+			// The buffer can be used for the next capture
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_freeReadbacks.push_back(job.readback);
+		}
+	}
+
+
+	void FrameCapture::CreateParentPath(const std::string& path)
+	{
+		std::filesystem::path parent = std::filesystem::path(path).parent_path();
+		if (parent.empty())
+			return;
+
+		std::error_code err;
+		std::filesystem::create_directories(parent, err);
+		if (err)
+			LOG_RENDER_WARN("Failed to create capture path \"{}\"!", parent.string());
+	}
+
+
+	std::optional<FrameCapture::Format> FrameCapture::GetFormatFromPath(const std::string& path)
+	{
+		std::string ext = std::filesystem::path(path).extension().string();
+		if (ext.empty())
+			return std::nullopt;
+
+		return GetFormatFromExtension(ext.substr(1));
+	}
+
+
+	std::optional<FrameCapture::Format> FrameCapture::GetFormatFromExtension(std::string ext)
+	{
+		std::transform(ext.begin(), ext.end(), ext.begin(),
+			[](unsigned char c) { return std::tolower(c); });
+
+		if (ext == "ppm")
+			return Format::PPM;
+		if (ext == "raw")
+			return Format::Raw;
+		return std::nullopt;
+	}
+
+
+	const char* FrameCapture::GetFormatExtension(Format format)
+	{
+		switch (format)
+		{
+		case Format::PPM: return "ppm";
+		case Format::Raw: return "raw";
+		}
+		return "";
+	}
+
+
+} // namespace Helios::Vulkan
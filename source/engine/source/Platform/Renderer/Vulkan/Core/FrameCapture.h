@@ -0,0 +1,129 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "Platform/Renderer/Vulkan/Core/FrameRing.h"
+#include "Platform/Renderer/Vulkan/Core/RenderTarget.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
+
+namespace Helios::Vulkan {
+
+
+	// Copies the color image of a frame into a host visible buffer and
+	// writes it to disk (.ppm or .raw RGBA8).
+	// The copy is recorded into the command buffer of the frame. Once the
+	// context is used again, the mapped buffer is handed over to a worker
+	// thread, which writes the file and gives the buffer back to the pool.
+	// Neither the render loop waits for the GPU nor copies any pixels.
+	class FrameCapture
+	{
+	public:
+		enum class Format { PPM = 0, Raw };
+
+	public:
+		FrameCapture(uint32_t framesInFlight);
+		~FrameCapture();
+
+		void Create(uint32_t framesInFlight);
+		void Destroy();
+
+	public:
+		// Captures the next frame (format from the file extension)
+		void RequestCapture(const std::string& path);
+		// Captures every Nth frame to "<prefix>_<frame number>.<ext>"
+		void StartStream(const std::string& prefix, uint32_t interval, Format format = Format::PPM);
+		void StopStream();
+		bool IsStreaming() const { return m_streamInterval > 0; }
+
+		// Hands the finished capture of the context over to the writer
+		// (the fence of the context has to be signaled)
+		void BeginFrame(FrameContext& frame);
+		// Records the copy of the image if the frame should be captured
+		// (has to be recorded after the render pass)
+		void Record(FrameContext& frame, RenderTarget& target, uint32_t imageIndex);
+
+		// Captures which were skipped because the writer could not keep up
+		uint64_t GetDroppedCount() const { return m_dropped; }
+
+		// "ppm" or "raw" (case insensitive)
+		static std::optional<Format> GetFormatFromExtension(std::string ext);
+
+	// Internal helper
+	private:
+		struct Slot;
+		struct Readback;
+		void ReadBack(Slot& slot);
+		// Returns a free readback buffer of the size (UINT32_MAX if the pool is used up)
+		uint32_t AcquireReadback(vk::DeviceSize size, bool grow);
+		void ResizeReadback(Readback& readback, vk::DeviceSize size);
+		void WriterThread();
+
+		static void CreateParentPath(const std::string& path);
+		static std::optional<Format> GetFormatFromPath(const std::string& path);
+		static const char* GetFormatExtension(Format format);
+
+	// Internal data
+	private:
+		// Captures waiting for the writer, before new stream captures are dropped
+		static constexpr size_t MAX_QUEUED = 8;
+
+		// Host visible buffer, owned either by a frame context (copy in
+		// flight) or by the writer (file in progress) while it is not free
+		struct Readback
+		{
+			vk::Buffer buffer;
+			vk::DeviceMemory memory;
+			uint8_t* mapped = nullptr;
+			vk::DeviceSize size = 0;
+		};
+
+		struct Slot
+		{
+			// Capture recorded and not read back yet
+			bool pending = false;
+			uint32_t readback = UINT32_MAX;
+			std::string path;
+			Format format = Format::PPM;
+			vk::Extent2D extent;
+			bool bgra = false;
+		};
+
+		struct Job
+		{
+			uint32_t readback;
+			std::string path;
+			Format format;
+			vk::Extent2D extent;
+			bool bgra;
+		};
+
+		std::vector<Slot> m_slots;
+		vk::MemoryPropertyFlags m_memoryProps;
+
+		// Readback buffers, never removed while the writer runs (free ones are
+		// only resized by the render thread)
+		std::deque<Readback> m_readbacks;
+		std::vector<uint32_t> m_freeReadbacks;
+
+		// Requests
+		std::string m_requestPath;
+		std::string m_streamPrefix;
+		uint32_t m_streamInterval = 0;
+		Format m_streamFormat = Format::PPM;
+		uint64_t m_dropped = 0;
+
+		// Writer
+		std::thread m_writer;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::deque<Job> m_jobs;
+		bool m_stopWriter = false;
+	};
+
+
+} // namespace Helios::Vulkan
@@ -0,0 +1,304 @@
+#include "pch.h"
+#include "FrameRing.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+
+#include "HeliosEngine/Core/Config.h"
+
+
+namespace Helios::Vulkan {
+
+
+	FrameRing::FrameRing(uint32_t framesInFlight)
+	{
+		Create(framesInFlight);
+	}
+
+
+	FrameRing::~FrameRing()
+	{
+		Destroy();
+	}
+
+
+	void FrameRing::Create(uint32_t framesInFlight)
+	{
+		LOG_RENDER_TRACE("Creating frame objects ({} frames in flight)...", framesInFlight);
+
+		m_frames.resize(framesInFlight);
+		for (uint32_t i = 0; i < framesInFlight; i++)
+			m_frames[i].index = i;
+
+		CreateCommandBuffers();
+		CreateSyncObjects();
+	}
+
+
+	void FrameRing::Destroy()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Destroying frame objects...");
+
+		for (auto& frame : m_frames)
+		{
+			if (frame.inFlight)
+				device->GetLogicalDevice().destroyFence(frame.inFlight);
+			if (frame.imageAvailable)
+				device->GetLogicalDevice().destroySemaphore(frame.imageAvailable);
+			if (frame.commandBuffer)
+				device->GetLogicalDevice().freeCommandBuffers(device->GetCommandPool(), frame.commandBuffer);
+		}
+		m_frames.clear();
+
+		if (m_vkTimeline)
+			device->GetLogicalDevice().destroySemaphore(m_vkTimeline);
+		m_vkTimeline = nullptr;
+	}
+
+
+	void FrameRing::SetArenas(LinearAllocator* transient, UniformRing* uniforms)
+	{
+		for (auto& frame : m_frames)
+		{
+			frame.transient = transient;
+			frame.uniforms = uniforms;
+		}
+	}
+
+
+	FrameContext& FrameRing::BeginFrame()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		FrameContext& frame = m_frames[m_currentFrame];
+
+		// Wait until the GPU is done with the previous frame of this context
+		if (m_vkTimeline)
+			WaitForFrame(frame.submitted);
+		else
+		{
+			auto resultWait = device->GetLogicalDevice().waitForFences(
+				1,
+				&frame.inFlight,
+				VK_TRUE,
+				std::numeric_limits<uint64_t>::max());
+			if (resultWait != vk::Result::eSuccess)
+				LOG_RENDER_EXCEPT("Failed to wait for frame fence!");
+			m_completedFrame = std::max(m_completedFrame, frame.submitted);
+		}
+
+		frame.number = ++m_frameNumber;
+		frame.waitSemaphores.clear();
+		frame.waitStages.clear();
+		frame.waitValues.clear();
+
+		return frame;
+	}
+
+
+	void FrameRing::Submit(FrameContext& frame, vk::Semaphore renderFinished)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		std::vector<vk::Semaphore> waitSemaphores = frame.waitSemaphores;
+		std::vector<vk::PipelineStageFlags> waitStages = frame.waitStages;
+		std::vector<uint64_t> waitValues = frame.waitValues;
+		waitValues.resize(waitSemaphores.size(), 0);
+		std::vector<vk::Semaphore> signalSemaphores;
+		std::vector<uint64_t> signalValues;
+		if (renderFinished)
+		{
+			waitSemaphores.push_back(frame.imageAvailable);
+			waitStages.push_back(vk::PipelineStageFlagBits::eColorAttachmentOutput);
+			waitValues.push_back(0);
+			signalSemaphores.push_back(renderFinished);
+			signalValues.push_back(0);
+		}
+		if (m_vkTimeline)
+		{
+			signalSemaphores.push_back(m_vkTimeline);
+			signalValues.push_back(frame.number);
+		}
+
+		// Values of the semaphores (binary semaphores ignore them)
+		vk::TimelineSemaphoreSubmitInfoKHR timelineInfo = vk::TimelineSemaphoreSubmitInfoKHR();
+		{
+			timelineInfo.waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size());
+			timelineInfo.pWaitSemaphoreValues = waitValues.data();
+			timelineInfo.signalSemaphoreValueCount = static_cast<uint32_t>(signalValues.size());
+			timelineInfo.pSignalSemaphoreValues = signalValues.data();
+		}
+
+		vk::SubmitInfo submitInfo = vk::SubmitInfo();
+		{
+			if (m_vkTimeline)
+				submitInfo.pNext = &timelineInfo;
+			submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
+			submitInfo.pWaitSemaphores = waitSemaphores.data();
+			submitInfo.pWaitDstStageMask = waitStages.data();
+			submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
+			submitInfo.pSignalSemaphores = signalSemaphores.data();
+			submitInfo.commandBufferCount = 1;
+			submitInfo.pCommandBuffers = &frame.commandBuffer;
+		}
+
+		vk::Fence fence = nullptr;
+		if (!m_vkTimeline)
+		{
+			auto resultReset = device->GetLogicalDevice().resetFences(1, &frame.inFlight);
+			fence = frame.inFlight;
+		}
+		try {
+			device->GetGraphicsQueue().submit(submitInfo, fence);
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to submit command buffer!");
+		}
+		frame.submitted = frame.number;
+		m_submittedFrame = frame.number;
+	}
+
+
+	void FrameRing::EndFrame()
+	{
+		m_currentFrame = (m_currentFrame + 1) % GetFramesInFlight();
+	}
+
+
+	uint64_t FrameRing::GetCompletedFrame()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		if (m_vkTimeline)
+		{
+			m_completedFrame = std::max(m_completedFrame, device->GetSemaphoreCounterValue(m_vkTimeline));
+			return m_completedFrame;
+		}
+
+		// Only submitted frames whose fence is signaled count as completed
+		// (fences are reset right before the submit of the context)
+		for (auto& frame : m_frames)
+		{
+			if (frame.submitted <= m_completedFrame)
+				continue;
+			if (device->GetLogicalDevice().getFenceStatus(frame.inFlight) == vk::Result::eSuccess)
+				m_completedFrame = frame.submitted;
+		}
+
+		return m_completedFrame;
+	}
+
+
+	void FrameRing::WaitForFrame(uint64_t number)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		// Dropped frames are never signaled, waiting for the last submitted one is enough
+		number = std::min(number, m_submittedFrame);
+		if (number <= m_completedFrame)
+			return;
+
+		if (m_vkTimeline)
+		{
+			device->WaitSemaphore(m_vkTimeline, number);
+			m_completedFrame = std::max(m_completedFrame, device->GetSemaphoreCounterValue(m_vkTimeline));
+			return;
+		}
+
+		// Frames of reused contexts were already waited for in BeginFrame
+		for (auto& frame : m_frames)
+		{
+			if (frame.submitted <= m_completedFrame or frame.submitted > number)
+				continue;
+
+			auto resultWait = device->GetLogicalDevice().waitForFences(
+				1,
+				&frame.inFlight,
+				VK_TRUE,
+				std::numeric_limits<uint64_t>::max());
+			if (resultWait != vk::Result::eSuccess)
+				LOG_RENDER_EXCEPT("Failed to wait for frame fence!");
+		}
+		m_completedFrame = number;
+	}
+
+
+	uint32_t FrameRing::QueryFramesInFlight()
+	{
+		std::string value = Config::Get("FramesInFlight", std::to_string(DEFAULT_FRAMES_IN_FLIGHT));
+		uint32_t frames = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+
+		if (frames == 0)
+			frames = DEFAULT_FRAMES_IN_FLIGHT;
+		if (frames < MIN_FRAMES_IN_FLIGHT or frames > MAX_FRAMES_IN_FLIGHT)
+		{
+			LOG_RENDER_WARN("Unsupported number of frames in flight: {}", frames);
+			frames = std::clamp(frames, MIN_FRAMES_IN_FLIGHT, MAX_FRAMES_IN_FLIGHT);
+		}
+
+		return frames;
+	}
+
+
+	void FrameRing::CreateCommandBuffers()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		vk::CommandBufferAllocateInfo allocInfo = vk::CommandBufferAllocateInfo();
+		{
+			allocInfo.level = vk::CommandBufferLevel::ePrimary;
+			allocInfo.commandPool = device->GetCommandPool();
+			allocInfo.commandBufferCount = GetFramesInFlight();
+		}
+
+		std::vector<vk::CommandBuffer> commandBuffers;
+		try {
+			LOG_RENDER_TRACE("Allocating command buffers...");
+			commandBuffers = device->GetLogicalDevice().allocateCommandBuffers(allocInfo);
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to allocate command buffer!");
+		}
+
+		for (auto& frame : m_frames)
+			frame.commandBuffer = commandBuffers[frame.index];
+	}
+
+
+	void FrameRing::CreateSyncObjects()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		vk::SemaphoreCreateInfo semInfo = vk::SemaphoreCreateInfo();
+		{
+		}
+		vk::FenceCreateInfo fenceInfo = vk::FenceCreateInfo();
+		{
+			fenceInfo.flags = vk::FenceCreateFlagBits::eSignaled;
+		}
+
+		bool timeline = device->GetFeatures().timelineSemaphore;
+		if (timeline)
+		{
+			LOG_RENDER_TRACE("Creating frame timeline semaphore...");
+			m_vkTimeline = device->CreateTimelineSemaphore(0);
+		}
+
+		for (auto& frame : m_frames)
+		{
+			try {
+				LOG_RENDER_TRACE("Creating sync objects for frame #{}...", frame.index);
+				frame.imageAvailable = device->GetLogicalDevice().createSemaphore(semInfo);
+				if (!timeline)
+					frame.inFlight = device->GetLogicalDevice().createFence(fenceInfo);
+			}
+			catch (vk::SystemError err) {
+				LOG_RENDER_EXCEPT("Failed to create frame sync objects!");
+			}
+		}
+	}
+
+
+} // namespace Helios::Vulkan
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+namespace Helios::Vulkan {
+
+
+	class LinearAllocator;
+	class UniformRing;
+
+
+	// All objects which are needed to record and submit one frame.
+	// There is one context per frame in flight, independent of the
+	// number of images the swapchain provides.
+	struct FrameContext
+	{
+		// Slot of the context within the ring
+		uint32_t index = 0;
+		// Monotonic number of the frame which is recorded with this context
+		uint64_t number = 0;
+		// Number of the last frame submitted with this context (a frame
+		// might be dropped before its submit, e.g. if the swapchain is out of date)
+		uint64_t submitted = 0;
+
+		vk::CommandBuffer commandBuffer;
+
+		// Sync objects (the semaphore signaled for the presentation belongs
+		// to the swapchain image, see RenderTarget::GetRenderFinished)
+		vk::Semaphore imageAvailable;
+		// Only without timeline semaphores
+		vk::Fence inFlight;
+
+		// Transient arenas of the frame (set once, see FrameRing::SetArenas).
+		// Each one hands out the region of this context, which is reused once
+		// the GPU finished its previous frame.
+		LinearAllocator* transient = nullptr;
+		UniformRing* uniforms = nullptr;
+
+		// Additional semaphores the submit waits for (e.g. async compute),
+		// only valid for the current frame. The values are used by timeline
+		// semaphores (ignored for binary semaphores).
+		std::vector<vk::Semaphore> waitSemaphores;
+		std::vector<vk::PipelineStageFlags> waitStages;
+		std::vector<uint64_t> waitValues;
+	};
+
+
+	// Ring of frame contexts.
+	// If the device supports timeline semaphores, the graphics queue signals
+	// one timeline semaphore with the number of each submitted frame, so the
+	// progress of the GPU is a single counter which can be polled or waited
+	// for (otherwise every context has a fence).
+	class FrameRing
+	{
+	public:
+		FrameRing(uint32_t framesInFlight);
+		~FrameRing();
+
+		void Create(uint32_t framesInFlight);
+		void Destroy();
+
+	public:
+		// Waits until the next context is free again and returns it
+		FrameContext& BeginFrame();
+		// Submits the command buffer of the context to the graphics queue
+		// (presentable frames wait for the acquired image and signal the semaphore)
+		void Submit(FrameContext& frame, vk::Semaphore renderFinished = nullptr);
+		// Moves on to the next context
+		void EndFrame();
+
+		// The arenas are created after the ring (they are sized by the frames in flight)
+		void SetArenas(LinearAllocator* transient, UniformRing* uniforms);
+
+		FrameContext& GetCurrent() { return m_frames[m_currentFrame]; }
+		uint32_t GetFramesInFlight() const { return static_cast<uint32_t>(m_frames.size()); }
+		// Number of the last started frame
+		uint64_t GetFrameNumber() const { return m_frameNumber; }
+		// Number of the last frame which is known to be finished by the GPU
+		// (polls the timeline semaphore or the fences of the submitted frames,
+		// frames which were never submitted do not count)
+		uint64_t GetCompletedFrame();
+		// Blocks until the GPU finished the frame (and all frames before)
+		void WaitForFrame(uint64_t number);
+		// Signaled with the frame number by the graphics queue (null without timeline semaphores)
+		vk::Semaphore GetTimeline() const { return m_vkTimeline; }
+
+		// Frames in flight from the config (clamped to 1...3)
+		static uint32_t QueryFramesInFlight();
+
+	// Internal helper
+	private:
+		void CreateCommandBuffers();
+		void CreateSyncObjects();
+
+	// Internal data
+	private:
+		static constexpr uint32_t MIN_FRAMES_IN_FLIGHT = 1;
+		static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 3;
+		static constexpr uint32_t DEFAULT_FRAMES_IN_FLIGHT = 2;
+
+		std::vector<FrameContext> m_frames;
+		vk::Semaphore m_vkTimeline;
+		uint32_t m_currentFrame = 0;
+		uint64_t m_frameNumber = 0;
+		uint64_t m_submittedFrame = 0;
+		uint64_t m_completedFrame = 0;
+	};
+
+
+} // namespace Helios::Vulkan
@@ -0,0 +1,292 @@
+#include "pch.h"
+#include "GPUCulling.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+
+#include "HeliosEngine/Renderer/CullingSystem.h"
+
+#include "HeliosEngine/Core/Assets.h"
+
+
+namespace Helios::Vulkan {
+
+
+	namespace {
+
+		struct CullPushConstants
+		{
+			glm::vec4 planes[6];
+			uint32_t objectCount;
+		};
+
+	}
+
+
+	GPUCulling::GPUCulling(uint32_t framesInFlight)
+	{
+		Create(framesInFlight);
+	}
+
+
+	GPUCulling::~GPUCulling()
+	{
+		Destroy();
+	}
+
+
+	void GPUCulling::Create(uint32_t framesInFlight)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Creating GPU culling objects...");
+
+		m_async = device->GetFeatures().asyncCompute;
+
+		m_setLayout = CreateScope<DescriptorSetLayout>(std::vector<vk::DescriptorSetLayoutBinding>{
+			DescriptorSetLayout::Binding(0, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute),
+			DescriptorSetLayout::Binding(1, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute),
+		});
+
+		vk::PushConstantRange pushConstantRange = vk::PushConstantRange();
+		{
+			pushConstantRange.stageFlags = vk::ShaderStageFlagBits::eCompute;
+			pushConstantRange.offset = 0;
+			pushConstantRange.size = sizeof(CullPushConstants);
+		}
+		vk::PipelineLayoutCreateInfo layoutInfo = vk::PipelineLayoutCreateInfo();
+		{
+			layoutInfo.setLayoutCount = 1;
+			layoutInfo.pSetLayouts = &m_setLayout->GetLayout();
+			layoutInfo.pushConstantRangeCount = 1;
+			layoutInfo.pPushConstantRanges = &pushConstantRange;
+		}
+		try {
+			LOG_RENDER_TRACE("Creating culling pipeline layout...");
+			m_vkPipelineLayout = device->GetLogicalDevice().createPipelineLayout(layoutInfo);
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to create pipeline layout!");
+		}
+		m_pipeline = CreateScope<ComputePipeline>("Shader/cull.comp.spv", m_vkPipelineLayout);
+
+		// The compute and the graphics queue both access the draw commands
+		const QueueFamilyIndices& indices = device->GetQueueFamilies();
+		std::vector<uint32_t> families = { indices.graphicsFamily.value() };
+		if (m_async and indices.computeFamily.value() != indices.graphicsFamily.value())
+			families.push_back(indices.computeFamily.value());
+
+		device->CreateBuffer(
+			sizeof(vk::DrawIndirectCommand) * MAX_OBJECTS * framesInFlight,
+			vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer,
+			vk::MemoryPropertyFlagBits::eDeviceLocal,
+			m_vkDrawBuffer, m_vkDrawMemory, families);
+
+		if (!m_async)
+			return;
+
+		vk::CommandBufferAllocateInfo allocInfo = vk::CommandBufferAllocateInfo();
+		{
+			allocInfo.level = vk::CommandBufferLevel::ePrimary;
+			allocInfo.commandPool = device->GetComputeCommandPool();
+			allocInfo.commandBufferCount = framesInFlight;
+		}
+		try {
+			LOG_RENDER_TRACE("Allocating compute command buffers...");
+			m_vkCommandBuffers = device->GetLogicalDevice().allocateCommandBuffers(allocInfo);
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to allocate command buffer!");
+		}
+
+		// One timeline for the compute queue, or a binary semaphore per frame
+		if (device->GetFeatures().timelineSemaphore)
+		{
+			m_vkTimeline = device->CreateTimelineSemaphore(0);
+			return;
+		}
+
+		m_vkSemaphores.resize(framesInFlight);
+		for (auto& semaphore : m_vkSemaphores)
+		{
+			try {
+				semaphore = device->GetLogicalDevice().createSemaphore(vk::SemaphoreCreateInfo());
+			}
+			catch (vk::SystemError err) {
+				LOG_RENDER_EXCEPT("Failed to create semaphore!");
+			}
+		}
+	}
+
+
+	void GPUCulling::Destroy()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Destroying GPU culling objects...");
+
+		for (auto semaphore : m_vkSemaphores)
+			device->GetLogicalDevice().destroySemaphore(semaphore);
+		m_vkSemaphores.clear();
+		if (m_vkTimeline)
+			device->GetLogicalDevice().destroySemaphore(m_vkTimeline);
+		m_vkTimeline = nullptr;
+		if (!m_vkCommandBuffers.empty())
+			device->GetLogicalDevice().freeCommandBuffers(device->GetComputeCommandPool(), m_vkCommandBuffers);
+		m_vkCommandBuffers.clear();
+
+		if (m_vkDrawBuffer)
+			device->GetLogicalDevice().destroyBuffer(m_vkDrawBuffer);
+		if (m_vkDrawMemory)
+			device->GetLogicalDevice().freeMemory(m_vkDrawMemory);
+
+		m_pipeline.reset();
+		if (m_vkPipelineLayout)
+			device->GetLogicalDevice().destroyPipelineLayout(m_vkPipelineLayout);
+		m_setLayout.reset();
+	}
+
+
+	void GPUCulling::Cull(FrameContext& frame, const glm::mat4& viewProjection, const std::vector<CullObject>& objects)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		uint32_t count = static_cast<uint32_t>(objects.size());
+		if (count > MAX_OBJECTS)
+		{
+			LOG_RENDER_WARN("Too many objects for GPU culling ({}), only {} are drawn!", count, MAX_OBJECTS);
+			count = MAX_OBJECTS;
+		}
+		// Written to the transient memory of the frame (at least one object, empty ranges are invalid)
+		LinearAllocation objectData = frame.transient->Allocate(sizeof(CullObject) * std::max(count, 1u));
+		memcpy(objectData.data, objects.data(), sizeof(CullObject) * count);
+
+		if (!m_async)
+		{
+			RecordDispatch(frame, frame.commandBuffer, viewProjection, objectData, count);
+
+			// Draw commands are read by the draws of the same command buffer
+			vk::BufferMemoryBarrier barrier = vk::BufferMemoryBarrier();
+			{
+				barrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
+				barrier.dstAccessMask = vk::AccessFlagBits::eIndirectCommandRead;
+				barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				barrier.buffer = m_vkDrawBuffer;
+				barrier.offset = sizeof(vk::DrawIndirectCommand) * MAX_OBJECTS * frame.index;
+				barrier.size = sizeof(vk::DrawIndirectCommand) * MAX_OBJECTS;
+			}
+			frame.commandBuffer.pipelineBarrier(
+				vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eDrawIndirect,
+				{}, nullptr, barrier, nullptr);
+			return;
+		}
+
+		// The command buffer is free again, its frame (which waited for it) is finished
+		vk::CommandBuffer commandBuffer = m_vkCommandBuffers[frame.index];
+		commandBuffer.reset();
+
+		vk::CommandBufferBeginInfo beginInfo = vk::CommandBufferBeginInfo();
+		{
+			beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+		}
+		try {
+			commandBuffer.begin(beginInfo);
+			RecordDispatch(frame, commandBuffer, viewProjection, objectData, count);
+			commandBuffer.end();
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to record compute command buffer!");
+		}
+
+		vk::Semaphore semaphore = m_vkTimeline ? m_vkTimeline : m_vkSemaphores[frame.index];
+		vk::TimelineSemaphoreSubmitInfoKHR timelineInfo = vk::TimelineSemaphoreSubmitInfoKHR();
+		{
+			timelineInfo.signalSemaphoreValueCount = 1;
+			timelineInfo.pSignalSemaphoreValues = &frame.number;
+		}
+		vk::SubmitInfo submitInfo = vk::SubmitInfo();
+		{
+			if (m_vkTimeline)
+				submitInfo.pNext = &timelineInfo;
+			submitInfo.commandBufferCount = 1;
+			submitInfo.pCommandBuffers = &commandBuffer;
+			submitInfo.signalSemaphoreCount = 1;
+			submitInfo.pSignalSemaphores = &semaphore;
+		}
+		try {
+			device->GetComputeQueue().submit(submitInfo);
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to submit compute command buffer!");
+		}
+
+		// The semaphore makes the draw commands visible to the graphics queue
+		frame.waitSemaphores.push_back(semaphore);
+		frame.waitStages.push_back(vk::PipelineStageFlagBits::eDrawIndirect);
+		frame.waitValues.push_back(frame.number);
+	}
+
+
+	void GPUCulling::DrawIndirect(FrameContext& frame, vk::CommandBuffer commandBuffer, uint32_t object)
+	{
+		// Beyond the commands of the frame
+		LOG_RENDER_ASSERT(object < MAX_OBJECTS, "Object is out of range of the GPU culling!");
+		if (object >= MAX_OBJECTS)
+			return;
+
+		vk::DeviceSize offset = sizeof(vk::DrawIndirectCommand) * (MAX_OBJECTS * frame.index + object);
+		commandBuffer.drawIndirect(m_vkDrawBuffer, offset, 1, sizeof(vk::DrawIndirectCommand));
+	}
+
+
+	bool GPUCulling::IsAvailable()
+	{
+		return Assets::Exist("Shader/cull.comp.spv", "RendererVulkan");
+	}
+
+
+	void GPUCulling::RecordDispatch(FrameContext& frame, vk::CommandBuffer commandBuffer, const glm::mat4& viewProjection, const LinearAllocation& objects, uint32_t count)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+		Scope<DescriptorAllocator>& descriptors = static_cast<VKRendererAPI*>(Renderer::Get())->GetDescriptors();
+
+		vk::DescriptorSet set = descriptors->Allocate(frame, m_setLayout->GetLayout());
+		std::array<vk::DescriptorBufferInfo, 2> bufferInfos = {
+			vk::DescriptorBufferInfo(objects.buffer, objects.offset, sizeof(CullObject) * std::max(count, 1u)),
+			vk::DescriptorBufferInfo(m_vkDrawBuffer, sizeof(vk::DrawIndirectCommand) * MAX_OBJECTS * frame.index, sizeof(vk::DrawIndirectCommand) * MAX_OBJECTS),
+		};
+		std::array<vk::WriteDescriptorSet, 2> writes;
+		for (uint32_t i = 0; i < writes.size(); i++)
+		{
+			writes[i] = vk::WriteDescriptorSet();
+			{
+				writes[i].dstSet = set;
+				writes[i].dstBinding = i;
+				writes[i].dstArrayElement = 0;
+				writes[i].descriptorCount = 1;
+				writes[i].descriptorType = vk::DescriptorType::eStorageBuffer;
+				writes[i].pBufferInfo = &bufferInfos[i];
+			}
+		}
+		device->GetLogicalDevice().updateDescriptorSets(writes, nullptr);
+
+		CullPushConstants push{};
+		ExtractFrustum(viewProjection, push.planes);
+		push.objectCount = count;
+
+		m_pipeline->Bind(commandBuffer);
+		commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_vkPipelineLayout, 0, set, nullptr);
+		commandBuffer.pushConstants(m_vkPipelineLayout, vk::ShaderStageFlagBits::eCompute, 0, sizeof(CullPushConstants), &push);
+		commandBuffer.dispatch((count + GROUP_SIZE - 1) / GROUP_SIZE, 1, 1);
+	}
+
+
+	void GPUCulling::ExtractFrustum(const glm::mat4& viewProjection, glm::vec4 planes[6])
+	{
+		// Same planes as the culling on the CPU
+		CullingSystem::ExtractFrustum(viewProjection, planes);
+	}
+
+
+} // namespace Helios::Vulkan
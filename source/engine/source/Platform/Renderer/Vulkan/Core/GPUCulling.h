@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "Platform/Renderer/Vulkan/Core/FrameRing.h"
+#include "Platform/Renderer/Vulkan/Core/LinearAllocator.h"
+#include "Platform/Renderer/Vulkan/Core/DescriptorSetLayout.h"
+#include "Platform/Renderer/Vulkan/Core/ComputePipeline.h"
+
+namespace Helios::Vulkan {
+
+
+	// Input of the culling shader (std430 layout)
+	struct CullObject
+	{
+		glm::mat4 transform{1.f};
+		// Bounding sphere in object space (xyz center, w radius)
+		glm::vec4 sphere{0.f};
+		uint32_t vertexCount = 0;
+		uint32_t firstVertex = 0;
+		uint32_t padding[2] = {};
+	};
+
+
+	// Frustum culling on the GPU.
+	// A compute shader tests the bounding sphere of every object and writes one
+	// indirect draw per object (without instances if it is culled).
+	// With an async compute queue the culling of a frame runs beside the
+	// graphics work of the previous frame, the graphics submit only waits for it
+	// at the draw indirect stage. Otherwise it is recorded in front of the frame.
+	class GPUCulling
+	{
+	public:
+		GPUCulling(uint32_t framesInFlight);
+		~GPUCulling();
+
+		void Create(uint32_t framesInFlight);
+		void Destroy();
+
+	public:
+		// Culls the objects against the frustum of the view projection matrix
+		// (before the command buffer of the frame records any draws)
+		void Cull(FrameContext& frame, const glm::mat4& viewProjection, const std::vector<CullObject>& objects);
+		// Draws the object with the command written by the culling
+		void DrawIndirect(FrameContext& frame, vk::CommandBuffer commandBuffer, uint32_t object);
+
+		bool IsAsync() const { return m_async; }
+		// Objects per frame, Cull drops the rest
+		static constexpr uint32_t MAX_OBJECTS = 4096;
+		// The shader is optional until all platforms ship it
+		static bool IsAvailable();
+		// Normalized planes (xyz normal, w distance) of the frustum, pointing inside
+		static void ExtractFrustum(const glm::mat4& viewProjection, glm::vec4 planes[6]);
+
+	// Getter for vulkan objects
+	public:
+		vk::Buffer& GetDrawBuffer() { return m_vkDrawBuffer; }
+
+	// Vulkan objects
+	private:
+		vk::PipelineLayout m_vkPipelineLayout;
+		// Draw commands of all frames in flight (the objects are transient data of the frame)
+		vk::Buffer m_vkDrawBuffer;
+		vk::DeviceMemory m_vkDrawMemory;
+		// Async compute only (one per frame in flight)
+		std::vector<vk::CommandBuffer> m_vkCommandBuffers;
+		std::vector<vk::Semaphore> m_vkSemaphores;
+		// Async compute with timeline semaphores (signaled with the frame number instead)
+		vk::Semaphore m_vkTimeline;
+
+	// Internal helper
+	private:
+		void RecordDispatch(FrameContext& frame, vk::CommandBuffer commandBuffer, const glm::mat4& viewProjection, const LinearAllocation& objects, uint32_t count);
+
+	// Internal data
+	private:
+		static constexpr uint32_t GROUP_SIZE = 64;
+
+		Scope<DescriptorSetLayout> m_setLayout;
+		Scope<ComputePipeline> m_pipeline;
+		bool m_async = false;
+	};
+
+
+} // namespace Helios::Vulkan
@@ -0,0 +1,182 @@
+#include "pch.h"
+#include "GPUProfiler.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+
+
+namespace Helios::Vulkan {
+
+
+	GPUProfiler::GPUProfiler(uint32_t framesInFlight)
+	{
+		Create(framesInFlight);
+	}
+
+
+	GPUProfiler::~GPUProfiler()
+	{
+		Destroy();
+	}
+
+
+	void GPUProfiler::Create(uint32_t framesInFlight)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Creating GPU profiler objects...");
+
+		// Check timestamp support of the graphics queue
+		const vk::PhysicalDeviceProperties& props = device->GetCaps().properties;
+		const std::vector<vk::QueueFamilyProperties>& families = device->GetCaps().queueFamilies;
+		uint32_t validBits = families[device->GetQueueFamilies().graphicsFamily.value()].timestampValidBits;
+
+		m_supported = validBits > 0 and props.limits.timestampPeriod > 0.0f;
+		if (!m_supported)
+		{
+			LOG_RENDER_WARN("GPU timestamps are not supported by the graphics queue!");
+			return;
+		}
+		m_timestampPeriod = props.limits.timestampPeriod;
+		m_timestampMask = (validBits >= 64) ? ~0ull : ((1ull << validBits) - 1);
+
+		vk::QueryPoolCreateInfo poolInfo = vk::QueryPoolCreateInfo();
+		{
+			poolInfo.queryType = vk::QueryType::eTimestamp;
+			poolInfo.queryCount = MAX_SCOPES * 2;
+		}
+
+		m_frames.resize(framesInFlight);
+		for (auto i = 0; i < m_frames.size(); i++)
+		{
+			try {
+				LOG_RENDER_TRACE("Creating timestamp query pool for frame #{}...", i);
+				m_frames[i].pool = device->GetLogicalDevice().createQueryPool(poolInfo);
+			}
+			catch (vk::SystemError err) {
+				LOG_RENDER_EXCEPT("Failed to create query pool!");
+			}
+		}
+	}
+
+
+	void GPUProfiler::Destroy()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Destroying GPU profiler objects...");
+
+		for (auto& frame : m_frames)
+		{
+			if (frame.pool)
+				device->GetLogicalDevice().destroyQueryPool(frame.pool);
+		}
+		m_frames.clear();
+		m_current = nullptr;
+	}
+
+
+	void GPUProfiler::BeginFrame(FrameContext& frame)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		if (!m_supported)
+			return;
+
+		FrameQueries& queries = m_frames[frame.index];
+
+		// The fence of the context is signaled, so the results are available
+		if (!queries.scopes.empty())
+		{
+			uint32_t count = static_cast<uint32_t>(queries.scopes.size()) * 2;
+			std::vector<uint64_t> data(count);
+			auto result = device->GetLogicalDevice().getQueryPoolResults(
+				queries.pool,
+				0, count,
+				data.size() * sizeof(uint64_t), data.data(),
+				sizeof(uint64_t),
+				vk::QueryResultFlagBits::e64);
+
+			if (result == vk::Result::eSuccess)
+			{
+				uint64_t first = data[queries.scopes[0].queryBegin] & m_timestampMask;
+				auto submit = std::chrono::duration<double, std::micro>(queries.submitTime.time_since_epoch());
+
+				m_results.clear();
+				m_frameTimeMs = 0.0f;
+				for (auto& scope : queries.scopes)
+				{
+					uint64_t begin = data[scope.queryBegin] & m_timestampMask;
+					uint64_t end = data[scope.queryEnd] & m_timestampMask;
+
+					GPUProfileResult entry;
+					entry.name = scope.name;
+					entry.depth = scope.depth;
+					entry.startMs = (begin > first) ? static_cast<float>((begin - first) * m_timestampPeriod * 1e-6) : 0.0f;
+					entry.durationMs = (end > begin) ? static_cast<float>((end - begin) * m_timestampPeriod * 1e-6) : 0.0f;
+					if (entry.depth == 0)
+						m_frameTimeMs += entry.durationMs;
+
+					// GPU and CPU clocks are not calibrated, so the GPU scopes
+					// are placed relative to the submit time of the frame
+					auto start = submit + std::chrono::duration<double, std::milli>(entry.startMs);
+					auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::duration<double, std::milli>(entry.durationMs));
+					HE_PROFILER_GPU_RESULT(entry.name, start, elapsed);
+
+					m_results.push_back(entry);
+				}
+				m_resultsFrame = queries.number;
+			}
+		}
+
+		queries.scopes.clear();
+		queries.number = frame.number;
+		frame.commandBuffer.resetQueryPool(queries.pool, 0, MAX_SCOPES * 2);
+
+		m_current = &queries;
+		m_depth = 0;
+	}
+
+
+	void GPUProfiler::EndFrame(FrameContext& frame)
+	{
+		if (!m_supported)
+			return;
+
+		m_frames[frame.index].submitTime = std::chrono::steady_clock::now();
+		m_current = nullptr;
+	}
+
+
+	uint32_t GPUProfiler::BeginScope(vk::CommandBuffer commandBuffer, const std::string& name)
+	{
+		if (!m_current)
+			return UINT32_MAX;
+		if (m_current->scopes.size() >= MAX_SCOPES)
+		{
+			// Scopes are meant for passes, not for single draws
+			if (!m_overflowLogged)
+				LOG_RENDER_WARN("GPU profiler: more than {} scopes in a frame, \"{}\" and later ones are not measured!", MAX_SCOPES, name);
+			m_overflowLogged = true;
+			return UINT32_MAX;
+		}
+
+		uint32_t index = static_cast<uint32_t>(m_current->scopes.size());
+		m_current->scopes.push_back({ name, m_depth++, index * 2, index * 2 + 1 });
+		commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, m_current->pool, index * 2);
+
+		return index;
+	}
+
+
+	void GPUProfiler::EndScope(vk::CommandBuffer commandBuffer, uint32_t scope)
+	{
+		if (!m_current or scope == UINT32_MAX)
+			return;
+
+		commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, m_current->pool, m_current->scopes[scope].queryEnd);
+		m_depth--;
+	}
+
+
+} // namespace Helios::Vulkan
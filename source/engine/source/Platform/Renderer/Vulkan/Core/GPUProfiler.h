@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "Platform/Renderer/Vulkan/Core/FrameRing.h"
+
+namespace Helios::Vulkan {
+
+
+	struct GPUProfileResult
+	{
+		std::string name;
+		uint32_t depth = 0;
+		// Start relative to the first scope of the frame
+		float startMs = 0.0f;
+		float durationMs = 0.0f;
+	};
+
+
+	// Measures GPU time of named scopes with timestamp queries.
+	// Every frame in flight has its own query pool, so results are read back
+	// when the context is used again (framesInFlight frames later) without
+	// waiting for the GPU.
+	class GPUProfiler
+	{
+	public:
+		GPUProfiler(uint32_t framesInFlight);
+		~GPUProfiler();
+
+		void Create(uint32_t framesInFlight);
+		void Destroy();
+
+	public:
+		// Reads the results of the last use of the context and resets its queries
+		// (has to be recorded at the beginning of the command buffer)
+		void BeginFrame(FrameContext& frame);
+		// Remembers the submit time to align GPU and CPU scopes in the trace
+		void EndFrame(FrameContext& frame);
+
+		uint32_t BeginScope(vk::CommandBuffer commandBuffer, const std::string& name);
+		void EndScope(vk::CommandBuffer commandBuffer, uint32_t scope);
+
+		bool IsSupported() const { return m_supported; }
+		// Results of the last read back frame
+		const std::vector<GPUProfileResult>& GetResults() const { return m_results; }
+		uint64_t GetResultsFrame() const { return m_resultsFrame; }
+		float GetFrameTime() const { return m_frameTimeMs; }
+
+	// Internal data
+	private:
+		static constexpr uint32_t MAX_SCOPES = 64;
+
+		struct TimedScope
+		{
+			std::string name;
+			uint32_t depth;
+			uint32_t queryBegin;
+			uint32_t queryEnd;
+		};
+
+		struct FrameQueries
+		{
+			vk::QueryPool pool;
+			std::vector<TimedScope> scopes;
+			uint64_t number = 0;
+			std::chrono::steady_clock::time_point submitTime;
+		};
+
+		std::vector<FrameQueries> m_frames;
+		FrameQueries* m_current = nullptr;
+		uint32_t m_depth = 0;
+		// Dropped scopes are only reported once
+		bool m_overflowLogged = false;
+
+		bool m_supported = false;
+		float m_timestampPeriod = 1.0f;
+		uint64_t m_timestampMask = ~0ull;
+
+		std::vector<GPUProfileResult> m_results;
+		uint64_t m_resultsFrame = 0;
+		float m_frameTimeMs = 0.0f;
+	};
+
+
+	// Measures the GPU time until the end of the current scope
+	class GPUProfileScope
+	{
+	public:
+		GPUProfileScope(GPUProfiler& profiler, vk::CommandBuffer commandBuffer, const std::string& name)
+			: m_profiler(profiler), m_commandBuffer(commandBuffer)
+		{
+			m_scope = m_profiler.BeginScope(m_commandBuffer, name);
+		}
+
+		~GPUProfileScope()
+		{
+			m_profiler.EndScope(m_commandBuffer, m_scope);
+		}
+
+	private:
+		GPUProfiler& m_profiler;
+		vk::CommandBuffer m_commandBuffer;
+		uint32_t m_scope;
+	};
+
+
+} // namespace Helios::Vulkan
@@ -61,6 +61,10 @@ namespace Helios::Vulkan {
 			VK_API_VERSION_MINOR(VK_HEADER_VERSION_COMPLETE),
 			VK_API_VERSION_PATCH(VK_HEADER_VERSION_COMPLETE));
 
+		// Vulkan 1.3 is used if available (e.g. dynamic rendering in core)
+		m_apiVersion = std::clamp(VK_MAKE_API_VERSION(0, VK_API_VERSION_MAJOR(vkVer), VK_API_VERSION_MINOR(vkVer), 0),
+			VK_API_VERSION_1_1, VK_API_VERSION_1_3);
+
 		// Setup AppInfo
 		vk::ApplicationInfo appInfo = vk::ApplicationInfo();
 		{
@@ -68,7 +72,7 @@ namespace Helios::Vulkan {
 			appInfo.applicationVersion = Application::Get().GetSpecification().Version;
 			appInfo.pEngineName = "HeliosEngine";
 			appInfo.engineVersion = HE_VERSION;
-			appInfo.apiVersion = VK_API_VERSION_1_1;
+			appInfo.apiVersion = m_apiVersion;
 		}
 
 		// Check layer support
@@ -109,7 +113,8 @@ namespace Helios::Vulkan {
 #		endif
 
 		// Create the surface
-		CreateSurface();
+		if (!Application::Get().IsHeadless())
+			CreateSurface();
 	}
 
 
@@ -143,11 +148,16 @@ namespace Helios::Vulkan {
 
 	std::vector<const char*> Instance::GetRequiredExtensions()
 	{
-		// Get required extensions for GLFW
-		uint32_t glfwExtCount = 0;
-		const char** glfwExt;
-		glfwExt = glfwGetRequiredInstanceExtensions(&glfwExtCount);
-		std::vector<const char*> extensions = std::vector<const char*>(glfwExt, glfwExt + glfwExtCount);
+		std::vector<const char*> extensions;
+
+		// Get required extensions for GLFW (not needed without a window)
+		if (!Application::Get().IsHeadless())
+		{
+			uint32_t glfwExtCount = 0;
+			const char** glfwExt;
+			glfwExt = glfwGetRequiredInstanceExtensions(&glfwExtCount);
+			extensions = std::vector<const char*>(glfwExt, glfwExt + glfwExtCount);
+		}
 
 		// Setup list of extensions
 #		ifdef BUILD_DEBUG
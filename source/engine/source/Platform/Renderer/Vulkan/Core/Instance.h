@@ -19,6 +19,10 @@ namespace Helios::Vulkan {
 	public:
 		vk::Instance& GetInstance() { return m_vkInstance; }
 		vk::SurfaceKHR& GetSurface() { return m_vkSurface; }
+		// Without a window (headless) there is no surface to present to
+		bool HasSurface() const { return static_cast<bool>(m_vkSurface); }
+		// Vulkan version the instance was created with
+		uint32_t GetApiVersion() const { return m_apiVersion; }
 
 	// Vulkan objects
 	private:
@@ -35,6 +39,10 @@ namespace Helios::Vulkan {
 		bool CheckSupportedExtensions();
 		void CreateDebugMessenger();
 		void CreateSurface();
+
+	// Internal data
+	private:
+		uint32_t m_apiVersion = VK_API_VERSION_1_1;
 	};
 
 
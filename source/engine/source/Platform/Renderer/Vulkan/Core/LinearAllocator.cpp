@@ -0,0 +1,93 @@
+#include "pch.h"
+#include "LinearAllocator.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+
+
+namespace Helios::Vulkan {
+
+
+	LinearAllocator::LinearAllocator(const std::string& name, uint32_t framesInFlight, vk::DeviceSize frameSize,
+		vk::BufferUsageFlags usage, vk::DeviceSize minAlignment, const std::vector<uint32_t>& queueFamilies)
+	{
+		Create(name, framesInFlight, frameSize, usage, minAlignment, queueFamilies);
+	}
+
+
+	LinearAllocator::~LinearAllocator()
+	{
+		Destroy();
+	}
+
+
+	void LinearAllocator::Create(const std::string& name, uint32_t framesInFlight, vk::DeviceSize frameSize,
+		vk::BufferUsageFlags usage, vk::DeviceSize minAlignment, const std::vector<uint32_t>& queueFamilies)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		m_name = name;
+		LOG_RENDER_TRACE("Creating linear allocator \"{}\" ({} KiB per frame)...", m_name, frameSize / 1024);
+
+		LOG_RENDER_ASSERT((minAlignment & (minAlignment - 1)) == 0, "Alignment must be a power of two!");
+		m_alignment = std::max(minAlignment, vk::DeviceSize(16));
+		m_frameSize = Align(frameSize);
+
+		device->CreateBuffer(
+			m_frameSize * framesInFlight,
+			usage,
+			vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+			m_vkBuffer, m_vkMemory, queueFamilies);
+
+		// Stays mapped for the lifetime of the buffer
+		m_mapped = static_cast<uint8_t*>(device->GetLogicalDevice().mapMemory(m_vkMemory, 0, VK_WHOLE_SIZE));
+	}
+
+
+	void LinearAllocator::Destroy()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Destroying linear allocator \"{}\"...", m_name);
+
+		if (m_mapped)
+			device->GetLogicalDevice().unmapMemory(m_vkMemory);
+		m_mapped = nullptr;
+
+		if (m_vkBuffer)
+			device->GetLogicalDevice().destroyBuffer(m_vkBuffer);
+		m_vkBuffer = nullptr;
+		if (m_vkMemory)
+			device->GetLogicalDevice().freeMemory(m_vkMemory);
+		m_vkMemory = nullptr;
+	}
+
+
+	void LinearAllocator::BeginFrame(FrameContext& frame)
+	{
+		m_frameBegin = m_frameSize * frame.index;
+		m_offset = m_frameBegin;
+	}
+
+
+	LinearAllocation LinearAllocator::Allocate(vk::DeviceSize size, vk::DeviceSize alignment)
+	{
+		// Regions start aligned, so aligning the offset is enough
+		vk::DeviceSize offset = Align(m_offset, alignment);
+		if (offset + size > m_frameBegin + m_frameSize)
+		{
+			LOG_RENDER_ERROR("Linear allocator \"{}\" can not fit {} bytes ({} of {} used)!", m_name, size, GetUsed(), m_frameSize);
+			LOG_RENDER_EXCEPT("Linear allocator is full!");
+		}
+
+		LinearAllocation alloc;
+		alloc.data = m_mapped + offset;
+		alloc.buffer = m_vkBuffer;
+		alloc.offset = offset;
+		m_offset = offset + size;
+
+		return alloc;
+	}
+
+
+} // namespace Helios::Vulkan
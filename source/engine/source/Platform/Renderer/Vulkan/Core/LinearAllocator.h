@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "Platform/Renderer/Vulkan/Core/FrameRing.h"
+
+namespace Helios::Vulkan {
+
+
+	struct LinearAllocation
+	{
+		// Mapped memory to write the data to
+		uint8_t* data = nullptr;
+		vk::Buffer buffer;
+		// Offset within the buffer
+		vk::DeviceSize offset = 0;
+	};
+
+
+	// Persistently mapped, host visible buffer for data which is written
+	// every frame (uniforms, instance data, dynamic vertices...).
+	// Every frame in flight owns a fixed region of the buffer, allocations
+	// only bump an offset within this region and the whole region is reused
+	// once the context is used again (the GPU finished its previous frame).
+	// Nothing is allocated, mapped or unmapped after creation.
+	class LinearAllocator
+	{
+	public:
+		// The buffer is shared between the queue families (if more than one)
+		LinearAllocator(const std::string& name, uint32_t framesInFlight, vk::DeviceSize frameSize,
+			vk::BufferUsageFlags usage, vk::DeviceSize minAlignment = 16, const std::vector<uint32_t>& queueFamilies = {});
+		~LinearAllocator();
+
+		void Create(const std::string& name, uint32_t framesInFlight, vk::DeviceSize frameSize,
+			vk::BufferUsageFlags usage, vk::DeviceSize minAlignment, const std::vector<uint32_t>& queueFamilies);
+		void Destroy();
+
+	public:
+		// Starts to allocate from the region of the context
+		void BeginFrame(FrameContext& frame);
+
+		// Alignment has to be a power of two (at least the minimum alignment is used)
+		LinearAllocation Allocate(vk::DeviceSize size, vk::DeviceSize alignment = 0);
+		template<typename T>
+		LinearAllocation Push(const T* data, size_t count = 1)
+		{
+			LinearAllocation alloc = Allocate(sizeof(T) * count);
+			std::memcpy(alloc.data, data, sizeof(T) * count);
+			return alloc;
+		}
+
+		vk::DeviceSize Align(vk::DeviceSize size, vk::DeviceSize alignment = 0) const
+		{
+			alignment = std::max(alignment, m_alignment);
+			return (size + alignment - 1) & ~(alignment - 1);
+		}
+
+		// Bytes used by the current frame
+		vk::DeviceSize GetUsed() const { return m_offset - m_frameBegin; }
+		vk::DeviceSize GetFrameSize() const { return m_frameSize; }
+
+	// Getter for vulkan objects
+	public:
+		vk::Buffer& GetBuffer() { return m_vkBuffer; }
+
+	// Vulkan objects
+	private:
+		vk::Buffer m_vkBuffer;
+		vk::DeviceMemory m_vkMemory;
+
+	// Internal data
+	private:
+		std::string m_name;
+		uint8_t* m_mapped = nullptr;
+		vk::DeviceSize m_alignment = 16;
+		vk::DeviceSize m_frameSize = 0;
+		vk::DeviceSize m_frameBegin = 0;
+		vk::DeviceSize m_offset = 0;
+	};
+
+
+} // namespace Helios::Vulkan
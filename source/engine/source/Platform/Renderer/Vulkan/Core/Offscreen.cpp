@@ -0,0 +1,100 @@
+#include "pch.h"
+#include "Offscreen.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+
+
+namespace Helios::Vulkan {
+
+
+	Offscreen::Offscreen(vk::Extent2D extent, uint32_t imageCount)
+	{
+		Create(extent, imageCount);
+	}
+
+
+	Offscreen::~Offscreen()
+	{
+		Destroy();
+	}
+
+
+	void Offscreen::Create(vk::Extent2D extent, uint32_t imageCount)
+	{
+		LOG_RENDER_TRACE("Creating offscreen objects ({}x{})...", extent.width, extent.height);
+
+		// The images are read back (captured) by copies after the render pass
+		m_finalLayout = vk::ImageLayout::eTransferSrcOptimal;
+		m_vkImageFormat = vk::Format::eR8G8B8A8Srgb;
+		m_vkExtent = extent;
+		m_imageUsage = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc;
+
+		CreateImages(imageCount);
+		CreateResources();
+	}
+
+
+	void Offscreen::Destroy()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Destroying offscreen objects...");
+
+		DestroyResources();
+
+		for (auto image : m_frameImages)
+			device->GetLogicalDevice().destroyImage(image);
+		m_frameImages.clear();
+
+		for (auto memory : m_frameImageMemory)
+			device->GetLogicalDevice().freeMemory(memory);
+		m_frameImageMemory.clear();
+	}
+
+
+	vk::Result Offscreen::AcquireNextImage(FrameContext& frame, uint32_t* imageIndex)
+	{
+		*imageIndex = frame.index % GetImageCount();
+		return vk::Result::eSuccess;
+	}
+
+
+	vk::Result Offscreen::Present(FrameContext& frame, uint32_t imageIndex)
+	{
+		// Nothing to present to
+		return vk::Result::eSuccess;
+	}
+
+
+	void Offscreen::CreateImages(uint32_t imageCount)
+	{
+		Scope<Device> &device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		vk::ImageCreateInfo imageInfo = vk::ImageCreateInfo();
+		{
+			imageInfo.imageType = vk::ImageType::e2D;
+			imageInfo.extent.width = m_vkExtent.width;
+			imageInfo.extent.height = m_vkExtent.height;
+			imageInfo.extent.depth = 1;
+			imageInfo.mipLevels = 1;
+			imageInfo.arrayLayers = 1;
+			imageInfo.format = m_vkImageFormat;
+			imageInfo.tiling = vk::ImageTiling::eOptimal;
+			imageInfo.initialLayout = vk::ImageLayout::eUndefined;
+			imageInfo.usage = m_imageUsage;
+			imageInfo.samples = vk::SampleCountFlagBits::e1;
+			imageInfo.sharingMode = vk::SharingMode::eExclusive;
+		}
+
+		m_frameImages.resize(imageCount);
+		m_frameImageMemory.resize(imageCount);
+		for (uint32_t i = 0; i < imageCount; i++)
+		{
+			LOG_RENDER_TRACE("Creating offscreen image for frame #{}...", i);
+			device->CreateImageWithMemory(imageInfo, vk::MemoryPropertyFlagBits::eDeviceLocal, m_frameImages[i], m_frameImageMemory[i]);
+		}
+	}
+
+
+} // namespace Helios::Vulkan
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "Platform/Renderer/Vulkan/Core/RenderTarget.h"
+
+namespace Helios::Vulkan {
+
+
+	// Render target without a surface (headless mode).
+	// There is one image per frame in flight, so the image of a context is
+	// free again as soon as the context is, and nothing has to be acquired.
+	class Offscreen : public RenderTarget
+	{
+	public:
+		Offscreen(vk::Extent2D extent, uint32_t imageCount);
+		~Offscreen();
+
+		void Create(vk::Extent2D extent, uint32_t imageCount);
+		void Destroy();
+
+	public:
+		vk::Result AcquireNextImage(FrameContext& frame, uint32_t *imageIndex) override;
+		vk::Result Present(FrameContext& frame, uint32_t imageIndex) override;
+
+	// Internal helper
+	private:
+		void CreateImages(uint32_t imageCount);
+
+	// Internal data
+	private:
+		std::vector<vk::DeviceMemory> m_frameImageMemory;
+	};
+
+
+} // namespace Helios::Vulkan
@@ -12,12 +12,24 @@
 namespace Helios::Vulkan {
 
 
+	// Id 0 is never handed out
+	uint32_t Pipeline::s_NextId = 1;
+
+
 	Pipeline::Pipeline(const std::string &vertShader, const std::string &fragShader, const PipelineConfigInfo &configInfo)
+		: m_id(s_NextId++)
 	{
 		Create(vertShader, fragShader, configInfo);
 	}
 
 
+	Pipeline::Pipeline(const std::string &taskShader, const std::string &meshShader, const std::string &fragShader, const PipelineConfigInfo &configInfo)
+		: m_id(s_NextId++)
+	{
+		Create(taskShader, meshShader, fragShader, configInfo);
+	}
+
+
 	Pipeline::~Pipeline()
 	{
 		Destroy();
@@ -26,8 +38,6 @@ namespace Helios::Vulkan {
 
 	void Pipeline::Create(const std::string &vertShader, const std::string &fragShader, const PipelineConfigInfo &configInfo)
 	{
-		Scope<Device> &device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
-
 		LOG_RENDER_TRACE("Creating pipeline objects...");
 
 		auto vertCode = Assets::Load(vertShader, "RendererVulkan");
@@ -35,7 +45,7 @@ namespace Helios::Vulkan {
 		m_vkVertShaderModule = CreateShaderModule(vertCode);
 		m_vkFragShaderModule = CreateShaderModule(fragCode);
 
-		vk::PipelineShaderStageCreateInfo shaderStages[2];
+		std::vector<vk::PipelineShaderStageCreateInfo> shaderStages(2);
 		shaderStages[0] = vk::PipelineShaderStageCreateInfo();
 		{
 			shaderStages[0].stage = vk::ShaderStageFlagBits::eVertex;
@@ -49,8 +59,9 @@ namespace Helios::Vulkan {
 			shaderStages[1].pName = "main";
 		}
 
-		auto bindingDescriptions = VKModel::Vertex::GetBindingDescriptions();
-		auto attributeDescriptions = VKModel::Vertex::GetAttributeDescriptions();
+		const VertexLayout& layout = configInfo.vertexLayout ? *configInfo.vertexLayout : VKModel::Vertex::GetLayout();
+		auto bindingDescriptions = layout.GetBindingDescriptions();
+		auto attributeDescriptions = layout.GetAttributeDescriptions();
 		vk::PipelineVertexInputStateCreateInfo vertexInputInfo = vk::PipelineVertexInputStateCreateInfo();
 		{
 			vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
@@ -59,12 +70,69 @@ namespace Helios::Vulkan {
 			vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
 		}
 
+		CreateGraphicsPipeline(shaderStages, &vertexInputInfo, configInfo);
+	}
+
+
+	void Pipeline::Create(const std::string &taskShader, const std::string &meshShader, const std::string &fragShader, const PipelineConfigInfo &configInfo)
+	{
+		LOG_RENDER_TRACE("Creating mesh shading pipeline objects...");
+
+		auto taskCode = Assets::Load(taskShader, "RendererVulkan");
+		auto meshCode = Assets::Load(meshShader, "RendererVulkan");
+		auto fragCode = Assets::Load(fragShader, "RendererVulkan");
+		m_vkTaskShaderModule = CreateShaderModule(taskCode);
+		m_vkMeshShaderModule = CreateShaderModule(meshCode);
+		m_vkFragShaderModule = CreateShaderModule(fragCode);
+
+		std::vector<vk::PipelineShaderStageCreateInfo> shaderStages(3);
+		shaderStages[0] = vk::PipelineShaderStageCreateInfo();
+		{
+			shaderStages[0].stage = vk::ShaderStageFlagBits::eTaskEXT;
+			shaderStages[0].module = m_vkTaskShaderModule;
+			shaderStages[0].pName = "main";
+		}
+		shaderStages[1] = vk::PipelineShaderStageCreateInfo();
+		{
+			shaderStages[1].stage = vk::ShaderStageFlagBits::eMeshEXT;
+			shaderStages[1].module = m_vkMeshShaderModule;
+			shaderStages[1].pName = "main";
+		}
+		shaderStages[2] = vk::PipelineShaderStageCreateInfo();
+		{
+			shaderStages[2].stage = vk::ShaderStageFlagBits::eFragment;
+			shaderStages[2].module = m_vkFragShaderModule;
+			shaderStages[2].pName = "main";
+		}
+
+		// Vertices are fetched by the mesh shader
+		CreateGraphicsPipeline(shaderStages, nullptr, configInfo);
+	}
+
+
+	void Pipeline::CreateGraphicsPipeline(const std::vector<vk::PipelineShaderStageCreateInfo> &shaderStages,
+		const vk::PipelineVertexInputStateCreateInfo *vertexInputInfo, const PipelineConfigInfo &configInfo)
+	{
+		Scope<Device> &device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		vk::PipelineRenderingCreateInfoKHR renderingInfo = vk::PipelineRenderingCreateInfoKHR();
+		{
+			renderingInfo.colorAttachmentCount = static_cast<uint32_t>(configInfo.colorFormats.size());
+			renderingInfo.pColorAttachmentFormats = configInfo.colorFormats.data();
+			renderingInfo.depthAttachmentFormat = configInfo.depthFormat;
+			renderingInfo.stencilAttachmentFormat = configInfo.stencilFormat;
+		}
+
 		vk::GraphicsPipelineCreateInfo pipelineInfo = vk::GraphicsPipelineCreateInfo();
 		{
-			pipelineInfo.stageCount = 2;
-			pipelineInfo.pStages = shaderStages;
-			pipelineInfo.pVertexInputState = &vertexInputInfo;
-			pipelineInfo.pInputAssemblyState = &configInfo.inputAssemblyInfo;
+			// Without a render pass the attachment formats are given instead
+			if (!configInfo.renderPass)
+				pipelineInfo.pNext = &renderingInfo;
+			pipelineInfo.stageCount = static_cast<uint32_t>(shaderStages.size());
+			pipelineInfo.pStages = shaderStages.data();
+			pipelineInfo.pVertexInputState = vertexInputInfo;
+			// Mesh shading pipelines have no input assembly
+			pipelineInfo.pInputAssemblyState = vertexInputInfo ? &configInfo.inputAssemblyInfo : nullptr;
 			pipelineInfo.pViewportState = &configInfo.viewportInfo;
 			pipelineInfo.pRasterizationState = &configInfo.rasterizationInfo;
 			pipelineInfo.pMultisampleState = &configInfo.multisampleInfo;
@@ -100,6 +168,10 @@ namespace Helios::Vulkan {
 			device->GetLogicalDevice().destroyShaderModule(m_vkVertShaderModule);
 		if (m_vkFragShaderModule)
 			device->GetLogicalDevice().destroyShaderModule(m_vkFragShaderModule);
+		if (m_vkTaskShaderModule)
+			device->GetLogicalDevice().destroyShaderModule(m_vkTaskShaderModule);
+		if (m_vkMeshShaderModule)
+			device->GetLogicalDevice().destroyShaderModule(m_vkMeshShaderModule);
 		if (m_vkGraphicsPipeline)
 			device->GetLogicalDevice().destroyPipeline(m_vkGraphicsPipeline);
 	}
@@ -113,8 +185,6 @@ namespace Helios::Vulkan {
 
 	void Pipeline::DefaultConfigInfo(PipelineConfigInfo &configInfo)
 	{
-		Ref<Swapchain> &swapchain = static_cast<VKRendererAPI*>(Renderer::Get())->GetSwapchain();
-
 //		PipelineConfigInfo configInfo;
 
 		configInfo.viewportInfo = vk::PipelineViewportStateCreateInfo();
@@ -5,6 +5,9 @@
 namespace Helios::Vulkan {
 
 
+	class VertexLayout;
+
+
 	struct PipelineConfigInfo {
 		PipelineConfigInfo() = default;
 		PipelineConfigInfo(const PipelineConfigInfo&) = delete;
@@ -24,8 +27,13 @@ namespace Helios::Vulkan {
 		vk::RenderPass renderPass = nullptr;
 		uint32_t subpass = 0;
 
-//		std::vector<VkVertexInputBindingDescription> bindingDescriptions{};
-//		std::vector<VkVertexInputAttributeDescription> attributeDescriptions{};
+		// Attachment formats (dynamic rendering, without a render pass)
+		std::vector<vk::Format> colorFormats;
+		vk::Format depthFormat = vk::Format::eUndefined;
+		vk::Format stencilFormat = vk::Format::eUndefined;
+
+		// Vertex input of the models drawn (nullptr: VKModel::Vertex::GetLayout())
+		const VertexLayout* vertexLayout = nullptr;
 	};
 
 
@@ -33,32 +41,43 @@ namespace Helios::Vulkan {
 	{
 	public:
 		Pipeline(const std::string &vertShader, const std::string &fragShader, const PipelineConfigInfo &configInfo);
+		// Mesh shading pipeline (without vertex input, needs the mesh shader feature)
+		Pipeline(const std::string &taskShader, const std::string &meshShader, const std::string &fragShader, const PipelineConfigInfo &configInfo);
 		~Pipeline();
 
 		void Create(const std::string &vertShader, const std::string &fragShader, const PipelineConfigInfo &configInfo);
+		void Create(const std::string &taskShader, const std::string &meshShader, const std::string &fragShader, const PipelineConfigInfo &configInfo);
 		void Destroy();
 
 	public:
 		void Bind(vk::CommandBuffer commandBuffer);
+		// Small id for sort keys and bind tracking (never reused)
+		uint32_t GetId() const { return m_id; }
 
 	// Getter for vulkan objects
 	public:
 		vk::Pipeline& GetGraphicsPipeline() { return m_vkGraphicsPipeline; }
 
 		static void DefaultConfigInfo(PipelineConfigInfo& confifInfo);
+		static vk::ShaderModule CreateShaderModule(const std::vector<char> &code);
 
 	// Vulkan objects
 	private:
 		vk::Pipeline m_vkGraphicsPipeline;
 		vk::ShaderModule m_vkVertShaderModule;
 		vk::ShaderModule m_vkFragShaderModule;
+		vk::ShaderModule m_vkTaskShaderModule;
+		vk::ShaderModule m_vkMeshShaderModule;
 
 	// Internal helper
 	private:
-		vk::ShaderModule CreateShaderModule(const std::vector<char> &code);
+		void CreateGraphicsPipeline(const std::vector<vk::PipelineShaderStageCreateInfo> &shaderStages,
+			const vk::PipelineVertexInputStateCreateInfo *vertexInputInfo, const PipelineConfigInfo &configInfo);
 
 	// Internal data
 	private:
+		uint32_t m_id;
+		static uint32_t s_NextId;
 	};
 
 
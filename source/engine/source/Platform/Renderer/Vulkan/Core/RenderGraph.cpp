@@ -0,0 +1,957 @@
+#include "pch.h"
+#include "RenderGraph.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+#include "Platform/Renderer/Vulkan/Core/Pipeline.h"
+
+
+namespace Helios::Vulkan {
+
+
+	namespace {
+
+		constexpr vk::AccessFlags WRITE_ACCESS =
+			vk::AccessFlagBits::eColorAttachmentWrite |
+			vk::AccessFlagBits::eDepthStencilAttachmentWrite |
+			vk::AccessFlagBits::eShaderWrite |
+			vk::AccessFlagBits::eTransferWrite;
+
+		vk::ImageUsageFlags GetUsage(RGAccess access)
+		{
+			switch (access)
+			{
+			case RGAccess::ColorAttachment:
+			case RGAccess::ResolveAttachment: return vk::ImageUsageFlagBits::eColorAttachment;
+			case RGAccess::DepthAttachment: return vk::ImageUsageFlagBits::eDepthStencilAttachment;
+			case RGAccess::Sampled:         return vk::ImageUsageFlagBits::eSampled;
+			case RGAccess::StorageRead:
+			case RGAccess::StorageWrite:    return vk::ImageUsageFlagBits::eStorage;
+			case RGAccess::TransferSrc:     return vk::ImageUsageFlagBits::eTransferSrc;
+			case RGAccess::TransferDst:     return vk::ImageUsageFlagBits::eTransferDst;
+			default:                        return {};
+			}
+		}
+
+	}
+
+
+	RenderGraph::RenderGraph()
+	{
+	}
+
+
+	RenderGraph::~RenderGraph()
+	{
+		Destroy();
+	}
+
+
+	void RenderGraph::Destroy()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		for (auto& pass : m_passes)
+		{
+			for (auto framebuffer : pass.framebuffers)
+				device->GetLogicalDevice().destroyFramebuffer(framebuffer);
+			pass.framebuffers.clear();
+			if (pass.renderPass)
+				device->GetLogicalDevice().destroyRenderPass(pass.renderPass);
+			pass.renderPass = nullptr;
+		}
+
+		for (auto view : m_vkImageViews)
+			if (view)
+				device->GetLogicalDevice().destroyImageView(view);
+		m_vkImageViews.clear();
+		for (auto image : m_vkImages)
+			if (image)
+				device->GetLogicalDevice().destroyImage(image);
+		m_vkImages.clear();
+
+		for (auto& block : m_blocks)
+			if (block.memory)
+				device->GetLogicalDevice().freeMemory(block.memory);
+		m_blocks.clear();
+
+		m_compiled = false;
+	}
+
+
+	RGResource RenderGraph::ImportImage(const std::string& name, const std::vector<vk::Image>& images, const std::vector<vk::ImageView>& views,
+		vk::Format format, vk::Extent2D extent, vk::ImageLayout finalLayout)
+	{
+		Resource resource;
+		resource.name = name;
+		resource.desc.format = format;
+		resource.desc.extent = extent;
+		resource.imported = true;
+		resource.images = images;
+		resource.views = views;
+		resource.finalLayout = finalLayout;
+		m_resources.push_back(resource);
+
+		return static_cast<RGResource>(m_resources.size() - 1);
+	}
+
+
+	RGResource RenderGraph::CreateImage(const std::string& name, const RGImageDesc& desc)
+	{
+		Resource resource;
+		resource.name = name;
+		resource.desc = desc;
+		m_resources.push_back(resource);
+
+		return static_cast<RGResource>(m_resources.size() - 1);
+	}
+
+
+	RGPass RenderGraph::AddPass(const std::string& name, RGPassType type, ExecuteFunction execute)
+	{
+		Pass pass;
+		pass.name = name;
+		pass.type = type;
+		pass.execute = std::move(execute);
+		m_passes.push_back(std::move(pass));
+
+		return static_cast<RGPass>(m_passes.size() - 1);
+	}
+
+
+	void RenderGraph::AddColorAttachment(RGPass pass, RGResource resource, vk::AttachmentLoadOp loadOp, vk::ClearColorValue clear)
+	{
+		Use use{ resource, RGAccess::ColorAttachment, true, loadOp };
+		use.clear.color = clear;
+		m_passes[pass].uses.push_back(use);
+	}
+
+
+	void RenderGraph::SetDepthAttachment(RGPass pass, RGResource resource, vk::AttachmentLoadOp loadOp, vk::ClearDepthStencilValue clear)
+	{
+		Use use{ resource, RGAccess::DepthAttachment, true, loadOp };
+		use.clear.depthStencil = clear;
+		m_passes[pass].uses.push_back(use);
+	}
+
+
+	void RenderGraph::AddResolveAttachment(RGPass pass, RGResource source, RGResource target)
+	{
+		Use use{ target, RGAccess::ResolveAttachment, true, vk::AttachmentLoadOp::eDontCare };
+		use.source = source;
+		m_passes[pass].uses.push_back(use);
+	}
+
+
+	void RenderGraph::AddRead(RGPass pass, RGResource resource, RGAccess access)
+	{
+		m_passes[pass].uses.push_back({ resource, access, false, vk::AttachmentLoadOp::eLoad });
+	}
+
+
+	void RenderGraph::AddWrite(RGPass pass, RGResource resource, RGAccess access)
+	{
+		m_passes[pass].uses.push_back({ resource, access, true, vk::AttachmentLoadOp::eDontCare });
+	}
+
+
+	void RenderGraph::SetSideEffect(RGPass pass)
+	{
+		m_passes[pass].sideEffect = true;
+	}
+
+
+	void RenderGraph::Compile()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Compiling render graph ({} passes, {} resources)...", m_passes.size(), m_resources.size());
+
+		m_dynamicRendering = device->GetFeatures().dynamicRendering;
+
+		CullPasses();
+		CreateTransientImages();
+		ComputeBarriers();
+		for (RGPass pass = 0; pass < m_passes.size(); pass++)
+		{
+			if (m_passes[pass].culled or m_passes[pass].type != RGPassType::Graphics)
+				continue;
+
+			SetupAttachments(pass);
+			if (!m_dynamicRendering)
+				CreateRenderPass(pass);
+		}
+
+		m_compiled = true;
+	}
+
+
+	void RenderGraph::Execute(FrameContext& frame, uint32_t imageIndex)
+	{
+		Scope<GPUProfiler>& profiler = static_cast<VKRendererAPI*>(Renderer::Get())->GetGPUProfiler();
+		vk::CommandBuffer commandBuffer = frame.commandBuffer;
+
+		for (auto& pass : m_passes)
+		{
+			if (pass.culled)
+				continue;
+
+			GPUProfileScope passScope(*profiler, commandBuffer, pass.name);
+			RecordBarriers(commandBuffer, pass.barriers, pass.srcStages, pass.dstStages, imageIndex);
+
+			if (pass.type != RGPassType::Graphics)
+			{
+				pass.execute(frame, commandBuffer);
+				continue;
+			}
+
+			BeginRendering(commandBuffer, pass, imageIndex);
+
+			vk::Viewport viewport = vk::Viewport();
+			{
+				viewport.x = 0.0f;
+				viewport.y = 0.0f;
+				viewport.width = static_cast<float>(pass.extent.width);
+				viewport.height = static_cast<float>(pass.extent.height);
+				viewport.minDepth = 0.0f;
+				viewport.maxDepth = 1.0f;
+			}
+			vk::Rect2D scissor({ 0, 0 }, pass.extent);
+			commandBuffer.setViewport(0, 1, &viewport);
+			commandBuffer.setScissor(0, 1, &scissor);
+
+			pass.execute(frame, commandBuffer);
+
+			if (m_dynamicRendering)
+				static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice()->CmdEndRendering(commandBuffer);
+			else
+				commandBuffer.endRenderPass();
+		}
+
+		RecordBarriers(commandBuffer, m_finalBarriers, m_finalSrcStages, vk::PipelineStageFlagBits::eBottomOfPipe, imageIndex);
+	}
+
+
+	void RenderGraph::SetupPipelineConfig(RGPass id, PipelineConfigInfo& configInfo) const
+	{
+		const Pass& pass = m_passes[id];
+
+		// All attachments of a subpass have the same number of samples
+		if (!pass.attachments.empty())
+			configInfo.multisampleInfo.rasterizationSamples = m_resources[pass.attachments[0].resource].desc.samples;
+
+		if (!m_dynamicRendering)
+		{
+			configInfo.renderPass = pass.renderPass;
+			return;
+		}
+
+		configInfo.renderPass = nullptr;
+		configInfo.colorFormats.clear();
+		for (const auto& attachment : pass.attachments)
+		{
+			vk::Format format = m_resources[attachment.resource].desc.format;
+			if (!attachment.depth)
+				configInfo.colorFormats.push_back(format);
+			else
+			{
+				configInfo.depthFormat = format;
+				if (GetAspect(format) & vk::ImageAspectFlagBits::eStencil)
+					configInfo.stencilFormat = format;
+			}
+		}
+	}
+
+
+	vk::Image RenderGraph::GetImage(RGResource resource, uint32_t imageIndex) const
+	{
+		const Resource& res = m_resources[resource];
+		if (res.imported)
+			return res.images[imageIndex % res.images.size()];
+		return m_vkImages[resource];
+	}
+
+
+	vk::ImageView RenderGraph::GetImageView(RGResource resource, uint32_t imageIndex) const
+	{
+		const Resource& res = m_resources[resource];
+		if (res.imported)
+			return res.views[imageIndex % res.views.size()];
+		return m_vkImageViews[resource];
+	}
+
+
+	void RenderGraph::CullPasses()
+	{
+		// Imported images are the outputs of the graph
+		std::vector<bool> needed(m_resources.size(), false);
+		for (RGResource resource = 0; resource < m_resources.size(); resource++)
+			needed[resource] = m_resources[resource].imported;
+
+		for (size_t i = m_passes.size(); i-- > 0;)
+		{
+			Pass& pass = m_passes[i];
+
+			bool alive = pass.sideEffect;
+			for (const auto& use : pass.uses)
+				alive |= use.write and needed[use.resource];
+
+			pass.culled = !alive;
+			if (pass.culled)
+			{
+				LOG_RENDER_DEBUG("Render graph: culling pass \"{}\" (unused results)", pass.name);
+				continue;
+			}
+
+			// Everything the pass reads (or loads) has to be produced before
+			for (const auto& use : pass.uses)
+				if (!use.write or use.loadOp == vk::AttachmentLoadOp::eLoad)
+					needed[use.resource] = true;
+		}
+	}
+
+
+	void RenderGraph::CreateTransientImages()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		// Lifetimes and usage of the images
+		for (uint32_t i = 0; i < m_passes.size(); i++)
+		{
+			if (m_passes[i].culled)
+				continue;
+			for (const auto& use : m_passes[i].uses)
+			{
+				Resource& resource = m_resources[use.resource];
+				resource.usage |= GetUsage(use.access);
+				resource.firstPass = std::min(resource.firstPass, i);
+				resource.lastPass = std::max(resource.lastPass, i);
+			}
+		}
+
+		// Attachments which are never loaded or stored do not need real memory
+		// on tile based GPUs (the contents only live within the pass)
+		constexpr vk::ImageUsageFlags ATTACHMENT_USAGE =
+			vk::ImageUsageFlagBits::eColorAttachment |
+			vk::ImageUsageFlagBits::eDepthStencilAttachment;
+		for (auto& resource : m_resources)
+			resource.lazy = !resource.imported and resource.firstPass == resource.lastPass and !(resource.usage & ~ATTACHMENT_USAGE);
+		for (const auto& pass : m_passes)
+		{
+			if (pass.culled)
+				continue;
+			for (const auto& use : pass.uses)
+			{
+				if (use.loadOp == vk::AttachmentLoadOp::eLoad)
+					m_resources[use.resource].lazy = false;
+			}
+		}
+
+		m_vkImages.resize(m_resources.size());
+		m_vkImageViews.resize(m_resources.size());
+
+		std::vector<std::pair<RGResource, vk::MemoryRequirements>> requirements;
+		for (RGResource id = 0; id < m_resources.size(); id++)
+		{
+			Resource& resource = m_resources[id];
+			if (resource.imported or resource.firstPass == UINT32_MAX)
+				continue;
+
+			vk::ImageCreateInfo imageInfo = vk::ImageCreateInfo();
+			{
+				imageInfo.imageType = vk::ImageType::e2D;
+				imageInfo.extent.width = resource.desc.extent.width;
+				imageInfo.extent.height = resource.desc.extent.height;
+				imageInfo.extent.depth = 1;
+				imageInfo.mipLevels = 1;
+				imageInfo.arrayLayers = 1;
+				imageInfo.format = resource.desc.format;
+				imageInfo.tiling = vk::ImageTiling::eOptimal;
+				imageInfo.initialLayout = vk::ImageLayout::eUndefined;
+				imageInfo.usage = resource.usage;
+				if (resource.lazy)
+					imageInfo.usage |= vk::ImageUsageFlagBits::eTransientAttachment;
+				imageInfo.samples = resource.desc.samples;
+				imageInfo.sharingMode = vk::SharingMode::eExclusive;
+			}
+			try {
+				LOG_RENDER_TRACE("Creating transient image \"{}\"...", resource.name);
+				m_vkImages[id] = device->GetLogicalDevice().createImage(imageInfo);
+			}
+			catch (vk::SystemError err) {
+				LOG_RENDER_EXCEPT("Failed to create image!");
+			}
+			requirements.push_back({ id, device->GetLogicalDevice().getImageMemoryRequirements(m_vkImages[id]) });
+		}
+
+		// Greedy assignment (largest first) to blocks without overlapping lifetimes
+		std::sort(requirements.begin(), requirements.end(), [](const auto& a, const auto& b) {
+			return a.second.size > b.second.size;
+		});
+
+		vk::DeviceSize unaliased = 0;
+		for (const auto& [id, req] : requirements)
+		{
+			Resource& resource = m_resources[id];
+			unaliased += req.size;
+
+			for (uint32_t b = 0; b < m_blocks.size() and resource.block == UINT32_MAX; b++)
+			{
+				MemoryBlock& block = m_blocks[b];
+				if ((block.memoryTypeBits & req.memoryTypeBits) == 0 or block.lazy != resource.lazy)
+					continue;
+
+				bool overlaps = false;
+				for (RGResource other : block.resources)
+				{
+					const Resource& o = m_resources[other];
+					overlaps |= !(o.lastPass < resource.firstPass or resource.lastPass < o.firstPass);
+				}
+				if (!overlaps)
+					resource.block = b;
+			}
+
+			if (resource.block == UINT32_MAX)
+			{
+				resource.block = static_cast<uint32_t>(m_blocks.size());
+				m_blocks.emplace_back();
+				m_blocks.back().lazy = resource.lazy;
+			}
+
+			MemoryBlock& block = m_blocks[resource.block];
+			block.size = std::max(block.size, req.size);
+			block.memoryTypeBits &= req.memoryTypeBits;
+			block.resources.push_back(id);
+		}
+
+		// Allocate the blocks, every image starts at the beginning of its block
+		vk::DeviceSize total = 0;
+		vk::DeviceSize lazy = 0;
+		for (auto& block : m_blocks)
+		{
+			std::optional<uint32_t> memoryType;
+			if (block.lazy)
+				memoryType = device->FindMemoryType(block.memoryTypeBits,
+					vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eLazilyAllocated);
+			if (memoryType.has_value())
+				lazy += block.size;
+			else
+				memoryType = device->QueryMemoryType(block.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal);
+
+			vk::MemoryAllocateInfo allocInfo = vk::MemoryAllocateInfo();
+			{
+				allocInfo.allocationSize = block.size;
+				allocInfo.memoryTypeIndex = memoryType.value();
+			}
+			try {
+				block.memory = device->GetLogicalDevice().allocateMemory(allocInfo);
+			}
+			catch (vk::SystemError err) {
+				LOG_RENDER_EXCEPT("Failed to allocate transient memory!");
+			}
+			total += block.size;
+
+			for (RGResource id : block.resources)
+			{
+				device->GetLogicalDevice().bindImageMemory(m_vkImages[id], block.memory, 0);
+
+				vk::ImageViewCreateInfo viewInfo = vk::ImageViewCreateInfo();
+				{
+					viewInfo.image = m_vkImages[id];
+					viewInfo.viewType = vk::ImageViewType::e2D;
+					viewInfo.format = m_resources[id].desc.format;
+					viewInfo.subresourceRange.aspectMask = GetAspect(m_resources[id].desc.format);
+					viewInfo.subresourceRange.baseMipLevel = 0;
+					viewInfo.subresourceRange.levelCount = 1;
+					viewInfo.subresourceRange.baseArrayLayer = 0;
+					viewInfo.subresourceRange.layerCount = 1;
+				}
+				try {
+					m_vkImageViews[id] = device->GetLogicalDevice().createImageView(viewInfo);
+				}
+				catch (vk::SystemError err) {
+					LOG_RENDER_EXCEPT("Failed to create image view!");
+				}
+			}
+		}
+
+		if (!requirements.empty())
+			LOG_RENDER_DEBUG("Render graph: {} transient images in {} blocks, {} KiB ({} KiB without aliasing, {} KiB lazily allocated)",
+				requirements.size(), m_blocks.size(), total / 1024, unaliased / 1024, lazy / 1024);
+	}
+
+
+	void RenderGraph::ComputeBarriers()
+	{
+		struct State
+		{
+			bool touched = false;
+			vk::ImageLayout layout = vk::ImageLayout::eUndefined;
+			// Last write which is not visible yet, and the stages to wait for
+			vk::AccessFlags writeAccess;
+			vk::PipelineStageFlags writeStages;
+			vk::PipelineStageFlags readStages;
+		};
+		std::vector<State> states(m_resources.size());
+
+		// Everything a resource does within a frame, the next frame has to wait for
+		// it (transient images are shared by all frames in flight)
+		std::vector<vk::PipelineStageFlags> frameStages(m_resources.size());
+		std::vector<vk::AccessFlags> frameWrites(m_resources.size());
+		for (const auto& pass : m_passes)
+		{
+			if (pass.culled)
+				continue;
+			for (const auto& use : pass.uses)
+			{
+				vk::ImageLayout layout;
+				vk::AccessFlags access;
+				vk::PipelineStageFlags stages;
+				GetAccessInfo(use.access, pass.type, true, layout, access, stages);
+
+				const Resource& resource = m_resources[use.resource];
+				std::vector<RGResource> shared = { use.resource };
+				if (!resource.imported)
+					shared = m_blocks[resource.block].resources;
+				for (RGResource id : shared)
+				{
+					frameStages[id] |= stages;
+					frameWrites[id] |= access & WRITE_ACCESS;
+				}
+			}
+		}
+
+		for (uint32_t i = 0; i < m_passes.size(); i++)
+		{
+			Pass& pass = m_passes[i];
+			pass.barriers.clear();
+			pass.srcStages = {};
+			pass.dstStages = {};
+			if (pass.culled)
+				continue;
+
+			for (const auto& use : pass.uses)
+			{
+				bool load = !use.write or use.loadOp == vk::AttachmentLoadOp::eLoad;
+
+				vk::ImageLayout layout;
+				vk::AccessFlags access;
+				vk::PipelineStageFlags stages;
+				GetAccessInfo(use.access, pass.type, load, layout, access, stages);
+
+				Resource& resource = m_resources[use.resource];
+				State& state = states[use.resource];
+				bool first = !state.touched;
+				if (first)
+				{
+					state.touched = true;
+					state.writeAccess = frameWrites[use.resource];
+					state.writeStages = frameStages[use.resource];
+
+					if (resource.imported)
+					{
+						// Contents of the last frame are only kept if they are needed
+						state.layout = load ? resource.finalLayout : vk::ImageLayout::eUndefined;
+						// Swapchain images are acquired at this stage, and the images
+						// might have been read by a copy after the graph (frame capture)
+						state.writeStages |= vk::PipelineStageFlagBits::eColorAttachmentOutput | vk::PipelineStageFlagBits::eTransfer;
+					}
+					else
+					{
+						if (load)
+							LOG_RENDER_WARN("Render graph: \"{}\" is read before it is written!", resource.name);
+						state.layout = vk::ImageLayout::eUndefined;
+
+						// The memory was used by the previous image of the block in this frame
+						const Resource* previous = nullptr;
+						for (RGResource other : m_blocks[resource.block].resources)
+						{
+							const Resource& o = m_resources[other];
+							if (o.lastPass < resource.firstPass and (!previous or o.lastPass > previous->lastPass))
+								previous = &o;
+						}
+						if (previous)
+						{
+							const State& prev = states[previous - m_resources.data()];
+							state.writeAccess = prev.writeAccess;
+							state.writeStages = prev.writeStages | prev.readStages;
+						}
+					}
+				}
+
+				bool hazard =
+					state.layout != layout or
+					state.writeAccess or
+					(use.write and state.readStages);
+				if (!first and !hazard)
+				{
+					// Read after read in the same layout
+					state.readStages |= stages;
+					continue;
+				}
+
+				pass.barriers.push_back({ use.resource, state.layout, layout, state.writeAccess, access });
+				pass.srcStages |= state.writeStages | state.readStages;
+				pass.dstStages |= stages;
+
+				state.layout = layout;
+				if (use.write)
+				{
+					state.writeAccess = access & WRITE_ACCESS;
+					state.writeStages = stages;
+					state.readStages = {};
+				}
+				else
+				{
+					state.writeAccess = {};
+					state.writeStages = {};
+					state.readStages = stages;
+				}
+			}
+
+			if (!pass.srcStages)
+				pass.srcStages = vk::PipelineStageFlagBits::eTopOfPipe;
+		}
+
+		// Hand the imported images over in their final layout
+		m_finalBarriers.clear();
+		m_finalSrcStages = vk::PipelineStageFlagBits::eTopOfPipe;
+		for (RGResource id = 0; id < m_resources.size(); id++)
+		{
+			const Resource& resource = m_resources[id];
+			const State& state = states[id];
+			if (!resource.imported or !state.touched or state.layout == resource.finalLayout)
+				continue;
+
+			m_finalBarriers.push_back({ id, state.layout, resource.finalLayout, state.writeAccess, {} });
+			m_finalSrcStages |= state.writeStages | state.readStages;
+		}
+	}
+
+
+	void RenderGraph::SetupAttachments(RGPass id)
+	{
+		Pass& pass = m_passes[id];
+		pass.attachments.clear();
+
+		for (const auto& use : pass.uses)
+		{
+			if (use.access == RGAccess::ResolveAttachment)
+			{
+				auto source = std::find_if(pass.attachments.begin(), pass.attachments.end(),
+					[&](const Attachment& a) { return a.resource == use.source; });
+				if (source == pass.attachments.end())
+				{
+					LOG_RENDER_ERROR("Render graph: resolve source of \"{}\" is no color attachment!", m_resources[use.resource].name);
+					LOG_RENDER_EXCEPT("Render graph: resolve source is no color attachment!");
+				}
+				source->resolve = use.resource;
+				continue;
+			}
+			if (use.access != RGAccess::ColorAttachment and use.access != RGAccess::DepthAttachment)
+				continue;
+
+			const Resource& resource = m_resources[use.resource];
+			// Transient images which are not used afterwards never leave the tile memory
+			bool store = resource.imported or resource.lastPass > id;
+
+			Attachment attachment;
+			attachment.resource = use.resource;
+			attachment.depth = use.access == RGAccess::DepthAttachment;
+			attachment.loadOp = use.loadOp;
+			attachment.storeOp = store ? vk::AttachmentStoreOp::eStore : vk::AttachmentStoreOp::eDontCare;
+			attachment.clear = use.clear;
+			pass.attachments.push_back(attachment);
+		}
+
+		pass.extent = pass.attachments.empty() ? vk::Extent2D{ 1, 1 } : m_resources[pass.attachments[0].resource].desc.extent;
+	}
+
+
+	void RenderGraph::CreateRenderPass(RGPass id)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		Pass& pass = m_passes[id];
+
+		// The graph transitions the attachments, so the layouts stay the same
+		std::vector<vk::AttachmentDescription> attachments;
+		std::vector<vk::AttachmentReference> colorRefs;
+		std::vector<vk::AttachmentReference> resolveRefs;
+		std::optional<vk::AttachmentReference> depthRef;
+		std::vector<RGResource> resources;
+		pass.clearValues.clear();
+
+		auto addAttachment = [&](RGResource resource, vk::ImageLayout layout,
+			vk::AttachmentLoadOp loadOp, vk::AttachmentStoreOp storeOp, bool stencil, vk::ClearValue clear)
+		{
+			vk::AttachmentDescription description = vk::AttachmentDescription();
+			{
+				description.format = m_resources[resource].desc.format;
+				description.samples = m_resources[resource].desc.samples;
+				description.loadOp = loadOp;
+				description.storeOp = storeOp;
+				description.stencilLoadOp = stencil ? loadOp : vk::AttachmentLoadOp::eDontCare;
+				description.stencilStoreOp = stencil ? storeOp : vk::AttachmentStoreOp::eDontCare;
+				description.initialLayout = layout;
+				description.finalLayout = layout;
+			}
+			attachments.push_back(description);
+			resources.push_back(resource);
+			pass.clearValues.push_back(clear);
+			return vk::AttachmentReference(static_cast<uint32_t>(attachments.size() - 1), layout);
+		};
+
+		for (const auto& attachment : pass.attachments)
+		{
+			vk::ImageLayout layout = attachment.depth ? vk::ImageLayout::eDepthStencilAttachmentOptimal : vk::ImageLayout::eColorAttachmentOptimal;
+			vk::AttachmentReference ref = addAttachment(attachment.resource, layout,
+				attachment.loadOp, attachment.storeOp, attachment.depth, attachment.clear);
+
+			if (attachment.depth)
+			{
+				depthRef = ref;
+				continue;
+			}
+			colorRefs.push_back(ref);
+
+			// Resolved at the end of the subpass
+			if (attachment.resolve == UINT32_MAX)
+				resolveRefs.push_back(vk::AttachmentReference(VK_ATTACHMENT_UNUSED, vk::ImageLayout::eUndefined));
+			else
+				resolveRefs.push_back(addAttachment(attachment.resolve, layout,
+					vk::AttachmentLoadOp::eDontCare, vk::AttachmentStoreOp::eStore, false, {}));
+		}
+		bool resolve = std::any_of(pass.attachments.begin(), pass.attachments.end(),
+			[](const Attachment& a) { return a.resolve != UINT32_MAX; });
+
+		vk::SubpassDescription subpass = vk::SubpassDescription();
+		{
+			subpass.pipelineBindPoint = vk::PipelineBindPoint::eGraphics;
+			subpass.colorAttachmentCount = static_cast<uint32_t>(colorRefs.size());
+			subpass.pColorAttachments = colorRefs.data();
+			subpass.pResolveAttachments = resolve ? resolveRefs.data() : nullptr;
+			subpass.pDepthStencilAttachment = depthRef ? &depthRef.value() : nullptr;
+		}
+		vk::RenderPassCreateInfo renderPassInfo = vk::RenderPassCreateInfo();
+		{
+			renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+			renderPassInfo.pAttachments = attachments.data();
+			renderPassInfo.subpassCount = 1;
+			renderPassInfo.pSubpasses = &subpass;
+		}
+
+		try {
+			LOG_RENDER_TRACE("Creating render pass \"{}\"...", pass.name);
+			pass.renderPass = device->GetLogicalDevice().createRenderPass(renderPassInfo);
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to create render pass!");
+		}
+
+		// One framebuffer per image of the imported attachments
+		size_t count = 1;
+		for (RGResource resource : resources)
+		{
+			if (m_resources[resource].imported)
+				count = std::max(count, m_resources[resource].views.size());
+		}
+
+		pass.framebuffers.resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			std::vector<vk::ImageView> views;
+			for (RGResource resource : resources)
+				views.push_back(GetImageView(resource, static_cast<uint32_t>(i)));
+
+			vk::FramebufferCreateInfo bufferInfo = vk::FramebufferCreateInfo();
+			{
+				bufferInfo.renderPass = pass.renderPass;
+				bufferInfo.attachmentCount = static_cast<uint32_t>(views.size());
+				bufferInfo.pAttachments = views.data();
+				bufferInfo.width = pass.extent.width;
+				bufferInfo.height = pass.extent.height;
+				bufferInfo.layers = 1;
+			}
+			try {
+				pass.framebuffers[i] = device->GetLogicalDevice().createFramebuffer(bufferInfo);
+			}
+			catch (vk::SystemError err) {
+				LOG_RENDER_EXCEPT("Failed to create framebuffer!");
+			}
+		}
+	}
+
+
+	void RenderGraph::BeginRendering(vk::CommandBuffer commandBuffer, const Pass& pass, uint32_t imageIndex)
+	{
+		vk::Rect2D renderArea({ 0, 0 }, pass.extent);
+
+		if (!m_dynamicRendering)
+		{
+			vk::RenderPassBeginInfo renderPassInfo = vk::RenderPassBeginInfo();
+			{
+				renderPassInfo.renderPass = pass.renderPass;
+				renderPassInfo.framebuffer = pass.framebuffers[imageIndex % pass.framebuffers.size()];
+				renderPassInfo.renderArea = renderArea;
+				renderPassInfo.clearValueCount = static_cast<uint32_t>(pass.clearValues.size());
+				renderPassInfo.pClearValues = pass.clearValues.data();
+			}
+			commandBuffer.beginRenderPass(&renderPassInfo, vk::SubpassContents::eInline);
+			return;
+		}
+
+		// Attachments are given directly, the graph did all layout transitions
+		std::vector<vk::RenderingAttachmentInfoKHR> colorAttachments;
+		vk::RenderingAttachmentInfoKHR depthAttachment = vk::RenderingAttachmentInfoKHR();
+		bool hasDepth = false;
+		bool hasStencil = false;
+
+		for (const auto& attachment : pass.attachments)
+		{
+			vk::RenderingAttachmentInfoKHR info = vk::RenderingAttachmentInfoKHR();
+			{
+				info.imageView = GetImageView(attachment.resource, imageIndex);
+				info.imageLayout = attachment.depth ? vk::ImageLayout::eDepthStencilAttachmentOptimal : vk::ImageLayout::eColorAttachmentOptimal;
+				info.loadOp = attachment.loadOp;
+				info.storeOp = attachment.storeOp;
+				info.clearValue = attachment.clear;
+				if (attachment.resolve != UINT32_MAX)
+				{
+					info.resolveMode = vk::ResolveModeFlagBits::eAverage;
+					info.resolveImageView = GetImageView(attachment.resolve, imageIndex);
+					info.resolveImageLayout = vk::ImageLayout::eColorAttachmentOptimal;
+				}
+			}
+
+			if (attachment.depth)
+			{
+				depthAttachment = info;
+				hasDepth = true;
+				hasStencil = static_cast<bool>(GetAspect(m_resources[attachment.resource].desc.format) & vk::ImageAspectFlagBits::eStencil);
+			}
+			else
+				colorAttachments.push_back(info);
+		}
+
+		vk::RenderingInfoKHR renderingInfo = vk::RenderingInfoKHR();
+		{
+			renderingInfo.renderArea = renderArea;
+			renderingInfo.layerCount = 1;
+			renderingInfo.colorAttachmentCount = static_cast<uint32_t>(colorAttachments.size());
+			renderingInfo.pColorAttachments = colorAttachments.data();
+			renderingInfo.pDepthAttachment = hasDepth ? &depthAttachment : nullptr;
+			renderingInfo.pStencilAttachment = hasStencil ? &depthAttachment : nullptr;
+		}
+		static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice()->CmdBeginRendering(commandBuffer, renderingInfo);
+	}
+
+
+	void RenderGraph::RecordBarriers(vk::CommandBuffer commandBuffer, const std::vector<Barrier>& barriers,
+		vk::PipelineStageFlags srcStages, vk::PipelineStageFlags dstStages, uint32_t imageIndex)
+	{
+		if (barriers.empty())
+			return;
+
+		std::vector<vk::ImageMemoryBarrier> imageBarriers;
+		imageBarriers.reserve(barriers.size());
+		for (const auto& barrier : barriers)
+		{
+			vk::ImageMemoryBarrier imageBarrier = vk::ImageMemoryBarrier();
+			{
+				imageBarrier.srcAccessMask = barrier.srcAccess;
+				imageBarrier.dstAccessMask = barrier.dstAccess;
+				imageBarrier.oldLayout = barrier.oldLayout;
+				imageBarrier.newLayout = barrier.newLayout;
+				imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				imageBarrier.image = GetImage(barrier.resource, imageIndex);
+				imageBarrier.subresourceRange.aspectMask = GetAspect(m_resources[barrier.resource].desc.format);
+				imageBarrier.subresourceRange.baseMipLevel = 0;
+				imageBarrier.subresourceRange.levelCount = 1;
+				imageBarrier.subresourceRange.baseArrayLayer = 0;
+				imageBarrier.subresourceRange.layerCount = 1;
+			}
+			imageBarriers.push_back(imageBarrier);
+		}
+
+		commandBuffer.pipelineBarrier(srcStages, dstStages, {}, nullptr, nullptr, imageBarriers);
+	}
+
+
+	void RenderGraph::GetAccessInfo(RGAccess access, RGPassType type, bool load,
+		vk::ImageLayout& layout, vk::AccessFlags& accessMask, vk::PipelineStageFlags& stages)
+	{
+		vk::PipelineStageFlags shaderStages = type == RGPassType::Compute ?
+			vk::PipelineStageFlags(vk::PipelineStageFlagBits::eComputeShader) :
+			vk::PipelineStageFlags(vk::PipelineStageFlagBits::eFragmentShader);
+
+		switch (access)
+		{
+		case RGAccess::ColorAttachment:
+			layout = vk::ImageLayout::eColorAttachmentOptimal;
+			accessMask = vk::AccessFlagBits::eColorAttachmentWrite;
+			if (load)
+				accessMask |= vk::AccessFlagBits::eColorAttachmentRead;
+			stages = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+			break;
+		case RGAccess::ResolveAttachment:
+			layout = vk::ImageLayout::eColorAttachmentOptimal;
+			accessMask = vk::AccessFlagBits::eColorAttachmentWrite;
+			stages = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+			break;
+		case RGAccess::DepthAttachment:
+			layout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
+			accessMask = vk::AccessFlagBits::eDepthStencilAttachmentWrite | vk::AccessFlagBits::eDepthStencilAttachmentRead;
+			stages = vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eLateFragmentTests;
+			break;
+		case RGAccess::Sampled:
+			layout = vk::ImageLayout::eShaderReadOnlyOptimal;
+			accessMask = vk::AccessFlagBits::eShaderRead;
+			stages = shaderStages;
+			break;
+		case RGAccess::StorageRead:
+			layout = vk::ImageLayout::eGeneral;
+			accessMask = vk::AccessFlagBits::eShaderRead;
+			stages = shaderStages;
+			break;
+		case RGAccess::StorageWrite:
+			layout = vk::ImageLayout::eGeneral;
+			accessMask = vk::AccessFlagBits::eShaderWrite;
+			if (load)
+				accessMask |= vk::AccessFlagBits::eShaderRead;
+			stages = shaderStages;
+			break;
+		case RGAccess::TransferSrc:
+			layout = vk::ImageLayout::eTransferSrcOptimal;
+			accessMask = vk::AccessFlagBits::eTransferRead;
+			stages = vk::PipelineStageFlagBits::eTransfer;
+			break;
+		case RGAccess::TransferDst:
+			layout = vk::ImageLayout::eTransferDstOptimal;
+			accessMask = vk::AccessFlagBits::eTransferWrite;
+			stages = vk::PipelineStageFlagBits::eTransfer;
+			break;
+		}
+	}
+
+
+	vk::ImageAspectFlags RenderGraph::GetAspect(vk::Format format)
+	{
+		switch (format)
+		{
+		case vk::Format::eD16Unorm:
+		case vk::Format::eD32Sfloat:
+		case vk::Format::eX8D24UnormPack32:
+			return vk::ImageAspectFlagBits::eDepth;
+		case vk::Format::eD16UnormS8Uint:
+		case vk::Format::eD24UnormS8Uint:
+		case vk::Format::eD32SfloatS8Uint:
+			return vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil;
+		default:
+			return vk::ImageAspectFlagBits::eColor;
+		}
+	}
+
+
+} // namespace Helios::Vulkan
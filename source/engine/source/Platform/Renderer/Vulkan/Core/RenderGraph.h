@@ -0,0 +1,228 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "Platform/Renderer/Vulkan/Core/FrameRing.h"
+
+namespace Helios::Vulkan {
+
+
+	struct PipelineConfigInfo;
+
+
+	// Handles of the render graph
+	using RGResource = uint32_t;
+	using RGPass = uint32_t;
+
+
+	// How a pass uses an image
+	enum class RGAccess
+	{
+		ColorAttachment,
+		DepthAttachment,
+		// Target of a multisampled color attachment (resolved at the end of the pass)
+		ResolveAttachment,
+		Sampled,
+		StorageRead,
+		StorageWrite,
+		TransferSrc,
+		TransferDst
+	};
+
+
+	enum class RGPassType
+	{
+		// Gets a render pass and framebuffer from the graph (or begins
+		// dynamic rendering if the device supports it)
+		Graphics,
+		Compute,
+		Transfer
+	};
+
+
+	struct RGImageDesc
+	{
+		vk::Format format = vk::Format::eUndefined;
+		vk::Extent2D extent;
+		vk::SampleCountFlagBits samples = vk::SampleCountFlagBits::e1;
+	};
+
+
+	// Frame graph of the renderer.
+	// Passes declare which images they read and write, the graph then
+	// - culls passes whose results are never used
+	// - records all layout transitions and pipeline barriers (batched per pass,
+	//   none between passes which only read an image in the same layout)
+	// - creates the render passes and framebuffers of graphics passes (not
+	//   needed with dynamic rendering, the attachments are set when recording)
+	// - aliases the memory of transient images with disjoint lifetimes
+	// - uses lazily allocated memory for attachments which only live within one
+	//   pass (e.g. multisampled color and depth, which are resolved in the pass)
+	// The graph is declared and compiled once (again after a resize) and only
+	// executed every frame.
+	class RenderGraph
+	{
+	public:
+		using ExecuteFunction = std::function<void(FrameContext& frame, vk::CommandBuffer commandBuffer)>;
+
+		RenderGraph();
+		~RenderGraph();
+
+		void Destroy();
+
+	public:
+		// Image owned by someone else (e.g. the swapchain), selected by the image
+		// index at execution. Left in the final layout at the end of the frame.
+		RGResource ImportImage(const std::string& name, const std::vector<vk::Image>& images, const std::vector<vk::ImageView>& views,
+			vk::Format format, vk::Extent2D extent, vk::ImageLayout finalLayout);
+		// Image which only lives during the frame (memory might be shared)
+		RGResource CreateImage(const std::string& name, const RGImageDesc& desc);
+
+		RGPass AddPass(const std::string& name, RGPassType type, ExecuteFunction execute);
+		void AddColorAttachment(RGPass pass, RGResource resource, vk::AttachmentLoadOp loadOp, vk::ClearColorValue clear = {});
+		void SetDepthAttachment(RGPass pass, RGResource resource, vk::AttachmentLoadOp loadOp, vk::ClearDepthStencilValue clear = { 1.0f, 0 });
+		// Resolves the multisampled color attachment into the target
+		void AddResolveAttachment(RGPass pass, RGResource source, RGResource target);
+		void AddRead(RGPass pass, RGResource resource, RGAccess access);
+		void AddWrite(RGPass pass, RGResource resource, RGAccess access);
+		// Never culled (e.g. writes to buffers which the graph does not know)
+		void SetSideEffect(RGPass pass);
+
+		// Culls passes, computes barriers and creates all vulkan objects
+		void Compile();
+		// Records all passes into the command buffer of the frame
+		void Execute(FrameContext& frame, uint32_t imageIndex);
+
+		bool IsCompiled() const { return m_compiled; }
+		bool IsCulled(RGPass pass) const { return m_passes[pass].culled; }
+		vk::Extent2D GetExtent(RGResource resource) const { return m_resources[resource].desc.extent; }
+		bool UsesDynamicRendering() const { return m_dynamicRendering; }
+
+		// Sets the render pass (or the attachment formats) of a graphics pass
+		void SetupPipelineConfig(RGPass pass, PipelineConfigInfo& configInfo) const;
+
+	// Getter for vulkan objects
+	public:
+		vk::RenderPass& GetRenderPass(RGPass pass) { return m_passes[pass].renderPass; }
+		vk::Image GetImage(RGResource resource, uint32_t imageIndex = 0) const;
+		vk::ImageView GetImageView(RGResource resource, uint32_t imageIndex = 0) const;
+
+	// Internal helper
+	private:
+		struct Barrier;
+		struct Pass;
+		void CullPasses();
+		void CreateTransientImages();
+		void ComputeBarriers();
+		void SetupAttachments(RGPass pass);
+		void CreateRenderPass(RGPass pass);
+		void BeginRendering(vk::CommandBuffer commandBuffer, const Pass& pass, uint32_t imageIndex);
+		void RecordBarriers(vk::CommandBuffer commandBuffer, const std::vector<Barrier>& barriers,
+			vk::PipelineStageFlags srcStages, vk::PipelineStageFlags dstStages, uint32_t imageIndex);
+
+		static void GetAccessInfo(RGAccess access, RGPassType type, bool load,
+			vk::ImageLayout& layout, vk::AccessFlags& accessMask, vk::PipelineStageFlags& stages);
+		static vk::ImageAspectFlags GetAspect(vk::Format format);
+
+	// Internal data
+	private:
+		struct Resource
+		{
+			std::string name;
+			RGImageDesc desc;
+			bool imported = false;
+			vk::ImageUsageFlags usage;
+
+			// Imported images
+			std::vector<vk::Image> images;
+			std::vector<vk::ImageView> views;
+			vk::ImageLayout finalLayout = vk::ImageLayout::eUndefined;
+
+			// Transient images
+			uint32_t block = UINT32_MAX;
+			bool lazy = false;
+			uint32_t firstPass = UINT32_MAX;
+			uint32_t lastPass = 0;
+		};
+
+		struct Use
+		{
+			RGResource resource;
+			RGAccess access;
+			bool write;
+			// Attachments only
+			vk::AttachmentLoadOp loadOp = vk::AttachmentLoadOp::eDontCare;
+			vk::ClearValue clear;
+			// Resolve attachments only
+			RGResource source = UINT32_MAX;
+		};
+
+		struct Barrier
+		{
+			RGResource resource;
+			vk::ImageLayout oldLayout;
+			vk::ImageLayout newLayout;
+			vk::AccessFlags srcAccess;
+			vk::AccessFlags dstAccess;
+		};
+
+		struct Attachment
+		{
+			RGResource resource;
+			bool depth;
+			vk::AttachmentLoadOp loadOp;
+			vk::AttachmentStoreOp storeOp;
+			vk::ClearValue clear;
+			RGResource resolve = UINT32_MAX;
+		};
+
+		struct Pass
+		{
+			std::string name;
+			RGPassType type;
+			ExecuteFunction execute;
+			std::vector<Use> uses;
+			bool sideEffect = false;
+			bool culled = false;
+
+			// Barriers in front of the pass (one pipeline barrier)
+			std::vector<Barrier> barriers;
+			vk::PipelineStageFlags srcStages;
+			vk::PipelineStageFlags dstStages;
+
+			// Graphics passes
+			std::vector<Attachment> attachments;
+			vk::RenderPass renderPass;
+			std::vector<vk::Framebuffer> framebuffers;
+			std::vector<vk::ClearValue> clearValues;
+			vk::Extent2D extent;
+		};
+
+		// Memory shared by transient images
+		struct MemoryBlock
+		{
+			vk::DeviceMemory memory;
+			vk::DeviceSize size = 0;
+			uint32_t memoryTypeBits = ~0u;
+			bool lazy = false;
+			std::vector<RGResource> resources;
+		};
+
+		std::vector<Resource> m_resources;
+		std::vector<Pass> m_passes;
+		std::vector<MemoryBlock> m_blocks;
+
+		// Transitions of imported images into their final layout
+		std::vector<Barrier> m_finalBarriers;
+		vk::PipelineStageFlags m_finalSrcStages;
+
+		// Transient images (indexed by the resource)
+		std::vector<vk::Image> m_vkImages;
+		std::vector<vk::ImageView> m_vkImageViews;
+
+		bool m_compiled = false;
+		bool m_dynamicRendering = false;
+	};
+
+
+} // namespace Helios::Vulkan
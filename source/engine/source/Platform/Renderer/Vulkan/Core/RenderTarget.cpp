@@ -0,0 +1,68 @@
+#include "pch.h"
+#include "RenderTarget.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+
+
+namespace Helios::Vulkan {
+
+
+	void RenderTarget::CreateResources()
+	{
+		CreateImageViews();
+	}
+
+
+	void RenderTarget::DestroyResources()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		for (auto imageView : m_frameImageViews)
+			device->GetLogicalDevice().destroyImageView(imageView);
+		m_frameImageViews.clear();
+	}
+
+
+	void RenderTarget::CreateImageViews()
+	{
+		Scope<Device> &device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		m_frameImageViews.resize(m_frameImages.size());
+		for (auto i = 0; i < m_frameImages.size(); ++i)
+		{
+			// Setup ViewInfo
+			vk::ImageViewCreateInfo viewInfo = vk::ImageViewCreateInfo();
+			{
+				viewInfo.image = m_frameImages[i];
+				viewInfo.viewType = vk::ImageViewType::e2D;
+				viewInfo.format = m_vkImageFormat;
+
+				vk::ComponentMapping comp;
+				comp.r = vk::ComponentSwizzle::eIdentity;
+				comp.g = vk::ComponentSwizzle::eIdentity;
+				comp.b = vk::ComponentSwizzle::eIdentity;
+				comp.a = vk::ComponentSwizzle::eIdentity;
+				viewInfo.components = comp;
+
+				vk::ImageSubresourceRange range;
+				range.aspectMask = vk::ImageAspectFlagBits::eColor;
+				range.baseMipLevel = 0;
+				range.levelCount = 1;
+				range.baseArrayLayer = 0;
+				range.layerCount = 1;
+				viewInfo.subresourceRange = range;
+			}
+			// Create
+			try {
+				LOG_RENDER_TRACE("Creating image views for frame #{}...", i);
+				m_frameImageViews[i] = device->GetLogicalDevice().createImageView(viewInfo);
+			}
+			catch (vk::SystemError err) {
+				LOG_RENDER_EXCEPT("Failed to create image view!");
+			}
+		}
+	}
+
+
+} // namespace Helios::Vulkan
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "Platform/Renderer/Vulkan/Core/FrameRing.h"
+
+namespace Helios::Vulkan {
+
+
+	// Images the renderer draws into (imported by the render graph).
+	// Implemented by the swapchain and by offscreen images.
+	class RenderTarget
+	{
+	public:
+		virtual ~RenderTarget() = default;
+
+	// Getter for vulkan objects
+	public:
+		vk::Extent2D& GetExtent() { return m_vkExtent; }
+		vk::Format& GetImageFormat() { return m_vkImageFormat; }
+		vk::ImageUsageFlags GetImageUsage() const { return m_imageUsage; }
+
+		vk::Image& GetImage(uint32_t index) { return m_frameImages[index]; }
+		const std::vector<vk::Image>& GetImages() const { return m_frameImages; }
+		const std::vector<vk::ImageView>& GetImageViews() const { return m_frameImageViews; }
+		uint32_t GetImageCount() const { return static_cast<uint32_t>(m_frameImages.size()); }
+		// Layout of the images at the end of the frame
+		vk::ImageLayout GetFinalLayout() const { return m_finalLayout; }
+
+		virtual vk::Result AcquireNextImage(FrameContext& frame, uint32_t *imageIndex) = 0;
+		virtual vk::Result Present(FrameContext& frame, uint32_t imageIndex) = 0;
+		// Signaled by the submit of the image and waited for by its presentation
+		// (one per image, a semaphore of a frame in flight might still be waited
+		// for by an earlier presentation). Null if the target is not presentable.
+		virtual vk::Semaphore GetRenderFinished(uint32_t imageIndex) { return nullptr; }
+
+	// Vulkan objects
+	protected:
+		vk::Extent2D m_vkExtent;
+		vk::Format m_vkImageFormat;
+
+	// Internal helper
+	protected:
+		// Creates the views of the (already existing) frame images
+		void CreateResources();
+		void DestroyResources();
+
+		void CreateImageViews();
+
+	// Internal data
+	protected:
+		vk::ImageLayout m_finalLayout = vk::ImageLayout::ePresentSrcKHR;
+		vk::ImageUsageFlags m_imageUsage;
+
+		// Frame objects
+		std::vector<vk::Image> m_frameImages;
+		std::vector<vk::ImageView> m_frameImageViews;
+	};
+
+
+} // namespace Helios::Vulkan
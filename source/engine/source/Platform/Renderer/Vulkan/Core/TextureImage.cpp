@@ -0,0 +1,226 @@
+#include "pch.h"
+#include "TextureImage.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+
+
+namespace Helios::Vulkan {
+
+
+	TextureImage::TextureImage(vk::Extent2D extent, vk::Format format, uint32_t mipLevels)
+	{
+		Create(extent, format, mipLevels);
+	}
+
+
+	TextureImage::~TextureImage()
+	{
+		Destroy();
+	}
+
+
+	void TextureImage::Create(vk::Extent2D extent, vk::Format format, uint32_t mipLevels)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		m_vkExtent = extent;
+		m_vkFormat = format;
+		m_mipLevels = std::max(1u, mipLevels);
+
+		vk::ImageCreateInfo imageInfo = vk::ImageCreateInfo();
+		{
+			imageInfo.imageType = vk::ImageType::e2D;
+			imageInfo.extent.width = m_vkExtent.width;
+			imageInfo.extent.height = m_vkExtent.height;
+			imageInfo.extent.depth = 1;
+			imageInfo.mipLevels = m_mipLevels;
+			imageInfo.arrayLayers = 1;
+			imageInfo.format = m_vkFormat;
+			imageInfo.tiling = vk::ImageTiling::eOptimal;
+			imageInfo.initialLayout = vk::ImageLayout::eUndefined;
+			imageInfo.usage =
+				vk::ImageUsageFlagBits::eSampled |
+				vk::ImageUsageFlagBits::eTransferDst |
+				vk::ImageUsageFlagBits::eTransferSrc;
+			imageInfo.samples = vk::SampleCountFlagBits::e1;
+			imageInfo.sharingMode = vk::SharingMode::eExclusive;
+		}
+
+		LOG_RENDER_TRACE("Creating texture image ({}x{}, {} mips, {})...",
+			m_vkExtent.width, m_vkExtent.height, m_mipLevels, vk::to_string(m_vkFormat));
+		device->CreateImageWithMemory(imageInfo, vk::MemoryPropertyFlagBits::eDeviceLocal, m_vkImage, m_vkMemory);
+
+		CreateViews();
+		CreateSampler();
+	}
+
+
+	void TextureImage::Destroy()
+	{
+		VKRendererAPI* api = static_cast<VKRendererAPI*>(Renderer::Get());
+		Scope<Device>& device = api->GetDevice();
+
+		if (api->GetBindless())
+			api->GetBindless()->RemoveTexture(m_bindlessIndex, api->GetFrames()->GetFrameNumber());
+		m_bindlessIndex = UINT32_MAX;
+
+		for (auto view : m_vkViews)
+			device->GetLogicalDevice().destroyImageView(view);
+		m_vkViews.clear();
+
+		if (m_vkSampler)
+			device->GetLogicalDevice().destroySampler(m_vkSampler);
+		if (m_vkImage)
+			device->GetLogicalDevice().destroyImage(m_vkImage);
+		if (m_vkMemory)
+			device->GetLogicalDevice().freeMemory(m_vkMemory);
+	}
+
+
+	void TextureImage::SetResidentMip(uint32_t mip)
+	{
+		VKRendererAPI* api = static_cast<VKRendererAPI*>(Renderer::Get());
+
+		if (mip >= m_mipLevels or mip == m_residentMip)
+			return;
+		m_residentMip = mip;
+
+		// Frames in flight may still use the old descriptor, so the
+		// new view gets a new index and the old one is retired
+		if (api->GetBindless())
+		{
+			api->GetBindless()->RemoveTexture(m_bindlessIndex, api->GetFrames()->GetFrameNumber());
+			m_bindlessIndex = api->GetBindless()->AddTexture(m_vkViews[mip], m_vkSampler);
+		}
+	}
+
+
+	vk::Extent2D TextureImage::GetMipExtent(uint32_t mip) const
+	{
+		return {
+			std::max(1u, m_vkExtent.width >> mip),
+			std::max(1u, m_vkExtent.height >> mip)
+		};
+	}
+
+
+	vk::DescriptorImageInfo TextureImage::GetDescriptorInfo() const
+	{
+		uint32_t mip = IsResident() ? m_residentMip : 0;
+		return vk::DescriptorImageInfo(m_vkSampler, m_vkViews[mip], vk::ImageLayout::eShaderReadOnlyOptimal);
+	}
+
+
+	FormatBlock TextureImage::GetFormatBlock(vk::Format format)
+	{
+		switch (format)
+		{
+		case vk::Format::eR8G8B8A8Unorm:
+		case vk::Format::eR8G8B8A8Srgb:
+		case vk::Format::eB8G8R8A8Unorm:
+		case vk::Format::eB8G8R8A8Srgb:
+			return { 1, 1, 4 };
+		case vk::Format::eBc1RgbaUnormBlock:
+		case vk::Format::eBc1RgbaSrgbBlock:
+		case vk::Format::eBc4UnormBlock:
+			return { 4, 4, 8 };
+		case vk::Format::eBc3UnormBlock:
+		case vk::Format::eBc3SrgbBlock:
+		case vk::Format::eBc5UnormBlock:
+		case vk::Format::eBc7UnormBlock:
+		case vk::Format::eBc7SrgbBlock:
+		case vk::Format::eAstc4x4UnormBlock:
+		case vk::Format::eAstc4x4SrgbBlock:
+			return { 4, 4, 16 };
+		default:
+			LOG_RENDER_ERROR("Unsupported texture format: {}", vk::to_string(format));
+			return { 1, 1, 4 };
+		}
+	}
+
+
+	uint32_t TextureImage::CalcMipLevels(vk::Extent2D extent)
+	{
+		return static_cast<uint32_t>(std::floor(std::log2(std::max(extent.width, extent.height)))) + 1;
+	}
+
+
+	bool TextureImage::SupportsLinearBlit(vk::Format format)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		vk::FormatFeatureFlags features = device->GetPhysicalDevice().getFormatProperties(format).optimalTilingFeatures;
+		vk::FormatFeatureFlags required =
+			vk::FormatFeatureFlagBits::eBlitSrc |
+			vk::FormatFeatureFlagBits::eBlitDst |
+			vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+
+		return (features & required) == required;
+	}
+
+
+	void TextureImage::CreateViews()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		m_vkViews.resize(m_mipLevels);
+		for (uint32_t mip = 0; mip < m_mipLevels; mip++)
+		{
+			vk::ImageViewCreateInfo viewInfo = vk::ImageViewCreateInfo();
+			{
+				viewInfo.image = m_vkImage;
+				viewInfo.viewType = vk::ImageViewType::e2D;
+				viewInfo.format = m_vkFormat;
+				viewInfo.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+				viewInfo.subresourceRange.baseMipLevel = mip;
+				viewInfo.subresourceRange.levelCount = m_mipLevels - mip;
+				viewInfo.subresourceRange.baseArrayLayer = 0;
+				viewInfo.subresourceRange.layerCount = 1;
+			}
+
+			try {
+				m_vkViews[mip] = device->GetLogicalDevice().createImageView(viewInfo);
+			}
+			catch (vk::SystemError err) {
+				LOG_RENDER_EXCEPT("Failed to create texture image view!");
+			}
+		}
+	}
+
+
+	void TextureImage::CreateSampler()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		const vk::PhysicalDeviceProperties& props = device->GetCaps().properties;
+
+		vk::SamplerCreateInfo samplerInfo = vk::SamplerCreateInfo();
+		{
+			samplerInfo.magFilter = vk::Filter::eLinear;
+			samplerInfo.minFilter = vk::Filter::eLinear;
+			samplerInfo.mipmapMode = vk::SamplerMipmapMode::eLinear;
+			samplerInfo.addressModeU = vk::SamplerAddressMode::eRepeat;
+			samplerInfo.addressModeV = vk::SamplerAddressMode::eRepeat;
+			samplerInfo.addressModeW = vk::SamplerAddressMode::eRepeat;
+			samplerInfo.mipLodBias = 0.0f;
+			// Enabled in Device::CreateLogicalDevice
+			samplerInfo.anisotropyEnable = VK_TRUE;
+			samplerInfo.maxAnisotropy = std::min(16.0f, props.limits.maxSamplerAnisotropy);
+			samplerInfo.compareEnable = VK_FALSE;
+			samplerInfo.minLod = 0.0f;
+			samplerInfo.maxLod = static_cast<float>(m_mipLevels);
+			samplerInfo.borderColor = vk::BorderColor::eIntOpaqueBlack;
+			samplerInfo.unnormalizedCoordinates = VK_FALSE;
+		}
+
+		try {
+			m_vkSampler = device->GetLogicalDevice().createSampler(samplerInfo);
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to create texture sampler!");
+		}
+	}
+
+
+} // namespace Helios::Vulkan
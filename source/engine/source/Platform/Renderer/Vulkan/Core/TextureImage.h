@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+namespace Helios::Vulkan {
+
+
+	// Size of a texel block (1x1 for uncompressed formats)
+	struct FormatBlock
+	{
+		uint32_t width = 1;
+		uint32_t height = 1;
+		uint32_t bytes = 4;
+	};
+
+
+	// Sampled image with its full mip chain, the views and the sampler.
+	// Mip levels become resident from the smallest to the largest one, there
+	// is one view per resident state (base level ... last level).
+	class TextureImage
+	{
+	public:
+		TextureImage(vk::Extent2D extent, vk::Format format, uint32_t mipLevels);
+		~TextureImage();
+
+		void Create(vk::Extent2D extent, vk::Format format, uint32_t mipLevels);
+		void Destroy();
+
+	public:
+		// Makes the levels from mip to the last one visible to shaders
+		void SetResidentMip(uint32_t mip);
+		uint32_t GetResidentMip() const { return m_residentMip; }
+		bool IsResident() const { return m_residentMip != UINT32_MAX; }
+
+		vk::Extent2D GetExtent() const { return m_vkExtent; }
+		vk::Extent2D GetMipExtent(uint32_t mip) const;
+		vk::Format GetFormat() const { return m_vkFormat; }
+		uint32_t GetMipLevels() const { return m_mipLevels; }
+
+		// Descriptor for per material sets (only valid if resident)
+		vk::DescriptorImageInfo GetDescriptorInfo() const;
+		// Index into the bindless texture array (INVALID_INDEX if not resident or no bindless)
+		uint32_t GetBindlessIndex() const { return m_bindlessIndex; }
+
+		static FormatBlock GetFormatBlock(vk::Format format);
+		// Full mip chain for the extent
+		static uint32_t CalcMipLevels(vk::Extent2D extent);
+		// Blits are needed to generate mips on the GPU
+		static bool SupportsLinearBlit(vk::Format format);
+
+	// Getter for vulkan objects
+	public:
+		vk::Image& GetImage() { return m_vkImage; }
+		vk::Sampler& GetSampler() { return m_vkSampler; }
+
+	// Vulkan objects
+	private:
+		vk::Image m_vkImage;
+		vk::DeviceMemory m_vkMemory;
+		vk::Sampler m_vkSampler;
+		// View with the base level [i]
+		std::vector<vk::ImageView> m_vkViews;
+
+	// Internal helper
+	private:
+		void CreateViews();
+		void CreateSampler();
+
+	// Internal data
+	private:
+		vk::Extent2D m_vkExtent;
+		vk::Format m_vkFormat;
+		uint32_t m_mipLevels = 1;
+		uint32_t m_residentMip = UINT32_MAX;
+		uint32_t m_bindlessIndex = UINT32_MAX;
+	};
+
+
+} // namespace Helios::Vulkan
@@ -0,0 +1,261 @@
+#include "pch.h"
+#include "TextureStreamer.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+
+#include "HeliosEngine/Core/Config.h"
+
+
+namespace Helios::Vulkan {
+
+
+	TextureStreamer::TextureStreamer(uint32_t framesInFlight)
+	{
+		Create(framesInFlight);
+	}
+
+
+	TextureStreamer::~TextureStreamer()
+	{
+		Destroy();
+	}
+
+
+	void TextureStreamer::Create(uint32_t framesInFlight)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		// Budget in KiB
+		vk::DeviceSize budget = std::strtoull(Config::Get("TextureUploadBudget", std::to_string(DEFAULT_BUDGET / 1024)).c_str(), nullptr, 10) * 1024;
+		m_budget = budget ? budget : DEFAULT_BUDGET;
+
+		LOG_RENDER_TRACE("Creating texture streamer ({} KiB per frame)...", m_budget / 1024);
+
+		// Every frame in flight has its own region of the staging buffer
+		device->CreateBuffer(
+			m_budget * framesInFlight,
+			vk::BufferUsageFlagBits::eTransferSrc,
+			vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+			m_vkStagingBuffer, m_vkStagingMemory);
+		m_mapped = static_cast<uint8_t*>(device->GetLogicalDevice().mapMemory(m_vkStagingMemory, 0, VK_WHOLE_SIZE));
+
+		m_defaultTexture = CreateRef<TextureImage>(vk::Extent2D{ 1, 1 }, vk::Format::eR8G8B8A8Unorm, 1);
+		Enqueue(m_defaultTexture, { { 255, 255, 255, 255 } }, false);
+	}
+
+
+	void TextureStreamer::Destroy()
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Destroying texture streamer...");
+
+		m_requests.clear();
+		m_defaultTexture.reset();
+
+		if (m_mapped)
+			device->GetLogicalDevice().unmapMemory(m_vkStagingMemory);
+		m_mapped = nullptr;
+
+		if (m_vkStagingBuffer)
+			device->GetLogicalDevice().destroyBuffer(m_vkStagingBuffer);
+		if (m_vkStagingMemory)
+			device->GetLogicalDevice().freeMemory(m_vkStagingMemory);
+	}
+
+
+	void TextureStreamer::Enqueue(Ref<TextureImage> image, std::vector<std::vector<uint8_t>> levels, bool generateMips)
+	{
+		std::erase_if(m_requests, [&](const Request& request) {
+			return request.image.lock() == image;
+		});
+
+		Request request;
+		request.image = image;
+		request.levels = std::move(levels);
+		request.generateMips = generateMips and request.levels.size() == 1 and image->GetMipLevels() > 1;
+		m_requests.push_back(std::move(request));
+	}
+
+
+	void TextureStreamer::Record(FrameContext& frame)
+	{
+		vk::DeviceSize offset = m_budget * frame.index;
+		vk::DeviceSize end = offset + m_budget;
+
+		while (!m_requests.empty())
+		{
+			Request& request = m_requests.front();
+			if (!request.image.expired() and !RecordRequest(frame.commandBuffer, request, offset, end))
+				break;
+			m_requests.pop_front();
+		}
+	}
+
+
+	bool TextureStreamer::RecordRequest(vk::CommandBuffer commandBuffer, Request& request, vk::DeviceSize& offset, vk::DeviceSize end)
+	{
+		Ref<TextureImage> image = request.image.lock();
+		FormatBlock block = TextureImage::GetFormatBlock(image->GetFormat());
+
+		if (!request.started)
+		{
+			if (request.levels.empty() or request.levels.size() > image->GetMipLevels())
+			{
+				LOG_RENDER_ERROR("Invalid number of texture levels ({})!", request.levels.size());
+				return true;
+			}
+
+			RecordBarrier(commandBuffer, image->GetImage(), 0, image->GetMipLevels(),
+				vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal,
+				{}, vk::AccessFlagBits::eTransferWrite,
+				vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer);
+
+			// Smallest level first
+			request.started = true;
+			request.level = static_cast<uint32_t>(request.levels.size()) - 1;
+			request.row = 0;
+		}
+
+		while (true)
+		{
+			vk::Extent2D extent = image->GetMipExtent(request.level);
+			uint32_t blocksX = (extent.width + block.width - 1) / block.width;
+			uint32_t blocksY = (extent.height + block.height - 1) / block.height;
+			vk::DeviceSize rowSize = static_cast<vk::DeviceSize>(blocksX) * block.bytes;
+
+			const std::vector<uint8_t>& data = request.levels[request.level];
+			if (data.size() < rowSize * blocksY)
+			{
+				LOG_RENDER_ERROR("Not enough data for texture level {} ({} of {} bytes)!", request.level, data.size(), rowSize * blocksY);
+				return true;
+			}
+			if (rowSize > m_budget)
+			{
+				LOG_RENDER_ERROR("Texture row exceeds the upload budget ({} bytes)!", rowSize);
+				return true;
+			}
+
+			// Buffer offsets have to be a multiple of the block size
+			offset = (offset + 15) & ~vk::DeviceSize(15);
+			uint32_t rows = static_cast<uint32_t>(std::min<vk::DeviceSize>(blocksY - request.row, offset < end ? (end - offset) / rowSize : 0));
+			if (rows == 0)
+				return false;
+
+			std::memcpy(m_mapped + offset, data.data() + request.row * rowSize, rows * rowSize);
+
+			vk::BufferImageCopy region = vk::BufferImageCopy();
+			{
+				region.bufferOffset = offset;
+				region.bufferRowLength = 0;
+				region.bufferImageHeight = 0;
+				region.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+				region.imageSubresource.mipLevel = request.level;
+				region.imageSubresource.baseArrayLayer = 0;
+				region.imageSubresource.layerCount = 1;
+				region.imageOffset = vk::Offset3D{ 0, static_cast<int32_t>(request.row * block.height), 0 };
+				region.imageExtent = vk::Extent3D{
+					extent.width,
+					std::min(rows * block.height, extent.height - request.row * block.height),
+					1 };
+			}
+			commandBuffer.copyBufferToImage(m_vkStagingBuffer, image->GetImage(), vk::ImageLayout::eTransferDstOptimal, region);
+
+			offset += rows * rowSize;
+			request.row += rows;
+			if (request.row < blocksY)
+				return false;
+
+			// Level is complete
+			request.row = 0;
+			if (request.generateMips)
+			{
+				RecordMipGeneration(commandBuffer, *image);
+				image->SetResidentMip(0);
+				return true;
+			}
+
+			RecordBarrier(commandBuffer, image->GetImage(), request.level, 1,
+				vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal,
+				vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eShaderRead,
+				vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader);
+			image->SetResidentMip(request.level);
+
+			if (request.level == 0)
+				return true;
+			request.level--;
+		}
+	}
+
+
+	void TextureStreamer::RecordMipGeneration(vk::CommandBuffer commandBuffer, TextureImage& image)
+	{
+		for (uint32_t mip = 1; mip < image.GetMipLevels(); mip++)
+		{
+			vk::Extent2D src = image.GetMipExtent(mip - 1);
+			vk::Extent2D dst = image.GetMipExtent(mip);
+
+			RecordBarrier(commandBuffer, image.GetImage(), mip - 1, 1,
+				vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eTransferSrcOptimal,
+				vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eTransferRead,
+				vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer);
+
+			vk::ImageBlit blit = vk::ImageBlit();
+			{
+				blit.srcOffsets[0] = vk::Offset3D{ 0, 0, 0 };
+				blit.srcOffsets[1] = vk::Offset3D{ static_cast<int32_t>(src.width), static_cast<int32_t>(src.height), 1 };
+				blit.srcSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+				blit.srcSubresource.mipLevel = mip - 1;
+				blit.srcSubresource.baseArrayLayer = 0;
+				blit.srcSubresource.layerCount = 1;
+				blit.dstOffsets[0] = vk::Offset3D{ 0, 0, 0 };
+				blit.dstOffsets[1] = vk::Offset3D{ static_cast<int32_t>(dst.width), static_cast<int32_t>(dst.height), 1 };
+				blit.dstSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+				blit.dstSubresource.mipLevel = mip;
+				blit.dstSubresource.baseArrayLayer = 0;
+				blit.dstSubresource.layerCount = 1;
+			}
+			commandBuffer.blitImage(
+				image.GetImage(), vk::ImageLayout::eTransferSrcOptimal,
+				image.GetImage(), vk::ImageLayout::eTransferDstOptimal,
+				blit, vk::Filter::eLinear);
+
+			RecordBarrier(commandBuffer, image.GetImage(), mip - 1, 1,
+				vk::ImageLayout::eTransferSrcOptimal, vk::ImageLayout::eShaderReadOnlyOptimal,
+				vk::AccessFlagBits::eTransferRead, vk::AccessFlagBits::eShaderRead,
+				vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader);
+		}
+
+		RecordBarrier(commandBuffer, image.GetImage(), image.GetMipLevels() - 1, 1,
+			vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal,
+			vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eShaderRead,
+			vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader);
+	}
+
+
+	void TextureStreamer::RecordBarrier(vk::CommandBuffer commandBuffer, vk::Image image, uint32_t baseMip, uint32_t mipCount,
+		vk::ImageLayout oldLayout, vk::ImageLayout newLayout,
+		vk::AccessFlags srcAccess, vk::AccessFlags dstAccess,
+		vk::PipelineStageFlags srcStage, vk::PipelineStageFlags dstStage)
+	{
+		vk::ImageMemoryBarrier barrier = vk::ImageMemoryBarrier();
+		{
+			barrier.srcAccessMask = srcAccess;
+			barrier.dstAccessMask = dstAccess;
+			barrier.oldLayout = oldLayout;
+			barrier.newLayout = newLayout;
+			barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.image = image;
+			barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+			barrier.subresourceRange.baseMipLevel = baseMip;
+			barrier.subresourceRange.levelCount = mipCount;
+			barrier.subresourceRange.baseArrayLayer = 0;
+			barrier.subresourceRange.layerCount = 1;
+		}
+		commandBuffer.pipelineBarrier(srcStage, dstStage, {}, nullptr, nullptr, barrier);
+	}
+
+
+} // namespace Helios::Vulkan
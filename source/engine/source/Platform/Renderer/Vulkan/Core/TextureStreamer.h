@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include <deque>
+
+#include "Platform/Renderer/Vulkan/Core/FrameRing.h"
+#include "Platform/Renderer/Vulkan/Core/TextureImage.h"
+
+namespace Helios::Vulkan {
+
+
+	// Uploads texture data through a staging buffer without blocking.
+	// The copies are recorded into the command buffer of the frame, limited
+	// by a budget per frame, so large textures are spread over several frames:
+	// - data with mips is streamed from the smallest to the largest level and
+	//   every finished level becomes visible immediately
+	// - data without mips uploads the base level and generates the mip chain
+	//   with blits on the GPU afterwards
+	class TextureStreamer
+	{
+	public:
+		TextureStreamer(uint32_t framesInFlight);
+		~TextureStreamer();
+
+		void Create(uint32_t framesInFlight);
+		void Destroy();
+
+	public:
+		// Levels: tightly packed data per mip level (level 0 first).
+		// Replaces a pending upload of the same image.
+		void Enqueue(Ref<TextureImage> image, std::vector<std::vector<uint8_t>> levels, bool generateMips);
+
+		// Records the uploads of this frame (has to be recorded outside of a render pass)
+		void Record(FrameContext& frame);
+
+		bool IsIdle() const { return m_requests.empty(); }
+		// 1x1 white texture for textures which are not resident yet
+		Ref<TextureImage>& GetDefaultTexture() { return m_defaultTexture; }
+
+	// Getter for vulkan objects
+	public:
+		vk::Buffer& GetStagingBuffer() { return m_vkStagingBuffer; }
+
+	// Vulkan objects
+	private:
+		vk::Buffer m_vkStagingBuffer;
+		vk::DeviceMemory m_vkStagingMemory;
+
+	// Internal helper
+	private:
+		struct Request;
+		// Returns true if the request is finished (false if the budget is used up)
+		bool RecordRequest(vk::CommandBuffer commandBuffer, Request& request, vk::DeviceSize& offset, vk::DeviceSize end);
+		void RecordMipGeneration(vk::CommandBuffer commandBuffer, TextureImage& image);
+		static void RecordBarrier(vk::CommandBuffer commandBuffer, vk::Image image, uint32_t baseMip, uint32_t mipCount,
+			vk::ImageLayout oldLayout, vk::ImageLayout newLayout,
+			vk::AccessFlags srcAccess, vk::AccessFlags dstAccess,
+			vk::PipelineStageFlags srcStage, vk::PipelineStageFlags dstStage);
+
+	// Internal data
+	private:
+		static constexpr vk::DeviceSize DEFAULT_BUDGET = 8 * 1024 * 1024;
+
+		struct Request
+		{
+			std::weak_ptr<TextureImage> image;
+			std::vector<std::vector<uint8_t>> levels;
+			bool generateMips = false;
+			bool started = false;
+			// Level in progress and the next block row of it
+			uint32_t level = 0;
+			uint32_t row = 0;
+		};
+
+		std::deque<Request> m_requests;
+		Ref<TextureImage> m_defaultTexture;
+
+		uint8_t* m_mapped = nullptr;
+		vk::DeviceSize m_budget = DEFAULT_BUDGET;
+	};
+
+
+} // namespace Helios::Vulkan
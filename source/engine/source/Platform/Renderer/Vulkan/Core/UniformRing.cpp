@@ -0,0 +1,65 @@
+#include "pch.h"
+#include "UniformRing.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+
+
+namespace Helios::Vulkan {
+
+
+	UniformRing::UniformRing(uint32_t framesInFlight, vk::DeviceSize frameSize)
+	{
+		Create(framesInFlight, frameSize);
+	}
+
+
+	UniformRing::~UniformRing()
+	{
+		Destroy();
+	}
+
+
+	void UniformRing::Create(uint32_t framesInFlight, vk::DeviceSize frameSize)
+	{
+		Scope<Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		LOG_RENDER_TRACE("Creating uniform ring ({} KiB per frame)...", frameSize / 1024);
+
+		// Every offset has to fit the uniform and the storage buffer alignment
+		const vk::PhysicalDeviceLimits& limits = device->GetCaps().properties.limits;
+		vk::DeviceSize alignment = std::max(limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment);
+
+		m_allocator = CreateScope<LinearAllocator>("Uniforms", framesInFlight, frameSize,
+			vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eStorageBuffer,
+			alignment);
+	}
+
+
+	void UniformRing::Destroy()
+	{
+		LOG_RENDER_TRACE("Destroying uniform ring...");
+
+		m_allocator.reset();
+	}
+
+
+	void UniformRing::BeginFrame(FrameContext& frame)
+	{
+		m_allocator->BeginFrame(frame);
+	}
+
+
+	UniformAllocation UniformRing::Allocate(vk::DeviceSize size)
+	{
+		LinearAllocation linear = m_allocator->Allocate(size);
+
+		UniformAllocation alloc;
+		alloc.data = linear.data;
+		alloc.offset = static_cast<uint32_t>(linear.offset);
+
+		return alloc;
+	}
+
+
+} // namespace Helios::Vulkan
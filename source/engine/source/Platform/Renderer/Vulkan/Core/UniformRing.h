@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "Platform/Renderer/Vulkan/Core/FrameRing.h"
+#include "Platform/Renderer/Vulkan/Core/LinearAllocator.h"
+
+namespace Helios::Vulkan {
+
+
+	struct UniformAllocation
+	{
+		// Mapped memory to write the data to
+		void* data = nullptr;
+		// Offset within the buffer (used as dynamic offset)
+		uint32_t offset = 0;
+	};
+
+
+	// Linear allocator for uniform/storage data which changes every frame.
+	// Descriptors point to the start of the buffer and the data is selected
+	// with dynamic offsets (aligned to the limits of the device).
+	class UniformRing
+	{
+	public:
+		UniformRing(uint32_t framesInFlight, vk::DeviceSize frameSize = DEFAULT_FRAME_SIZE);
+		~UniformRing();
+
+		void Create(uint32_t framesInFlight, vk::DeviceSize frameSize);
+		void Destroy();
+
+	public:
+		// Starts to allocate from the region of the context
+		void BeginFrame(FrameContext& frame);
+
+		UniformAllocation Allocate(vk::DeviceSize size);
+		template<typename T>
+		uint32_t Push(const T& data)
+		{
+			UniformAllocation alloc = Allocate(sizeof(T));
+			std::memcpy(alloc.data, &data, sizeof(T));
+			return alloc.offset;
+		}
+		// Copies all elements at once (each element is aligned)
+		template<typename T>
+		std::vector<uint32_t> PushArray(const std::vector<T>& data)
+		{
+			std::vector<uint32_t> offsets(data.size());
+			vk::DeviceSize stride = Align(sizeof(T));
+			UniformAllocation alloc = Allocate(stride * data.size());
+			for (size_t i = 0; i < data.size(); i++)
+			{
+				std::memcpy(static_cast<uint8_t*>(alloc.data) + i * stride, &data[i], sizeof(T));
+				offsets[i] = alloc.offset + static_cast<uint32_t>(i * stride);
+			}
+			return offsets;
+		}
+
+		vk::DeviceSize Align(vk::DeviceSize size) const { return m_allocator->Align(size); }
+
+		// Bytes used by the current frame
+		vk::DeviceSize GetUsed() const { return m_allocator->GetUsed(); }
+
+	// Getter for vulkan objects
+	public:
+		vk::Buffer& GetBuffer() { return m_allocator->GetBuffer(); }
+
+	// Internal data
+	private:
+		static constexpr vk::DeviceSize DEFAULT_FRAME_SIZE = 1024 * 1024;
+
+		Scope<LinearAllocator> m_allocator;
+	};
+
+
+} // namespace Helios::Vulkan
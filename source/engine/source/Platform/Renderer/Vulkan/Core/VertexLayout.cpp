@@ -0,0 +1,181 @@
+#include "pch.h"
+#include "VertexLayout.h"
+
+#include <glm/gtc/packing.hpp>
+
+
+namespace Helios::Vulkan {
+
+
+	VertexLayout::VertexLayout(std::initializer_list<std::pair<VertexAttribute, VertexFormat>> elements)
+	{
+		uint32_t location = 0;
+		for (auto& [attribute, format] : elements)
+		{
+			VertexElement element;
+			element.attribute = attribute;
+			element.format = format;
+			element.location = location++;
+			element.offset = m_stride;
+			m_elements.push_back(element);
+
+			m_stride += (GetSize(format) + 3) & ~3u;
+		}
+	}
+
+
+	std::vector<vk::VertexInputBindingDescription> VertexLayout::GetBindingDescriptions(uint32_t binding) const
+	{
+		std::vector<vk::VertexInputBindingDescription> bindingDescriptions(1);
+
+		bindingDescriptions[0].binding = binding;
+		bindingDescriptions[0].stride = m_stride;
+		bindingDescriptions[0].inputRate = vk::VertexInputRate::eVertex;
+
+		return bindingDescriptions;
+	}
+
+
+	std::vector<vk::VertexInputAttributeDescription> VertexLayout::GetAttributeDescriptions(uint32_t binding) const
+	{
+		std::vector<vk::VertexInputAttributeDescription> attributeDescriptions(m_elements.size());
+
+		for (size_t i = 0; i < m_elements.size(); i++)
+		{
+			attributeDescriptions[i].binding = binding;
+			attributeDescriptions[i].location = m_elements[i].location;
+			attributeDescriptions[i].format = GetVulkanFormat(m_elements[i].format);
+			attributeDescriptions[i].offset = m_elements[i].offset;
+		}
+
+		return attributeDescriptions;
+	}
+
+
+	const VertexElement* VertexLayout::Find(VertexAttribute attribute) const
+	{
+		for (auto& element : m_elements)
+		{
+			if (element.attribute == attribute)
+				return &element;
+		}
+		return nullptr;
+	}
+
+
+	void VertexLayout::Write(uint8_t* vertex, VertexAttribute attribute, const glm::vec4& value) const
+	{
+		const VertexElement* element = Find(attribute);
+		if (!element)
+			return;
+
+		uint8_t* dst = vertex + element->offset;
+		switch (element->format)
+		{
+		case VertexFormat::Float2:
+			std::memcpy(dst, &value, sizeof(float) * 2);
+			break;
+		case VertexFormat::Float3:
+			std::memcpy(dst, &value, sizeof(float) * 3);
+			break;
+		case VertexFormat::Float4:
+			std::memcpy(dst, &value, sizeof(float) * 4);
+			break;
+		case VertexFormat::Half2:
+		{
+			uint32_t packed = glm::packHalf2x16(glm::vec2(value));
+			std::memcpy(dst, &packed, sizeof(packed));
+			break;
+		}
+		case VertexFormat::Half4:
+		{
+			uint64_t packed = glm::packHalf4x16(value);
+			std::memcpy(dst, &packed, sizeof(packed));
+			break;
+		}
+		case VertexFormat::Snorm16x2:
+		{
+			uint32_t packed = glm::packSnorm2x16(glm::vec2(value));
+			std::memcpy(dst, &packed, sizeof(packed));
+			break;
+		}
+		case VertexFormat::Snorm16x4:
+		{
+			uint64_t packed = glm::packSnorm4x16(value);
+			std::memcpy(dst, &packed, sizeof(packed));
+			break;
+		}
+		case VertexFormat::Octahedral:
+		{
+			uint32_t packed = glm::packSnorm2x16(EncodeOctahedral(glm::vec3(value)));
+			std::memcpy(dst, &packed, sizeof(packed));
+			break;
+		}
+		case VertexFormat::Unorm8x4:
+		{
+			uint32_t packed = glm::packUnorm4x8(value);
+			std::memcpy(dst, &packed, sizeof(packed));
+			break;
+		}
+		}
+	}
+
+
+	vk::Format VertexLayout::GetVulkanFormat(VertexFormat format)
+	{
+		// All of them are mandatory vertex buffer formats
+		switch (format)
+		{
+		case VertexFormat::Float2:     return vk::Format::eR32G32Sfloat;
+		case VertexFormat::Float3:     return vk::Format::eR32G32B32Sfloat;
+		case VertexFormat::Float4:     return vk::Format::eR32G32B32A32Sfloat;
+		case VertexFormat::Half2:      return vk::Format::eR16G16Sfloat;
+		case VertexFormat::Half4:      return vk::Format::eR16G16B16A16Sfloat;
+		case VertexFormat::Snorm16x2:  return vk::Format::eR16G16Snorm;
+		case VertexFormat::Snorm16x4:  return vk::Format::eR16G16B16A16Snorm;
+		case VertexFormat::Octahedral: return vk::Format::eR16G16Snorm;
+		case VertexFormat::Unorm8x4:   return vk::Format::eR8G8B8A8Unorm;
+		}
+		return vk::Format::eUndefined;
+	}
+
+
+	uint32_t VertexLayout::GetSize(VertexFormat format)
+	{
+		switch (format)
+		{
+		case VertexFormat::Float2:     return 8;
+		case VertexFormat::Float3:     return 12;
+		case VertexFormat::Float4:     return 16;
+		case VertexFormat::Half2:      return 4;
+		case VertexFormat::Half4:      return 8;
+		case VertexFormat::Snorm16x2:  return 4;
+		case VertexFormat::Snorm16x4:  return 8;
+		case VertexFormat::Octahedral: return 4;
+		case VertexFormat::Unorm8x4:   return 4;
+		}
+		return 0;
+	}
+
+
+	glm::vec2 VertexLayout::EncodeOctahedral(glm::vec3 normal)
+	{
+		// Degenerate normals (e.g. of imported meshes) point along z instead of encoding NaN
+		float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+		if (!(length > 0.0f))
+			return { 0.0f, 0.0f };
+
+		// Project onto the octahedron and fold the lower half over the diagonals
+		normal /= length;
+		glm::vec2 encoded = { normal.x, normal.y };
+		if (normal.z < 0.0f)
+		{
+			encoded = {
+				(1.0f - std::abs(normal.y)) * (normal.x >= 0.0f ? 1.0f : -1.0f),
+				(1.0f - std::abs(normal.x)) * (normal.y >= 0.0f ? 1.0f : -1.0f) };
+		}
+		return encoded;
+	}
+
+
+} // namespace Helios::Vulkan
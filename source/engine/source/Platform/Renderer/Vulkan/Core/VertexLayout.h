@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+namespace Helios::Vulkan {
+
+
+	// Meaning of a vertex attribute (the location is given by the layout)
+	enum class VertexAttribute
+	{
+		Position,
+		Normal,
+		Color,
+		TexCoord
+	};
+
+
+	// Storage of a vertex attribute in the vertex buffer.
+	// The shader always reads floats, the vertex input converts them.
+	enum class VertexFormat
+	{
+		Float2,
+		Float3,
+		Float4,
+		// Half floats (good enough for positions of small objects)
+		Half2,
+		Half4,
+		// Normalized to -1...1 (positions have to be scaled into the range)
+		Snorm16x2,
+		Snorm16x4,
+		// Unit vector as octahedral coordinates in two snorm16, decoded in the shader:
+		// n = vec3(e, 1 - |e.x| - |e.y|); if (n.z < 0) n.xy = (1 - |n.yx|) * sign(n.xy); normalize(n)
+		Octahedral,
+		// Colors
+		Unorm8x4
+	};
+
+
+	struct VertexElement
+	{
+		VertexAttribute attribute;
+		VertexFormat format;
+		uint32_t location = 0;
+		// Set by the layout
+		uint32_t offset = 0;
+	};
+
+
+	// Describes the attributes of one interleaved vertex buffer binding.
+	// The vertex input state of pipelines is generated from it and vertices
+	// are packed into the described formats when uploaded.
+	class VertexLayout
+	{
+	public:
+		VertexLayout() = default;
+		// Locations are assigned in order, offsets are packed (4 byte aligned)
+		VertexLayout(std::initializer_list<std::pair<VertexAttribute, VertexFormat>> elements);
+
+	public:
+		std::vector<vk::VertexInputBindingDescription> GetBindingDescriptions(uint32_t binding = 0) const;
+		std::vector<vk::VertexInputAttributeDescription> GetAttributeDescriptions(uint32_t binding = 0) const;
+
+		uint32_t GetStride() const { return m_stride; }
+		const std::vector<VertexElement>& GetElements() const { return m_elements; }
+		// Returns nullptr if the layout does not contain the attribute
+		const VertexElement* Find(VertexAttribute attribute) const;
+
+		// Converts the value into the format of the attribute (vertex points to the start of the vertex)
+		void Write(uint8_t* vertex, VertexAttribute attribute, const glm::vec4& value) const;
+
+		static vk::Format GetVulkanFormat(VertexFormat format);
+		static uint32_t GetSize(VertexFormat format);
+		static glm::vec2 EncodeOctahedral(glm::vec3 normal);
+
+	// Internal data
+	private:
+		std::vector<VertexElement> m_elements;
+		uint32_t m_stride = 0;
+	};
+
+
+} // namespace Helios::Vulkan
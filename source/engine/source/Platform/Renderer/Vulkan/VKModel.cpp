@@ -3,13 +3,21 @@
 
 #include "HeliosEngine/Renderer/Renderer.h"
 #include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+#include "Platform/Renderer/Vulkan/Core/ClusterCulling.h"
+
+#include "HeliosEngine/Core/Config.h"
 
 
 namespace Helios {
 
 
+	// Id 0 is never handed out
+	uint32_t VKModel::s_NextId = 1;
+
+
 	VKModel::VKModel()
 //	VKModel::VKModel(const std::vector<Vertex>& vertices)
+		: m_id(s_NextId++)
 	{
 		LOG_RENDER_DEBUG("VKModel::VKModel()");
 
@@ -24,14 +32,47 @@ namespace Helios {
 	}
 
 
+	VKModel::VKModel(const std::string& filename, const std::string& arcname)
+		: m_id(s_NextId++)
+	{
+		LOG_RENDER_DEBUG("VKModel::VKModel(\"{}\")", filename);
+
+		MeshData mesh;
+		if (!MeshLoader::Load(filename, arcname, mesh))
+			LOG_RENDER_EXCEPT("Failed to load model!");
+
+		CreateVertexBuffers(mesh);
+		CreateIndexBuffer(mesh.Indices);
+		m_lods = mesh.LODs;
+		if (!mesh.Meshlets.empty())
+			CreateMeshletBuffers(mesh);
+	}
+
+
 	VKModel::~VKModel()
 	{
 		LOG_RENDER_DEBUG("VKModel::~VKModel()");
 
-		Scope<Vulkan::Device> &device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
-
-		device->GetLogicalDevice().destroyBuffer(m_vertexBuffer);
-		device->GetLogicalDevice().freeMemory(m_vertexBufferMemory);
+		VKRendererAPI* api = static_cast<VKRendererAPI*>(Renderer::Get());
+
+		// Frames in flight may still read the vertices
+		std::vector<std::pair<vk::Buffer, vk::DeviceMemory>> buffers = {
+			{ m_vertexBuffer, m_vertexBufferMemory },
+			{ m_indexBuffer, m_indexBufferMemory },
+			{ m_meshletBuffer, m_meshletBufferMemory },
+			{ m_meshletIndexBuffer, m_meshletIndexBufferMemory },
+			{ m_meshletVertexBuffer, m_meshletVertexBufferMemory },
+			{ m_meshletTriangleBuffer, m_meshletTriangleBufferMemory },
+			{ m_vertexStorageBuffer, m_vertexStorageBufferMemory } };
+		api->RetireObject([api, buffers]() {
+			for (const auto& [buffer, memory] : buffers)
+			{
+				if (!buffer)
+					continue;
+				api->GetDevice()->GetLogicalDevice().destroyBuffer(buffer);
+				api->GetDevice()->GetLogicalDevice().freeMemory(memory);
+			}
+		});
 	}
 
 
@@ -45,65 +86,222 @@ namespace Helios {
 		vk::Buffer buffers[] = { m_vertexBuffer };
 		vk::DeviceSize offsets[] = { 0 };
 		commandBuffer.bindVertexBuffers(0, 1, buffers, offsets);
+		if (m_indexBuffer)
+			commandBuffer.bindIndexBuffer(m_indexBuffer, 0, vk::IndexType::eUint32);
+	}
+
+
+	void VKModel::vkBindMeshlets(vk::CommandBuffer &commandBuffer)
+	{
+		vk::Buffer buffers[] = { m_vertexBuffer };
+		vk::DeviceSize offsets[] = { 0 };
+		commandBuffer.bindVertexBuffers(0, 1, buffers, offsets);
+		commandBuffer.bindIndexBuffer(m_meshletIndexBuffer, 0, vk::IndexType::eUint32);
 	}
 
 
 	void VKModel::vkDraw(vk::CommandBuffer &commandBuffer)
 	{
-		commandBuffer.draw(m_vertexCount, 1, 0, 0);
+		if (m_indexBuffer)
+			vkDraw(commandBuffer, 0);
+		else
+			commandBuffer.draw(m_vertexCount, 1, 0, 0);
 	}
 
 
-	void VKModel::CreateVertexBuffers(const std::vector<Vertex> &vertices)
+	void VKModel::vkDraw(vk::CommandBuffer &commandBuffer, uint32_t lod)
 	{
-		Scope<Vulkan::Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+		if (m_lods.empty())
+		{
+			vkDraw(commandBuffer);
+			return;
+		}
+
+		const MeshLODData& range = m_lods[std::min(lod, static_cast<uint32_t>(m_lods.size()) - 1)];
+		commandBuffer.drawIndexed(range.IndexCount, 1, range.IndexOffset, 0, 0);
+	}
+
+
+	std::vector<float> VKModel::GetLODErrors() const
+	{
+		std::vector<float> errors;
+		for (const auto& lod : m_lods)
+			errors.push_back(lod.Error);
+		return errors;
+	}
+
 
+	void VKModel::CreateVertexBuffers(const std::vector<Vertex> &vertices)
+	{
 		m_vertexCount = static_cast<uint32_t>(vertices.size());
 		LOG_RENDER_ASSERT(m_vertexCount >= 3, "Vertex count must be at least 3!");
 
-		vk::DeviceSize bufferSize = sizeof(vertices[0]) * m_vertexCount;
+		// Sphere around the center of the bounding box
+		glm::vec2 min = vertices[0].position;
+		glm::vec2 max = vertices[0].position;
+		for (const auto& vertex : vertices)
+		{
+			min = glm::min(min, vertex.position);
+			max = glm::max(max, vertex.position);
+		}
+		glm::vec2 center = (min + max) * 0.5f;
+		float radius = 0.0f;
+		for (const auto& vertex : vertices)
+			radius = std::max(radius, glm::length(vertex.position - center));
+		m_boundingSphere = { center, 0.0f, radius };
+
+		// Pack the vertices into the layout of the pipeline
+		m_layout = &Vertex::GetLayout();
+		const Vulkan::VertexLayout& layout = *m_layout;
+		std::vector<uint8_t> packed(static_cast<size_t>(layout.GetStride()) * m_vertexCount);
+		for (uint32_t i = 0; i < m_vertexCount; i++)
+		{
+			uint8_t* dst = packed.data() + static_cast<size_t>(layout.GetStride()) * i;
+			layout.Write(dst, Vulkan::VertexAttribute::Position, glm::vec4(vertices[i].position, 0.0f, 1.0f));
+			layout.Write(dst, Vulkan::VertexAttribute::Color, vertices[i].color);
+		}
+
+		UploadVertices(packed);
+	}
+
+
+	void VKModel::CreateVertexBuffers(const MeshData &mesh)
+	{
+		m_vertexCount = static_cast<uint32_t>(mesh.Vertices.size());
+		m_boundingSphere = mesh.BoundingSphere;
+
+		// Meshes keep their z (the 2D layout would drop it)
+		m_layout = &Vertex::GetMeshLayout();
+		const Vulkan::VertexLayout& layout = *m_layout;
+		std::vector<uint8_t> packed(static_cast<size_t>(layout.GetStride()) * m_vertexCount);
+		for (uint32_t i = 0; i < m_vertexCount; i++)
+		{
+			uint8_t* dst = packed.data() + static_cast<size_t>(layout.GetStride()) * i;
+			layout.Write(dst, Vulkan::VertexAttribute::Position, glm::vec4(mesh.Vertices[i].pos, 1.0f));
+			layout.Write(dst, Vulkan::VertexAttribute::Color, mesh.Vertices[i].color);
+		}
+
+		UploadVertices(packed);
+	}
+
+
+	void VKModel::UploadVertices(const std::vector<uint8_t> &packed)
+	{
+		CreateHostBuffer(packed.data(), packed.size(), vk::BufferUsageFlagBits::eVertexBuffer, m_vertexBuffer, m_vertexBufferMemory);
+	}
+
+
+	void VKModel::CreateIndexBuffer(const std::vector<uint32_t> &indices)
+	{
+		CreateHostBuffer(indices.data(), sizeof(uint32_t) * indices.size(), vk::BufferUsageFlagBits::eIndexBuffer, m_indexBuffer, m_indexBufferMemory);
+	}
+
+
+	void VKModel::CreateMeshletBuffers(const MeshData &mesh)
+	{
+		Scope<Vulkan::Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		m_meshletCount = static_cast<uint32_t>(mesh.Meshlets.size());
+
+		std::vector<Vulkan::ClusterMeshlet> meshlets(m_meshletCount);
+		std::vector<uint32_t> indices(mesh.MeshletTriangles.size());
+		for (uint32_t i = 0; i < m_meshletCount; i++)
+		{
+			const MeshletData& src = mesh.Meshlets[i];
+			meshlets[i].sphere = src.BoundingSphere;
+			meshlets[i].cone = src.Cone;
+			meshlets[i].vertexOffset = src.VertexOffset;
+			meshlets[i].vertexCount = src.VertexCount;
+			meshlets[i].triangleOffset = src.TriangleOffset;
+			meshlets[i].triangleCount = src.TriangleCount;
+
+			// Triangles of the meshlet with indices into the vertex buffer
+			for (uint32_t j = 0; j < src.TriangleCount * 3; j++)
+				indices[src.TriangleOffset + j] = mesh.MeshletVertices[src.VertexOffset + mesh.MeshletTriangles[src.TriangleOffset + j]];
+		}
+		CreateHostBuffer(meshlets.data(), sizeof(Vulkan::ClusterMeshlet) * meshlets.size(), vk::BufferUsageFlagBits::eStorageBuffer,
+			m_meshletBuffer, m_meshletBufferMemory);
+		CreateHostBuffer(indices.data(), sizeof(uint32_t) * indices.size(), vk::BufferUsageFlagBits::eIndexBuffer,
+			m_meshletIndexBuffer, m_meshletIndexBufferMemory);
+
+		if (!device->GetFeatures().meshShader)
+			return;
+
+		// The mesh shader reads the triangles as uint (four per element)
+		std::vector<uint8_t> triangles = mesh.MeshletTriangles;
+		triangles.resize((triangles.size() + 3) & ~size_t(3), 0);
+		std::vector<glm::vec4> vertices;
+		vertices.reserve(mesh.Vertices.size() * 2);
+		for (const auto& vertex : mesh.Vertices)
+		{
+			vertices.push_back(glm::vec4(vertex.pos, 1.0f));
+			vertices.push_back(vertex.color);
+		}
+		CreateHostBuffer(mesh.MeshletVertices.data(), sizeof(uint32_t) * mesh.MeshletVertices.size(), vk::BufferUsageFlagBits::eStorageBuffer,
+			m_meshletVertexBuffer, m_meshletVertexBufferMemory);
+		CreateHostBuffer(triangles.data(), triangles.size(), vk::BufferUsageFlagBits::eStorageBuffer,
+			m_meshletTriangleBuffer, m_meshletTriangleBufferMemory);
+		CreateHostBuffer(vertices.data(), sizeof(glm::vec4) * vertices.size(), vk::BufferUsageFlagBits::eStorageBuffer,
+			m_vertexStorageBuffer, m_vertexStorageBufferMemory);
+	}
+
+
+	void VKModel::CreateHostBuffer(const void *data, vk::DeviceSize size, vk::BufferUsageFlags usage, vk::Buffer &buffer, vk::DeviceMemory &bufferMemory)
+	{
+		Scope<Vulkan::Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
 		device->CreateBuffer(
-			bufferSize,
-			vk::BufferUsageFlagBits::eVertexBuffer,
+			size,
+			usage,
 			vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-			m_vertexBuffer,
-			m_vertexBufferMemory);
+			buffer,
+			bufferMemory);
 
-		void* data = device->GetLogicalDevice().mapMemory(m_vertexBufferMemory, 0, bufferSize);
-		memcpy(data, vertices.data(), static_cast<size_t>(bufferSize));
-		device->GetLogicalDevice().unmapMemory(m_vertexBufferMemory);
+		void* mapped = device->GetLogicalDevice().mapMemory(bufferMemory, 0, size);
+		memcpy(mapped, data, static_cast<size_t>(size));
+		device->GetLogicalDevice().unmapMemory(bufferMemory);
 	}
 
 
-	std::vector<vk::VertexInputBindingDescription> VKModel::Vertex::GetBindingDescriptions()
+	const Vulkan::VertexLayout& VKModel::Vertex::GetLayout()
 	{
-		std::vector<vk::VertexInputBindingDescription> bindingDescriptions(1);
+		// Location 0: position, location 1: color (the shaders read floats either way)
+		static const Vulkan::VertexLayout s_full = {
+			{ Vulkan::VertexAttribute::Position, Vulkan::VertexFormat::Float2 },
+			{ Vulkan::VertexAttribute::Color, Vulkan::VertexFormat::Float4 } };
+		static const Vulkan::VertexLayout s_compact = {
+			{ Vulkan::VertexAttribute::Position, Vulkan::VertexFormat::Half2 },
+			{ Vulkan::VertexAttribute::Color, Vulkan::VertexFormat::Unorm8x4 } };
+		static const bool s_useFull = Config::Get("VertexFormat", "compact") == "full";
+
+		return s_useFull ? s_full : s_compact;
+	}
 
-		bindingDescriptions[0].binding = 0;
-		bindingDescriptions[0].stride = sizeof(Vertex);
-		bindingDescriptions[0].inputRate = vk::VertexInputRate::eVertex;
 
-		return bindingDescriptions;
+	const Vulkan::VertexLayout& VKModel::Vertex::GetMeshLayout()
+	{
+		// Positions stay 32 bit floats, halfs lose too much precision away from the origin
+		static const Vulkan::VertexLayout s_full = {
+			{ Vulkan::VertexAttribute::Position, Vulkan::VertexFormat::Float3 },
+			{ Vulkan::VertexAttribute::Color, Vulkan::VertexFormat::Float4 } };
+		static const Vulkan::VertexLayout s_compact = {
+			{ Vulkan::VertexAttribute::Position, Vulkan::VertexFormat::Float3 },
+			{ Vulkan::VertexAttribute::Color, Vulkan::VertexFormat::Unorm8x4 } };
+		static const bool s_useFull = Config::Get("VertexFormat", "compact") == "full";
+
+		return s_useFull ? s_full : s_compact;
 	}
 
 
-	std::vector<vk::VertexInputAttributeDescription> VKModel::Vertex::GetAttributeDescriptions()
+	std::vector<vk::VertexInputBindingDescription> VKModel::Vertex::GetBindingDescriptions()
 	{
-		std::vector<vk::VertexInputAttributeDescription> attributeDescriptions(2);
-
-		// Vertex position
-		attributeDescriptions[0].binding = 0;
-		attributeDescriptions[0].location = 0;
-		attributeDescriptions[0].format = vk::Format::eR32G32Sfloat;
-		attributeDescriptions[0].offset = offsetof(Vertex, position);
+		return GetLayout().GetBindingDescriptions();
+	}
 
-		// Vertex color
-		attributeDescriptions[1].binding = 0;
-		attributeDescriptions[1].location = 1;
-		attributeDescriptions[1].format = vk::Format::eR32G32B32A32Sfloat;
-		attributeDescriptions[1].offset = offsetof(Vertex, color);
 
-		return attributeDescriptions;
+	std::vector<vk::VertexInputAttributeDescription> VKModel::Vertex::GetAttributeDescriptions()
+	{
+		return GetLayout().GetAttributeDescriptions();
 	}
 
 
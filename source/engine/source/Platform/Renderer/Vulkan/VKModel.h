@@ -1,9 +1,12 @@
 #pragma once
 
 #include "HeliosEngine/Renderer/Model.h"
+#include "HeliosEngine/Renderer/MeshLoader.h"
 
 #include <vulkan/vulkan.hpp>
 
+#include "Platform/Renderer/Vulkan/Core/VertexLayout.h"
+
 //#include "Platform/Renderer/Vulkan/Core/Instance.h"
 //#include "Platform/Renderer/Vulkan/Core/Device.h"
 //#include "Platform/Renderer/Vulkan/Core/Swapchain.h"
@@ -20,6 +23,7 @@ namespace Helios {
 
 //		VKModel(const std::vector<Vertex>& vertices);
 		VKModel();
+		VKModel(const std::string& filename, const std::string& arcname);
 		~VKModel();
 
 		void Draw();
@@ -27,25 +31,87 @@ namespace Helios {
 	// Methods for internal usage in the Helios::Vulkan namespace
 	public:
 
+		// Source data of a vertex, packed into the layout when uploaded
 		struct Vertex
 		{
 			glm::vec2 position;
 			glm::vec4 color;
 
+			// Compact (half positions, RGBA8 colors) unless Config "VertexFormat" is "full"
+			static const Vulkan::VertexLayout& GetLayout();
+			// 3D positions (always floats), used by loaded meshes (Shader/mesh.vert)
+			static const Vulkan::VertexLayout& GetMeshLayout();
 			static std::vector<vk::VertexInputBindingDescription> GetBindingDescriptions();
 			static std::vector<vk::VertexInputAttributeDescription> GetAttributeDescriptions();
 		};
 
 		void vkBind(vk::CommandBuffer &commandBuffer);
+		// Vertex buffer with the meshlet index buffer (draws of the cluster culling)
+		void vkBindMeshlets(vk::CommandBuffer &commandBuffer);
 		void vkDraw(vk::CommandBuffer &commandBuffer);
+		// Draws the index range of the LOD (clamped to the coarsest one)
+		void vkDraw(vk::CommandBuffer &commandBuffer, uint32_t lod);
+
+		uint32_t GetVertexCount() const { return m_vertexCount; }
+		// Small id for sort keys and bind tracking (never reused)
+		uint32_t GetId() const { return m_id; }
+		// Layout of the vertex buffer, pipelines drawing the model need the same one
+		const Vulkan::VertexLayout& GetLayout() const { return *m_layout; }
+		uint32_t GetLODCount() const { return static_cast<uint32_t>(m_lods.size()); }
+		// Loaded from a mesh file (indexed, drawn with the mesh layout)
+		bool IsMesh() const { return !m_lods.empty(); }
+		// Geometric error per LOD (for Component::MeshLOD)
+		std::vector<float> GetLODErrors() const;
+
+		// Meshlets of LOD 0 (see Vulkan::ClusterCulling)
+		uint32_t GetMeshletCount() const { return m_meshletCount; }
+		vk::Buffer& GetMeshletBuffer() { return m_meshletBuffer; }
+		vk::Buffer& GetMeshletIndexBuffer() { return m_meshletIndexBuffer; }
+		vk::Buffer& GetMeshletVertexBuffer() { return m_meshletVertexBuffer; }
+		vk::Buffer& GetMeshletTriangleBuffer() { return m_meshletTriangleBuffer; }
+		vk::Buffer& GetVertexStorageBuffer() { return m_vertexStorageBuffer; }
+		// Bounding sphere in model space (xyz center, w radius)
+		const glm::vec4& GetBoundingSphere() const { return m_boundingSphere; }
 
 	// Vertex data
 	private:
 		void CreateVertexBuffers(const std::vector<Vertex> &vertices);
+		void CreateVertexBuffers(const MeshData &mesh);
+		void UploadVertices(const std::vector<uint8_t> &packed);
+		void CreateIndexBuffer(const std::vector<uint32_t> &indices);
+		void CreateMeshletBuffers(const MeshData &mesh);
+		void CreateHostBuffer(const void *data, vk::DeviceSize size, vk::BufferUsageFlags usage, vk::Buffer &buffer, vk::DeviceMemory &bufferMemory);
 
 		vk::Buffer m_vertexBuffer;
 		vk::DeviceMemory m_vertexBufferMemory;
 		uint32_t m_vertexCount;
+		glm::vec4 m_boundingSphere{0.f};
+		const Vulkan::VertexLayout* m_layout = nullptr;
+		uint32_t m_id;
+		static uint32_t s_NextId;
+
+	// Index data (meshes only)
+	private:
+		vk::Buffer m_indexBuffer;
+		vk::DeviceMemory m_indexBufferMemory;
+		std::vector<MeshLODData> m_lods;
+
+	// Meshlet data (meshes only)
+	private:
+		// Bounds and ranges of the meshlets (Vulkan::ClusterMeshlet)
+		vk::Buffer m_meshletBuffer;
+		vk::DeviceMemory m_meshletBufferMemory;
+		// Triangles of all meshlets with indices into the vertex buffer (indirect draws)
+		vk::Buffer m_meshletIndexBuffer;
+		vk::DeviceMemory m_meshletIndexBufferMemory;
+		// Mesh shaders only: meshlet vertices, packed triangles and the vertices as storage buffer
+		vk::Buffer m_meshletVertexBuffer;
+		vk::DeviceMemory m_meshletVertexBufferMemory;
+		vk::Buffer m_meshletTriangleBuffer;
+		vk::DeviceMemory m_meshletTriangleBufferMemory;
+		vk::Buffer m_vertexStorageBuffer;
+		vk::DeviceMemory m_vertexStorageBufferMemory;
+		uint32_t m_meshletCount = 0;
 	};
 
 
@@ -1,7 +1,15 @@
 #include "pch.h"
 #include "VKRendererAPI.h"
 
+#include "HeliosEngine/Core/Application.h"
 #include "HeliosEngine/Core/Assets.h"
+#include "HeliosEngine/Core/Config.h"
+#include "HeliosEngine/Core/Timer.h"
+#include "HeliosEngine/ECS/ECS.h"
+#include "HeliosEngine/ECS/Components.h"
+#include "HeliosEngine/Renderer/LODSelector.h"
+
+#include "Platform/Renderer/Vulkan/VKTexture.h"
 
 
 namespace Helios {
@@ -15,17 +23,139 @@ namespace Helios {
 	};
 
 
+	// Uniform data (std140 layout)
+	struct CameraUniformData
+	{
+		glm::mat4 viewProjection{1.f};
+	};
+
+	struct ObjectUniformData
+	{
+		glm::mat4 transform{1.f};
+	};
+
+	struct MaterialUniformData
+	{
+		glm::vec4 color{1.f};
+		// Index into the bindless textures
+		uint32_t textureIndex = Vulkan::BindlessSet::INVALID_INDEX;
+	};
+
+
 	void VKRendererAPI::Init()
 	{
 		LOG_RENDER_DEBUG("Initializing vulkan renderer...");
 
+		// Startup phases are timed to spot slow driver queries
+		Timer totalTimer;
+		Timer phaseTimer;
+		auto logPhase = [&](const char* phase) {
+			LOG_RENDER_DEBUG("Startup: {} took {:.2f} ms", phase, phaseTimer.ElapsedMillis());
+			phaseTimer.Reset();
+		};
+
 		m_Instance = CreateScope<Vulkan::Instance>();
+		logPhase("instance");
 		m_Device = CreateScope<Vulkan::Device>();
+		logPhase("device");
+		m_Frames = CreateScope<Vulkan::FrameRing>(Vulkan::FrameRing::QueryFramesInFlight());
+		m_DeletionQueue = CreateScope<Vulkan::DeletionQueue>();
+		m_GPUProfiler = CreateScope<Vulkan::GPUProfiler>(m_Frames->GetFramesInFlight());
+		m_FrameCapture = CreateScope<Vulkan::FrameCapture>(m_Frames->GetFramesInFlight());
+		m_Descriptors = CreateScope<Vulkan::DescriptorAllocator>(m_Frames->GetFramesInFlight());
+		m_Uniforms = CreateScope<Vulkan::UniformRing>(m_Frames->GetFramesInFlight());
+		vk::DeviceSize transientSize = std::strtoull(Config::Get("TransientMemory", "4096").c_str(), nullptr, 10) * 1024;
+		// Read by the async compute queue too (e.g. the objects of the GPU culling)
+		const Vulkan::QueueFamilyIndices& families = m_Device->GetQueueFamilies();
+		std::vector<uint32_t> transientFamilies = { families.graphicsFamily.value() };
+		if (m_Device->GetFeatures().asyncCompute and families.computeFamily.value() != families.graphicsFamily.value())
+			transientFamilies.push_back(families.computeFamily.value());
+		m_Transient = CreateScope<Vulkan::LinearAllocator>("Transient", m_Frames->GetFramesInFlight(), transientSize ? transientSize : 4096 * 1024,
+			vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer |
+			vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer,
+			m_Device->GetCaps().properties.limits.minStorageBufferOffsetAlignment, transientFamilies);
+		m_Frames->SetArenas(m_Transient.get(), m_Uniforms.get());
+		if (m_Device->GetFeatures().descriptorIndexing)
+			m_Bindless = CreateScope<Vulkan::BindlessSet>();
+		m_TextureStreamer = CreateScope<Vulkan::TextureStreamer>(m_Frames->GetFramesInFlight());
+		m_MSAASamples = m_Device->QueryMSAASamples();
+		logPhase("frame objects");
 
 		CreatePipelineLayout();
-		RecreateSwapchain();
+		// Both draw paths take the indirect draws
+		if (Vulkan::GPUCulling::IsAvailable())
+			m_GPUCulling = CreateScope<Vulkan::GPUCulling>(m_Frames->GetFramesInFlight());
+		else
+			LOG_RENDER_WARN("GPU culling shader not found, drawing without culling!");
+		if (Vulkan::ClusterCulling::IsAvailable())
+			m_ClusterCulling = CreateScope<Vulkan::ClusterCulling>(m_Frames->GetFramesInFlight());
+		else
+			LOG_RENDER_WARN("Cluster culling shader not found, drawing meshes without meshlets!");
+		logPhase("pipeline layout");
+		if (Application::Get().IsHeadless())
+		{
+			const ApplicationSpecification& spec = Application::Get().GetSpecification();
+			m_RenderTarget = CreateRef<Vulkan::Offscreen>(vk::Extent2D{ spec.Width, spec.Height }, m_Frames->GetFramesInFlight());
+			BuildRenderGraph();
+			CreatePipeline();
+		}
+		else
+			RecreateSwapchain();
+		logPhase("render target and pipeline");
 
 		m_model = CreateRef<VKModel>();
+		// Checker texture of the demo objects (sampled through the bindless set)
+		if (m_UseBindless)
+		{
+			TextureSpecification spec;
+			spec.Width = 2;
+			spec.Height = 2;
+			spec.GenerateMips = false;
+			m_Texture = Texture2D::Create(spec);
+			const uint32_t pixels[4] = { 0xFFFFFFFF, 0xFF808080, 0xFF808080, 0xFFFFFFFF };
+			m_Texture->SetData(pixels, sizeof(pixels));
+		}
+
+		// Demo objects are entities, so they go through the culling of the scene
+		m_Culling = CreateScope<CullingSystem>();
+		entt::registry& registry = ECS::Registry();
+		const glm::vec4& sphere = m_model->GetBoundingSphere();
+		for (int i = 0; i < 4; i++)
+		{
+			entt::entity entity = registry.create();
+			registry.emplace<Component::Transform>(entity);
+			registry.emplace<Component::Bounds>(entity, glm::vec3(sphere), glm::vec3(sphere.w));
+			// Every other object is textured
+			registry.emplace<Renderable>(entity, Renderable{ m_model, { 0.0f, 0.0f, 0.2f + i * 0.2f, 1.0f }, i % 2 == 0 });
+			m_Entities.push_back(entity);
+		}
+
+		// Mesh with LODs beside the demo objects
+		std::string meshFile = Config::Get("DemoMesh", "");
+		if (!meshFile.empty())
+		{
+			if (!m_UseMeshes)
+				LOG_RENDER_WARN("Mesh shader not found, \"{}\" is not drawn!", meshFile);
+			else if (!Assets::Exist(meshFile))
+				LOG_RENDER_WARN("Demo mesh \"{}\" not found!", meshFile);
+			else
+			{
+				Ref<VKModel> mesh = CreateRef<VKModel>(meshFile, "");
+				const glm::vec4& bounds = mesh->GetBoundingSphere();
+				m_MeshEntity = registry.create();
+				auto& transform = registry.emplace<Component::Transform>(m_MeshEntity);
+				// Upright and facing the camera (its up is -y, it looks along +z)
+				transform.rotation = { glm::pi<float>(), 0.0f, 0.0f };
+				// About the size of the demo objects
+				transform.scale = glm::vec3(bounds.w > 0.0f ? 0.25f / bounds.w : 1.0f);
+				registry.emplace<Component::Bounds>(m_MeshEntity, glm::vec3(bounds), glm::vec3(bounds.w));
+				registry.emplace<Component::MeshLOD>(m_MeshEntity, mesh->GetLODErrors(), bounds.w);
+				registry.emplace<Renderable>(m_MeshEntity, Renderable{ mesh, { 1.0f, 1.0f, 1.0f, 1.0f }, false });
+			}
+		}
+		logPhase("model");
+
+		LOG_RENDER_INFO("Vulkan renderer initialized in {:.2f} ms", totalTimer.ElapsedMillis());
 	}
 
 
@@ -35,14 +165,38 @@ namespace Helios {
 
 		m_Device->GetLogicalDevice().waitIdle();
 
+		ECS::Registry().destroy(m_Entities.begin(), m_Entities.end());
+		m_Entities.clear();
+		if (m_MeshEntity != entt::null)
+			ECS::Registry().destroy(m_MeshEntity);
+		m_MeshEntity = entt::null;
+		m_Culling.reset();
 		m_model.reset();
+		m_Texture.reset();
+		m_FrameCapture.reset();
 
 		m_Pipeline.reset();
+		m_MeshPipeline.reset();
+		m_GPUCulling.reset();
+		m_ClusterCulling.reset();
+		m_RenderGraph.reset();
+		m_DeletionQueue->ReleaseAll();
 
 		if (m_vkPipelineLayout)
 			m_Device->GetLogicalDevice().destroyPipelineLayout(m_vkPipelineLayout);
+		m_FrameSetLayout.reset();
 
+		m_TextureStreamer.reset();
+		m_Bindless.reset();
+		m_Transient.reset();
+		m_Uniforms.reset();
+		m_Descriptors.reset();
+
+		m_RenderTarget.reset();
 		m_Swapchain.reset();
+		m_GPUProfiler.reset();
+		m_DeletionQueue.reset();
+		m_Frames.reset();
 		m_Device.reset();
 		m_Instance.reset();
 	}
@@ -50,22 +204,44 @@ namespace Helios {
 
 	void VKRendererAPI::Render()
 	{
+		Vulkan::FrameContext& frame = m_Frames->BeginFrame();
+		m_DeletionQueue->Release(m_Frames->GetCompletedFrame());
+		m_FrameCapture->BeginFrame(frame);
+		m_Descriptors->BeginFrame(frame);
+		m_Uniforms->BeginFrame(frame);
+		m_Transient->BeginFrame(frame);
+		if (m_Bindless)
+			m_Bindless->BeginFrame(m_Frames->GetCompletedFrame());
+
+		if (m_SwapchainDirty)
+			RecreateSwapchain();
+
 		uint32_t imageIndex;
-		auto result = m_Swapchain->AcquireNextFrameIndex(&imageIndex);
+		auto result = m_RenderTarget->AcquireNextImage(frame, &imageIndex);
 		if (result == vk::Result::eErrorOutOfDateKHR)
 		{
-//			RecreateSwapchain();
-			return;
+			// Try again with a fresh swapchain instead of dropping the frame
+			RecreateSwapchain();
+			result = m_RenderTarget->AcquireNextImage(frame, &imageIndex);
+			if (result == vk::Result::eErrorOutOfDateKHR)
+			{
+				// Dropped, the context is free again for the next frame
+				m_Frames->EndFrame();
+				return;
+			}
 		}
 		if (result != vk::Result::eSuccess && result != vk::Result::eSuboptimalKHR)
 			LOG_RENDER_EXCEPT("Failed to aquire swap chain image!");
 
-		RecordDrawCommands(imageIndex);
+		RecordDrawCommands(frame, imageIndex);
+		m_Frames->Submit(frame, m_RenderTarget->GetRenderFinished(imageIndex));
+		m_GPUProfiler->EndFrame(frame);
 
-		result = m_Swapchain->SubmitCommandBuffer(imageIndex);
+		result = m_RenderTarget->Present(frame, imageIndex);
+		m_Frames->EndFrame();
 		if (result == vk::Result::eErrorOutOfDateKHR || result == vk::Result::eSuboptimalKHR)
 		{
-//			RecreateSwapchain();
+			m_SwapchainDirty = true;
 			return;
 		}
 		if (result != vk::Result::eSuccess)
@@ -83,27 +259,115 @@ namespace Helios {
 	{
 		LOG_RENDER_TRACE("OnFramebufferResize - width:{} height:{}", width, height);
 
-		if (width == 0 or height == 0)
+		if (width == 0 or height == 0 or !m_Swapchain)
+			return;
+
+		m_SwapchainDirty = true;
+	}
+
+
+	void VKRendererAPI::OnPresentModeChanged()
+	{
+		LOG_RENDER_TRACE("OnPresentModeChanged - mode:{}", RendererAPI::GetPresentModeString());
+
+		if (!m_Swapchain)
 			return;
 
-		RecreateSwapchain();
+		m_SwapchainDirty = true;
+	}
+
+
+	RenderQueueStats VKRendererAPI::GetRenderQueueStats()
+	{
+		return m_RenderQueue.GetStats();
+	}
+
+
+	float VKRendererAPI::GetGPUFrameTime()
+	{
+		if (!m_GPUProfiler or !m_GPUProfiler->IsSupported())
+			return 0.0f;
+
+		return m_GPUProfiler->GetFrameTime();
+	}
+
+
+	void VKRendererAPI::CaptureFrame(const std::string& path)
+	{
+		m_FrameCapture->RequestCapture(path);
+	}
+
+
+	void VKRendererAPI::StartCaptureStream(const std::string& prefix, uint32_t interval, const std::string& format)
+	{
+		if (interval == 0)
+		{
+			m_FrameCapture->StopStream();
+			return;
+		}
+		std::optional<Vulkan::FrameCapture::Format> captureFormat = Vulkan::FrameCapture::GetFormatFromExtension(format);
+		if (!captureFormat)
+		{
+			LOG_RENDER_WARN("Unsupported capture format: \"{}\" (use ppm or raw)", format);
+			return;
+		}
+		m_FrameCapture->StartStream(prefix, interval, captureFormat.value());
+	}
+
+
+	void VKRendererAPI::StopCaptureStream()
+	{
+		m_FrameCapture->StopStream();
 	}
 
 
 	void VKRendererAPI::CreatePipelineLayout()
 	{
+		// The shaders using uniform buffers are optional until all platforms ship them
+		m_UseUniforms =
+			Assets::Exist("Shader/object.vert.spv", "RendererVulkan") and
+			Assets::Exist("Shader/object.frag.spv", "RendererVulkan");
+		if (m_UseUniforms)
+		{
+			m_FrameSetLayout = CreateScope<Vulkan::DescriptorSetLayout>(std::vector<vk::DescriptorSetLayoutBinding>{
+				Vulkan::DescriptorSetLayout::Binding(0, vk::DescriptorType::eUniformBufferDynamic, vk::ShaderStageFlagBits::eVertex),
+				Vulkan::DescriptorSetLayout::Binding(1, vk::DescriptorType::eUniformBufferDynamic, vk::ShaderStageFlagBits::eVertex),
+				Vulkan::DescriptorSetLayout::Binding(2, vk::DescriptorType::eUniformBufferDynamic, vk::ShaderStageFlagBits::eFragment),
+			});
+		}
+		else
+			LOG_RENDER_WARN("Uniform buffer shaders not found, using push constants!");
+		// Textures are only sampled through the bindless set
+		m_UseBindless = m_UseUniforms and m_Bindless and
+			Assets::Exist("Shader/object_bindless.frag.spv", "RendererVulkan");
+		// Same bindings as the objects
+		m_UseMeshes = m_UseUniforms and
+			Assets::Exist("Shader/mesh.vert.spv", "RendererVulkan");
+
 		vk::PushConstantRange pushConstantRange = vk::PushConstantRange();
 		{
 			pushConstantRange.stageFlags = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment;
 			pushConstantRange.offset = 0;
 			pushConstantRange.size = sizeof(SimplePushConstantData);
 		}
+		std::vector<vk::DescriptorSetLayout> setLayouts;
+		if (m_UseUniforms)
+			setLayouts.push_back(m_FrameSetLayout->GetLayout());
+		if (m_UseBindless)
+			setLayouts.push_back(m_Bindless->GetLayout());
+
 		vk::PipelineLayoutCreateInfo layoutInfo = vk::PipelineLayoutCreateInfo();
 		{
-			layoutInfo.setLayoutCount = 0;
-			layoutInfo.pSetLayouts = nullptr;
-			layoutInfo.pushConstantRangeCount = 1;
-			layoutInfo.pPushConstantRanges = &pushConstantRange;
+			if (m_UseUniforms)
+			{
+				layoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+				layoutInfo.pSetLayouts = setLayouts.data();
+			}
+			else
+			{
+				layoutInfo.pushConstantRangeCount = 1;
+				layoutInfo.pPushConstantRanges = &pushConstantRange;
+			}
 		}
 		try {
 			LOG_RENDER_TRACE("Creating pipeline layout...");
@@ -117,23 +381,66 @@ namespace Helios {
 
 	void VKRendererAPI::CreatePipeline()
 	{
-		m_Pipeline.reset();
+		// The current pipeline might still be in use by frames in flight
+		if (m_Pipeline)
+			RetireObject(Ref<Vulkan::Pipeline>(std::move(m_Pipeline)));
+		if (m_MeshPipeline)
+			RetireObject(Ref<Vulkan::Pipeline>(std::move(m_MeshPipeline)));
 
 		Vulkan::PipelineConfigInfo pipelineConfig{};
 		Vulkan::Pipeline::DefaultConfigInfo(pipelineConfig);
-		pipelineConfig.renderPass = m_Swapchain->GetRenderPass();
+		m_RenderGraph->SetupPipelineConfig(m_MainPass, pipelineConfig);
 		pipelineConfig.pipelineLayout = m_vkPipelineLayout;
 
+		std::string fragShader = m_UseBindless ? "Shader/object_bindless.frag.spv" : m_UseUniforms ? "Shader/object.frag.spv" : "Shader/test.frag.spv";
 		m_Pipeline = CreateScope<Vulkan::Pipeline>(
-			"Shader/test.vert.spv",
-			"Shader/test.frag.spv",
+			m_UseUniforms ? "Shader/object.vert.spv" : "Shader/test.vert.spv",
+			fragShader,
 			pipelineConfig);
+		if (m_UseMeshes)
+		{
+			pipelineConfig.vertexLayout = &VKModel::Vertex::GetMeshLayout();
+			m_MeshPipeline = CreateScope<Vulkan::Pipeline>("Shader/mesh.vert.spv", fragShader, pipelineConfig);
+		}
+
+		// Same pass, but with the layout of the mesh shaders
+		if (m_ClusterCulling)
+			m_ClusterCulling->CreateMeshPipeline(pipelineConfig);
+	}
+
+
+	vk::DescriptorSet VKRendererAPI::CreateFrameDescriptorSet(Vulkan::FrameContext& frame)
+	{
+		vk::DescriptorSet set = m_Descriptors->Allocate(frame, m_FrameSetLayout->GetLayout());
+
+		// All bindings point to the start of the ring, the data is selected by dynamic offsets
+		std::array<vk::DescriptorBufferInfo, 3> bufferInfos = {
+			vk::DescriptorBufferInfo(m_Uniforms->GetBuffer(), 0, sizeof(CameraUniformData)),
+			vk::DescriptorBufferInfo(m_Uniforms->GetBuffer(), 0, sizeof(ObjectUniformData)),
+			vk::DescriptorBufferInfo(m_Uniforms->GetBuffer(), 0, sizeof(MaterialUniformData)),
+		};
+		std::array<vk::WriteDescriptorSet, 3> writes;
+		for (uint32_t i = 0; i < writes.size(); i++)
+		{
+			writes[i] = vk::WriteDescriptorSet();
+			{
+				writes[i].dstSet = set;
+				writes[i].dstBinding = i;
+				writes[i].dstArrayElement = 0;
+				writes[i].descriptorCount = 1;
+				writes[i].descriptorType = vk::DescriptorType::eUniformBufferDynamic;
+				writes[i].pBufferInfo = &bufferInfos[i];
+			}
+		}
+		m_Device->GetLogicalDevice().updateDescriptorSets(writes, nullptr);
+
+		return set;
 	}
 
 
-	void VKRendererAPI::RecordDrawCommands(uint32_t imageIndex)
+	void VKRendererAPI::RecordDrawCommands(Vulkan::FrameContext& frame, uint32_t imageIndex)
 	{
-		vk::CommandBuffer& commandBuffer = m_Swapchain->GetCommandBuffer(imageIndex);
+		vk::CommandBuffer& commandBuffer = frame.commandBuffer;
 		commandBuffer.reset();
 
 		vk::CommandBufferBeginInfo beginInfo = vk::CommandBufferBeginInfo();
@@ -146,71 +453,358 @@ namespace Helios {
 			LOG_RENDER_EXCEPT("Failed to begin recording command buffer!");
 		}
 
-		vk::RenderPassBeginInfo renderPassInfo = vk::RenderPassBeginInfo();
+		m_GPUProfiler->BeginFrame(frame);
 		{
-			std::array<vk::ClearValue, 2> clearValues{};
-			clearValues[0].color = vk::ClearColorValue{ 0.01f, 0.01f, 0.01f, 1.0f };
-			clearValues[1].depthStencil = vk::ClearDepthStencilValue{ 1.0f, 0 };
-			renderPassInfo.renderPass = m_Swapchain->GetRenderPass();
-			renderPassInfo.framebuffer = m_Swapchain->GetFrameBuffer(imageIndex);
-			renderPassInfo.renderArea.offset.x = 0;
-			renderPassInfo.renderArea.offset.y = 0;
-			renderPassInfo.renderArea.extent = m_Swapchain->GetExtent();
-			renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
-			renderPassInfo.pClearValues = clearValues.data();
+			Vulkan::GPUProfileScope frameScope(*m_GPUProfiler, commandBuffer, "Frame");
+
+			if (!m_TextureStreamer->IsIdle())
+			{
+				Vulkan::GPUProfileScope uploadScope(*m_GPUProfiler, commandBuffer, "Upload");
+				m_TextureStreamer->Record(frame);
+			}
+
+			UpdateCamera();
+			UpdateObjects();
+			if (m_GPUCulling)
+			{
+				std::vector<Vulkan::CullObject> objects;
+				for (const auto& object : m_Objects)
+				{
+					if (object.indirect == UINT32_MAX)
+						continue;
+					Vulkan::CullObject& cullObject = objects.emplace_back();
+					cullObject.transform = object.transform;
+					cullObject.sphere = object.model->GetBoundingSphere();
+					cullObject.vertexCount = object.model->GetVertexCount();
+				}
+
+				// Only measured if it is not running on the async compute queue
+				if (m_GPUCulling->IsAsync())
+					m_GPUCulling->Cull(frame, m_Camera.viewProjection, objects);
+				else
+				{
+					Vulkan::GPUProfileScope cullScope(*m_GPUProfiler, commandBuffer, "Culling");
+					m_GPUCulling->Cull(frame, m_Camera.viewProjection, objects);
+				}
+			}
+
+			// Meshes at LOD 0 are culled per meshlet (the meshlets only cover LOD 0),
+			// with mesh shaders by the task shader of the draw
+			if (m_ClusterCulling)
+			{
+				bool meshShader = m_ClusterCulling->UsesMeshShader();
+				for (auto& object : m_Objects)
+				{
+					if (object.lod != 0 or object.model->GetMeshletCount() == 0)
+						continue;
+					if (meshShader)
+						object.meshTasks = static_cast<bool>(object.model->GetVertexStorageBuffer());
+					else
+						object.cluster = m_ClusterCulling->Cull(frame, *object.model, object.transform, m_Camera.viewProjection, m_Camera.position);
+				}
+			}
+
+			m_RenderGraph->Execute(frame, imageIndex);
 		}
-		commandBuffer.beginRenderPass(&renderPassInfo, vk::SubpassContents::eInline);
 
-		vk::Viewport viewport = vk::Viewport();
 		{
-			viewport.x = 0.0f;
-			viewport.y = 0.0f;
-			viewport.width = static_cast<float>(m_Swapchain->GetExtent().width);
-			viewport.height = static_cast<float>(m_Swapchain->GetExtent().height);
-			viewport.minDepth = 0.0f;
-			viewport.maxDepth = 1.0f;
+			Vulkan::GPUProfileScope captureScope(*m_GPUProfiler, commandBuffer, "Capture");
+			m_FrameCapture->Record(frame, *m_RenderTarget, imageIndex);
 		}
-		vk::Rect2D scissor({ 0, 0 }, m_Swapchain->GetExtent());
-		commandBuffer.setViewport(0, 1, &viewport);
-		commandBuffer.setScissor(0, 1, &scissor);
 
-		m_Pipeline->Bind(commandBuffer);
+		try {
+			commandBuffer.end();
+		}
+		catch (vk::SystemError err) {
+			LOG_RENDER_EXCEPT("Failed to end recording command buffer!");
+		}
+	}
 
-		static int frame = 0;
-		frame = (frame + 1) % 1000;
 
-		m_model->vkBind(commandBuffer);
-		for (int i = 0; i < 4; i++)
+	void VKRendererAPI::RecordMainPass(Vulkan::FrameContext& frame, vk::CommandBuffer commandBuffer)
+	{
+		uint32_t count = static_cast<uint32_t>(m_Objects.size());
+
+		// Sort the draws by their state, equal state front to back
+		m_RenderQueue.Clear();
+		m_MainDraws.clear();
+		for (uint32_t i = 0; i < count; i++)
 		{
-			SimplePushConstantData push{};
-			push.offset = { -0.5f + frame * 0.002f, -0.4f + i * 0.25f };
-			push.color = { 0.0f, 0.0f, 0.2f + i * 0.2f };
-			commandBuffer.pushConstants(m_vkPipelineLayout, vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment, 0, sizeof(SimplePushConstantData), &push);
-			m_model->vkDraw(commandBuffer);
+			glm::vec4 clip = m_Camera.viewProjection * m_Objects[i].transform[3];
+			float depth = (clip.w > 0.0f) ? clip.z / clip.w : 0.0f;
+			Vulkan::Pipeline* pipeline =
+				m_Objects[i].meshTasks ? m_ClusterCulling->GetMeshPipeline() :
+				m_Objects[i].model->IsMesh() ? m_MeshPipeline.get() : m_Pipeline.get();
+			// Materials only differ by their texture so far
+			m_RenderQueue.Submit(RenderKey::Make(0, pipeline->GetId(), m_Objects[i].textured ? 1 : 0, m_Objects[i].model->GetId(), depth));
+			m_MainDraws.push_back({ pipeline, m_Objects[i].model, i });
 		}
+		m_RenderQueue.Sort();
 
-		commandBuffer.endRenderPass();
+		// Binds the state of the draw unless it is already bound
+		auto bind = [&](const MainDraw& draw)
+		{
+			const FrameObject& object = m_Objects[draw.object];
+			if (m_RenderQueue.BindPipeline(draw.pipeline->GetId()))
+				draw.pipeline->Bind(commandBuffer);
+			// Mesh shaders read the vertices from storage buffers
+			if (object.meshTasks)
+				return;
+			// The meshlet index buffer is tracked apart from the one of the LODs (ids are 32 bit)
+			if (object.cluster != UINT32_MAX)
+			{
+				if (m_RenderQueue.BindVertexBuffers((1ull << 32) | draw.model->GetId()))
+					draw.model->vkBindMeshlets(commandBuffer);
+			}
+			else if (m_RenderQueue.BindVertexBuffers(draw.model->GetId()))
+				draw.model->vkBind(commandBuffer);
+		};
+
+		if (m_UseUniforms)
+		{
+			// Upload the data of all draws at once
+			uint32_t cameraOffset = frame.uniforms->Push(CameraUniformData{ m_Camera.viewProjection });
+			std::vector<ObjectUniformData> objects(count);
+			std::vector<MaterialUniformData> materials(count);
+			uint32_t textureIndex = m_Texture ? std::static_pointer_cast<VKTexture2D>(m_Texture)->GetBindlessIndex() : Vulkan::BindlessSet::INVALID_INDEX;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				objects[i].transform = m_Objects[i].transform;
+				materials[i].color = m_Objects[i].color;
+				if (m_Objects[i].textured)
+					materials[i].textureIndex = textureIndex;
+			}
+			std::vector<uint32_t> objectOffsets = frame.uniforms->PushArray(objects);
+			std::vector<uint32_t> materialOffsets = frame.uniforms->PushArray(materials);
+
+			vk::DescriptorSet set = CreateFrameDescriptorSet(frame);
+			// Stays bound for all draws, they only select their textures by index
+			if (m_UseBindless)
+				m_Bindless->Bind(commandBuffer, m_vkPipelineLayout, 1);
+			bool rebindBindless = false;
+			for (uint32_t index : m_RenderQueue.GetOrder())
+			{
+				const MainDraw& draw = m_MainDraws[index];
+				bind(draw);
+
+				uint32_t i = draw.object;
+				const FrameObject& object = m_Objects[i];
+				if (object.meshTasks)
+				{
+					m_ClusterCulling->DrawMeshTasks(frame, commandBuffer, *draw.model, object.transform, m_Camera.viewProjection, m_Camera.position);
+					// Its set 0 has another layout, which disturbs the bindless set
+					rebindBindless = m_UseBindless;
+					m_RenderQueue.Draw();
+					continue;
+				}
+
+				std::array<uint32_t, 3> offsets = { cameraOffset, objectOffsets[i], materialOffsets[i] };
+				commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_vkPipelineLayout, 0, set, offsets);
+				if (rebindBindless)
+				{
+					m_Bindless->Bind(commandBuffer, m_vkPipelineLayout, 1);
+					rebindBindless = false;
+				}
+				// Culled objects (and meshlets) are drawn without instances
+				if (object.indirect != UINT32_MAX)
+					m_GPUCulling->DrawIndirect(frame, commandBuffer, object.indirect);
+				else if (object.cluster != UINT32_MAX)
+					m_ClusterCulling->DrawIndirect(frame, commandBuffer, *draw.model, object.cluster);
+				else
+					draw.model->vkDraw(commandBuffer, object.lod);
+				m_RenderQueue.Draw();
+			}
+		}
+		else
+		{
+			for (uint32_t index : m_RenderQueue.GetOrder())
+			{
+				const MainDraw& draw = m_MainDraws[index];
+				bind(draw);
+
+				uint32_t i = draw.object;
+				SimplePushConstantData push{};
+				push.offset = glm::vec2(m_Objects[i].transform[3]);
+				push.color = glm::vec3(m_Objects[i].color);
+				commandBuffer.pushConstants(m_vkPipelineLayout, vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment, 0, sizeof(SimplePushConstantData), &push);
+				if (m_Objects[i].indirect != UINT32_MAX)
+					m_GPUCulling->DrawIndirect(frame, commandBuffer, m_Objects[i].indirect);
+				else
+					draw.model->vkDraw(commandBuffer, m_Objects[i].lod);
+				m_RenderQueue.Draw();
+			}
+		}
+	}
 
-		try {
-			commandBuffer.end();
+
+	void VKRendererAPI::UpdateCamera()
+	{
+		// Looks at the plane z = 0 from a distance of one, so the demo objects keep
+		// their former clip space layout (-1...1, y down)
+		vk::Extent2D extent = m_RenderTarget->GetExtent();
+		float aspect = extent.height ? static_cast<float>(extent.width) / static_cast<float>(extent.height) : 1.0f;
+		m_Camera.position = { 0.0f, 0.0f, -1.0f };
+		m_Camera.fovY = glm::radians(90.0f);
+
+		glm::mat4 view = glm::lookAt(m_Camera.position, glm::vec3(0.0f), glm::vec3(0.0f, -1.0f, 0.0f));
+		glm::mat4 projection = glm::perspective(m_Camera.fovY, aspect, 0.1f, 100.0f);
+		// Clip space y points down in vulkan
+		projection[1][1] *= -1.0f;
+		m_Camera.viewProjection = projection * view;
+	}
+
+
+	void VKRendererAPI::UpdateObjects()
+	{
+		m_Tick = (m_Tick + 1) % 1000;
+
+		entt::registry& registry = ECS::Registry();
+		for (size_t i = 0; i < m_Entities.size(); i++)
+		{
+			auto& transform = registry.get<Component::Transform>(m_Entities[i]);
+			transform.translation = { -0.5f + m_Tick * 0.002f, -0.4f + i * 0.25f, 0.0f };
 		}
-		catch (vk::SystemError err) {
-			LOG_RENDER_EXCEPT("Failed to end recording command buffer!");
+		// The mesh moves away from the camera and back, so it runs through its LODs
+		if (m_MeshEntity != entt::null)
+		{
+			auto& transform = registry.get<Component::Transform>(m_MeshEntity);
+			const glm::vec4& sphere = registry.get<Renderable>(m_MeshEntity).model->GetBoundingSphere();
+			float distance = 4.0f * (0.5f - 0.5f * std::cos(m_Tick * glm::two_pi<float>() / 1000.0f));
+			// Center of the sphere on the right side (turned around x)
+			glm::vec3 center = glm::vec3(sphere) * transform.scale;
+			transform.translation = glm::vec3(0.5f, 0.0f, distance) - glm::vec3(center.x, -center.y, -center.z);
+		}
+
+		// Only the visible entities are recorded, with GPU culling the frustum
+		// is tested there (the CPU still tests the occluders)
+		m_Culling->Update(m_Camera.viewProjection, !m_GPUCulling);
+		LODSelector::Update(m_Camera.position, m_Camera.fovY, static_cast<float>(m_RenderTarget->GetExtent().height));
+		m_Objects.clear();
+		for (entt::entity entity : m_Culling->GetVisible())
+		{
+			const Renderable* renderable = registry.try_get<Renderable>(entity);
+			if (!renderable)
+				continue;
+			const auto& transform = registry.get<Component::Transform>(entity);
+			const Component::MeshLOD* lod = registry.try_get<Component::MeshLOD>(entity);
+			m_Objects.push_back({ transform.GetTransform(), renderable->color, renderable->model.get(), renderable->textured,
+				lod ? lod->current : 0, UINT32_MAX, UINT32_MAX, false });
+		}
+		if (!m_GPUCulling)
+			return;
+
+		// The GPU culling only writes non-indexed draws, so the meshes are still
+		// tested against the frustum here
+		m_MeshBounds.Clear();
+		for (const auto& object : m_Objects)
+		{
+			if (!object.model->IsMesh())
+				continue;
+			const glm::vec4& sphere = object.model->GetBoundingSphere();
+			glm::mat3 axes = glm::mat3(object.transform);
+			float radius = sphere.w * std::max(std::max(glm::length(axes[0]), glm::length(axes[1])), glm::length(axes[2]));
+			m_MeshBounds.Add(glm::vec3(object.transform * glm::vec4(glm::vec3(sphere), 1.0f)), radius, glm::vec3(radius));
+		}
+		CullingSystem::CullFrustum(m_Camera.viewProjection, m_MeshBounds, m_MeshVisible);
+
+		// Culled and drawn objects have to match the commands of the GPU culling
+		size_t count = 0;
+		size_t mesh = 0;
+		uint32_t indirect = 0;
+		uint32_t dropped = 0;
+		for (size_t i = 0; i < m_Objects.size(); i++)
+		{
+			FrameObject object = m_Objects[i];
+			if (object.model->IsMesh())
+			{
+				if (!m_MeshVisible[mesh++])
+					continue;
+			}
+			else if (indirect < Vulkan::GPUCulling::MAX_OBJECTS)
+				object.indirect = indirect++;
+			else
+			{
+				dropped++;
+				continue;
+			}
+			m_Objects[count++] = object;
 		}
+		if (dropped > 0)
+			LOG_RENDER_WARN("Too many objects for GPU culling, {} are not drawn!", dropped);
+		m_Objects.resize(count);
+	}
+
+
+	void VKRendererAPI::BuildRenderGraph()
+	{
+		// Frames in flight might still use the framebuffers and transient images
+		// (with dynamic rendering only the transient images are recreated)
+		if (m_RenderGraph)
+			RetireObject(m_RenderGraph);
+		m_RenderGraph = CreateRef<Vulkan::RenderGraph>();
+
+		vk::Extent2D extent = m_RenderTarget->GetExtent();
+		Vulkan::RGResource backbuffer = m_RenderGraph->ImportImage("Backbuffer",
+			m_RenderTarget->GetImages(), m_RenderTarget->GetImageViews(),
+			m_RenderTarget->GetImageFormat(), extent, m_RenderTarget->GetFinalLayout());
+		// Depth is cleared every frame, so one image is shared by all frames
+		Vulkan::RGResource depth = m_RenderGraph->CreateImage("Depth", { m_Device->QueryDepthFormat(), extent, m_MSAASamples });
+
+		m_MainPass = m_RenderGraph->AddPass("MainPass", Vulkan::RGPassType::Graphics,
+			[this](Vulkan::FrameContext& frame, vk::CommandBuffer commandBuffer) { RecordMainPass(frame, commandBuffer); });
+		vk::ClearColorValue clearColor{ 0.01f, 0.01f, 0.01f, 1.0f };
+		if (m_MSAASamples == vk::SampleCountFlagBits::e1)
+			m_RenderGraph->AddColorAttachment(m_MainPass, backbuffer, vk::AttachmentLoadOp::eClear, clearColor);
+		else
+		{
+			// Multisampled color only lives within the pass and is resolved at its end
+			Vulkan::RGResource color = m_RenderGraph->CreateImage("Color", { m_RenderTarget->GetImageFormat(), extent, m_MSAASamples });
+			m_RenderGraph->AddColorAttachment(m_MainPass, color, vk::AttachmentLoadOp::eClear, clearColor);
+			m_RenderGraph->AddResolveAttachment(m_MainPass, color, backbuffer);
+		}
+		m_RenderGraph->SetDepthAttachment(m_MainPass, depth, vk::AttachmentLoadOp::eClear);
+
+		m_RenderGraph->Compile();
 	}
 
 
 	void VKRendererAPI::RecreateSwapchain()
 	{
-		m_Device->GetLogicalDevice().waitIdle();
+		m_SwapchainDirty = false;
 
-//		m_Swapchain.reset();
-		if (m_Swapchain)
-			m_Swapchain = CreateRef<Vulkan::Swapchain>(std::move(m_Swapchain));
-		else
+		if (!m_Swapchain)
+		{
 			m_Swapchain = CreateRef<Vulkan::Swapchain>();
+			m_RenderTarget = m_Swapchain;
+			BuildRenderGraph();
+			CreatePipeline();
+			return;
+		}
 
-		CreatePipeline();
+		// Hand the old swapchain over to the new one and keep it alive until
+		// all frames which might still use its resources are finished
+		Ref<Vulkan::Swapchain> oldSwapchain = m_Swapchain;
+		m_Swapchain = CreateRef<Vulkan::Swapchain>(oldSwapchain);
+		m_RenderTarget = m_Swapchain;
+		RetireObject(oldSwapchain);
+		BuildRenderGraph();
+
+		// The pipeline stays valid as long as the render pass (or with dynamic
+		// rendering the attachment formats) is compatible
+		if (oldSwapchain->GetImageFormat() != m_Swapchain->GetImageFormat())
+			CreatePipeline();
+	}
+
+
+	void VKRendererAPI::RetireObject(Ref<void> object)
+	{
+		m_DeletionQueue->Push(m_Frames->GetFrameNumber(), std::move(object));
+	}
+
+
+	void VKRendererAPI::RetireObject(std::function<void()> deleter)
+	{
+		m_DeletionQueue->Push(m_Frames->GetFrameNumber(), std::move(deleter));
 	}
 
 
@@ -1,10 +1,27 @@
 #pragma once
 
 #include "HeliosEngine/Renderer/RendererAPI.h"
+#include "HeliosEngine/Renderer/CullingSystem.h"
+#include "HeliosEngine/Renderer/RenderQueue.h"
+#include "HeliosEngine/Renderer/Texture.h"
 
 #include "Platform/Renderer/Vulkan/Core/Instance.h"
 #include "Platform/Renderer/Vulkan/Core/Device.h"
+#include "Platform/Renderer/Vulkan/Core/FrameRing.h"
+#include "Platform/Renderer/Vulkan/Core/DeletionQueue.h"
+#include "Platform/Renderer/Vulkan/Core/GPUProfiler.h"
+#include "Platform/Renderer/Vulkan/Core/FrameCapture.h"
+#include "Platform/Renderer/Vulkan/Core/DescriptorSetLayout.h"
+#include "Platform/Renderer/Vulkan/Core/DescriptorAllocator.h"
+#include "Platform/Renderer/Vulkan/Core/UniformRing.h"
+#include "Platform/Renderer/Vulkan/Core/LinearAllocator.h"
+#include "Platform/Renderer/Vulkan/Core/BindlessSet.h"
+#include "Platform/Renderer/Vulkan/Core/TextureStreamer.h"
 #include "Platform/Renderer/Vulkan/Core/Swapchain.h"
+#include "Platform/Renderer/Vulkan/Core/Offscreen.h"
+#include "Platform/Renderer/Vulkan/Core/RenderGraph.h"
+#include "Platform/Renderer/Vulkan/Core/GPUCulling.h"
+#include "Platform/Renderer/Vulkan/Core/ClusterCulling.h"
 
 #include "Platform/Renderer/Vulkan/Core/Pipeline.h"
 
@@ -23,27 +40,150 @@ namespace Helios {
 		void Render();
 		void OnWindowResize(uint32_t width, uint32_t height);
 		void OnFramebufferResize(uint32_t width, uint32_t height);
+		void OnPresentModeChanged();
+
+		float GetGPUFrameTime() override;
+		RenderQueueStats GetRenderQueueStats() override;
+
+		void CaptureFrame(const std::string& path) override;
+		void StartCaptureStream(const std::string& prefix, uint32_t interval, const std::string& format) override;
+		void StopCaptureStream() override;
 
 	// Methods for internal usage in the Helios::Vulkan namespace
 	public:
 		Scope<Vulkan::Instance>& GetInstance() { return m_Instance; }
 		Scope<Vulkan::Device>& GetDevice() { return m_Device; }
+		Scope<Vulkan::FrameRing>& GetFrames() { return m_Frames; }
+		Scope<Vulkan::DeletionQueue>& GetDeletionQueue() { return m_DeletionQueue; }
+		Scope<Vulkan::GPUProfiler>& GetGPUProfiler() { return m_GPUProfiler; }
+		Scope<Vulkan::FrameCapture>& GetFrameCapture() { return m_FrameCapture; }
+		Scope<Vulkan::DescriptorAllocator>& GetDescriptors() { return m_Descriptors; }
+		Scope<Vulkan::UniformRing>& GetUniforms() { return m_Uniforms; }
+		// Per frame vertex, index, instance and indirect data
+		Scope<Vulkan::LinearAllocator>& GetTransient() { return m_Transient; }
+		// Only available with descriptor indexing (otherwise nullptr)
+		Scope<Vulkan::BindlessSet>& GetBindless() { return m_Bindless; }
+		Scope<Vulkan::TextureStreamer>& GetTextureStreamer() { return m_TextureStreamer; }
+		// Only available with the cluster culling shader (otherwise nullptr)
+		Scope<Vulkan::ClusterCulling>& GetClusterCulling() { return m_ClusterCulling; }
 		Ref<Vulkan::Swapchain>& GetSwapchain() { return m_Swapchain; }
+		Ref<Vulkan::RenderTarget>& GetRenderTarget() { return m_RenderTarget; }
+		Ref<Vulkan::RenderGraph>& GetRenderGraph() { return m_RenderGraph; }
+
+		// Keeps the object alive until the frames in flight are finished
+		void RetireObject(Ref<void> object);
+		// Calls the function (destroying raw vulkan handles) once the frames in flight are finished
+		void RetireObject(std::function<void()> deleter);
 
 	// Objects from the Helios::Vulkan namespace
 	private:
 		Ref<VKModel> m_model;
+		Ref<Texture2D> m_Texture;
 
 		Scope<Vulkan::Instance> m_Instance;
 		Scope<Vulkan::Device> m_Device;
+		Scope<Vulkan::FrameRing> m_Frames;
+		Scope<Vulkan::DeletionQueue> m_DeletionQueue;
+		Scope<Vulkan::GPUProfiler> m_GPUProfiler;
+		Scope<Vulkan::FrameCapture> m_FrameCapture;
+		Scope<Vulkan::DescriptorAllocator> m_Descriptors;
+		Scope<Vulkan::UniformRing> m_Uniforms;
+		Scope<Vulkan::LinearAllocator> m_Transient;
+		Scope<Vulkan::BindlessSet> m_Bindless;
+		Scope<Vulkan::TextureStreamer> m_TextureStreamer;
+		// Only available with the culling shader (otherwise nullptr)
+		Scope<Vulkan::GPUCulling> m_GPUCulling;
+		// Only available with the cluster culling shader (otherwise nullptr)
+		Scope<Vulkan::ClusterCulling> m_ClusterCulling;
 		Ref<Vulkan::Swapchain> m_Swapchain;
+		// Swapchain or offscreen images (headless)
+		Ref<Vulkan::RenderTarget> m_RenderTarget;
+		// Passes of the frame (rebuilt with the render target)
+		Ref<Vulkan::RenderGraph> m_RenderGraph;
+		Vulkan::RGPass m_MainPass = 0;
+		// Samples of the main pass (resolved into the render target)
+		vk::SampleCountFlagBits m_MSAASamples = vk::SampleCountFlagBits::e1;
 
 		Scope<Vulkan::Pipeline> m_Pipeline;
+		// Loaded meshes (same layout, 3D vertex input)
+		Scope<Vulkan::Pipeline> m_MeshPipeline;
 		vk::PipelineLayout m_vkPipelineLayout;
+		// Camera, object and material data (set 0), bindless resources (set 1)
+		Scope<Vulkan::DescriptorSetLayout> m_FrameSetLayout;
+		// Uniform buffers instead of push constants (if the shaders are available)
+		bool m_UseUniforms = false;
+		// Textures from the bindless set (set 1, needs descriptor indexing)
+		bool m_UseBindless = false;
+		// Loaded meshes (needs the uniform buffers and the mesh shader)
+		bool m_UseMeshes = false;
 		void CreatePipelineLayout();
 		void CreatePipeline();
-		void RecordDrawCommands(uint32_t imageIndex);
+		vk::DescriptorSet CreateFrameDescriptorSet(Vulkan::FrameContext& frame);
+		void BuildRenderGraph();
+		void RecordDrawCommands(Vulkan::FrameContext& frame, uint32_t imageIndex);
+		void RecordMainPass(Vulkan::FrameContext& frame, vk::CommandBuffer commandBuffer);
+		void UpdateCamera();
+		void UpdateObjects();
 		void RecreateSwapchain();
+
+		// Camera of the demo scene
+		struct Camera
+		{
+			glm::vec3 position{0.f};
+			// Vertical field of view in radians
+			float fovY = 0.0f;
+			glm::mat4 viewProjection{1.f};
+		};
+		Camera m_Camera;
+
+		// Component of the entities drawn by the main pass
+		struct Renderable
+		{
+			Ref<VKModel> model;
+			glm::vec4 color{1.f};
+			// Sampled from the checker texture (bindless only)
+			bool textured = false;
+		};
+		// Demo entities (Transform, Bounds and Renderable)
+		std::vector<entt::entity> m_Entities;
+		// Optional mesh of the demo (Config "DemoMesh", also with a MeshLOD)
+		entt::entity m_MeshEntity = entt::null;
+		uint32_t m_Tick = 0;
+		Scope<CullingSystem> m_Culling;
+
+		// Visible objects of the current frame
+		struct FrameObject
+		{
+			glm::mat4 transform;
+			glm::vec4 color;
+			VKModel* model;
+			bool textured;
+			// Selected LOD (meshes only)
+			uint32_t lod;
+			// Command of the GPU culling (UINT32_MAX if drawn directly)
+			uint32_t indirect;
+			// First draw of the cluster culling (UINT32_MAX if drawn without it)
+			uint32_t cluster;
+			// Culled and drawn by the task and mesh shaders
+			bool meshTasks;
+		};
+		std::vector<FrameObject> m_Objects;
+		// Meshes are tested on the CPU even with GPU culling
+		CullingBounds m_MeshBounds;
+		std::vector<uint8_t> m_MeshVisible;
+
+		// Draws of the main pass (indexed by the render queue)
+		struct MainDraw
+		{
+			Vulkan::Pipeline* pipeline;
+			VKModel* model;
+			uint32_t object;
+		};
+		std::vector<MainDraw> m_MainDraws;
+		RenderQueue m_RenderQueue;
+
+		// Swapchain needs to be recreated before the next frame
+		bool m_SwapchainDirty = false;
 	};
 
 
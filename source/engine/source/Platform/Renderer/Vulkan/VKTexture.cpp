@@ -0,0 +1,119 @@
+#include "pch.h"
+#include "VKTexture.h"
+
+#include "HeliosEngine/Renderer/Renderer.h"
+#include "HeliosEngine/Renderer/TextureLoader.h"
+#include "Platform/Renderer/Vulkan/VKRendererAPI.h"
+
+
+namespace Helios {
+
+
+	VKTexture2D::VKTexture2D(const TextureSpecification& specification)
+		: m_specification(specification)
+	{
+		// Empty image until the data is set
+		Upload({});
+	}
+
+
+	VKTexture2D::VKTexture2D(const std::string& filename, const std::string& arcname)
+		: m_path(filename)
+	{
+		TextureData data;
+		if (!TextureLoader::Load(filename, arcname, data))
+		{
+			LOG_RENDER_ERROR("Failed to load texture \"{}\"!", filename);
+			Upload({});
+			return;
+		}
+
+		m_specification = data.Specification;
+		Upload(std::move(data.Levels));
+	}
+
+
+	VKTexture2D::~VKTexture2D()
+	{
+		VKRendererAPI* api = static_cast<VKRendererAPI*>(Renderer::Get());
+
+		// Frames in flight may still sample the image
+		if (m_image)
+			api->RetireObject(m_image);
+	}
+
+
+	void VKTexture2D::SetData(const void* data, uint32_t size)
+	{
+		size_t expected = TextureLoader::GetLevelSize(m_specification.Format, m_specification.Width, m_specification.Height);
+		if (size != expected)
+		{
+			LOG_RENDER_ERROR("Texture data has to be the entire texture ({} of {} bytes)!", size, expected);
+			return;
+		}
+
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		Upload({ std::vector<uint8_t>(bytes, bytes + size) });
+	}
+
+
+	vk::Format VKTexture2D::GetFormat(ImageFormat format)
+	{
+		switch (format)
+		{
+		case ImageFormat::RGBA8:      return vk::Format::eR8G8B8A8Unorm;
+		case ImageFormat::RGBA8_SRGB: return vk::Format::eR8G8B8A8Srgb;
+		case ImageFormat::BC1:        return vk::Format::eBc1RgbaUnormBlock;
+		case ImageFormat::BC1_SRGB:   return vk::Format::eBc1RgbaSrgbBlock;
+		case ImageFormat::BC3:        return vk::Format::eBc3UnormBlock;
+		case ImageFormat::BC3_SRGB:   return vk::Format::eBc3SrgbBlock;
+		case ImageFormat::BC4:        return vk::Format::eBc4UnormBlock;
+		case ImageFormat::BC5:        return vk::Format::eBc5UnormBlock;
+		case ImageFormat::BC7:        return vk::Format::eBc7UnormBlock;
+		case ImageFormat::BC7_SRGB:   return vk::Format::eBc7SrgbBlock;
+		case ImageFormat::ASTC_4x4:      return vk::Format::eAstc4x4UnormBlock;
+		case ImageFormat::ASTC_4x4_SRGB: return vk::Format::eAstc4x4SrgbBlock;
+		default: LOG_RENDER_EXCEPT("Unsupported image format!"); return vk::Format::eUndefined;
+		}
+	}
+
+
+	bool VKTexture2D::IsSupported(vk::Format format)
+	{
+		Scope<Vulkan::Device>& device = static_cast<VKRendererAPI*>(Renderer::Get())->GetDevice();
+
+		return device->IsFormatSupported(format, vk::ImageTiling::eOptimal,
+			vk::FormatFeatureFlagBits::eSampledImage | vk::FormatFeatureFlagBits::eTransferDst);
+	}
+
+
+	void VKTexture2D::Upload(std::vector<std::vector<uint8_t>> levels)
+	{
+		VKRendererAPI* api = static_cast<VKRendererAPI*>(Renderer::Get());
+
+		vk::Extent2D extent = { std::max(m_specification.Width, 1u), std::max(m_specification.Height, 1u) };
+		vk::Format format = GetFormat(m_specification.Format);
+
+		// Compressed data is uploaded as is, there is no transcoding on the CPU
+		if (!IsSupported(format))
+		{
+			LOG_RENDER_ERROR("Texture format {} is not supported by the device!", vk::to_string(format));
+			format = vk::Format::eR8G8B8A8Unorm;
+			levels.clear();
+		}
+
+		// Mips are generated on the GPU if the data has none
+		bool generateMips = m_specification.GenerateMips and levels.size() <= 1 and Vulkan::TextureImage::SupportsLinearBlit(format);
+		uint32_t mipLevels = generateMips ? Vulkan::TextureImage::CalcMipLevels(extent) : std::max<uint32_t>(static_cast<uint32_t>(levels.size()), 1);
+
+		// The old image may still be sampled by frames in flight
+		if (m_image)
+			api->RetireObject(m_image);
+		m_image = CreateRef<Vulkan::TextureImage>(extent, format, mipLevels);
+
+		if (!levels.empty())
+			api->GetTextureStreamer()->Enqueue(m_image, std::move(levels), generateMips);
+	}
+
+
+} // namespace Helios
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "HeliosEngine/Renderer/Texture.h"
+
+#include <vulkan/vulkan.hpp>
+
+#include "Platform/Renderer/Vulkan/Core/TextureImage.h"
+
+
+namespace Helios {
+
+
+	class VKTexture2D : public Texture2D
+	{
+	public:
+		VKTexture2D(const TextureSpecification& specification);
+		VKTexture2D(const std::string& filename, const std::string& arcname);
+		~VKTexture2D();
+
+		const TextureSpecification& GetSpecification() const override { return m_specification; }
+
+		uint32_t GetWidth() const override { return m_specification.Width; }
+		uint32_t GetHeight() const override { return m_specification.Height; }
+		uint32_t GetMipLevels() const override { return m_image->GetMipLevels(); }
+
+		uint32_t GetResidentMip() const override { return m_image->GetResidentMip(); }
+		bool IsLoaded() const override { return m_image->GetResidentMip() == 0; }
+
+		const std::string& GetPath() const override { return m_path; }
+
+		void SetData(const void* data, uint32_t size) override;
+
+	// Methods for internal usage in the Helios::Vulkan namespace
+	public:
+		Ref<Vulkan::TextureImage>& GetImage() { return m_image; }
+		uint32_t GetBindlessIndex() const { return m_image->GetBindlessIndex(); }
+		vk::DescriptorImageInfo GetDescriptorInfo() const { return m_image->GetDescriptorInfo(); }
+
+		static vk::Format GetFormat(ImageFormat format);
+		// Sampling and uploads of the format are supported by the device
+		static bool IsSupported(vk::Format format);
+
+	// Internal helper
+	private:
+		// Replaces the image and streams the levels into it
+		void Upload(std::vector<std::vector<uint8_t>> levels);
+
+	// Internal data
+	private:
+		TextureSpecification m_specification;
+		std::string m_path;
+
+		Ref<Vulkan::TextureImage> m_image;
+	};
+
+
+} // namespace Helios
@@ -0,0 +1,32 @@
+-----------------------
+-- [ PROJECT CONFIG] --
+-----------------------
+project "helios.tools.meshcompiler"
+	architecture  "x86_64"
+	language      "C++"
+	cppdialect    "C++20"
+	staticruntime "On"
+	kind          "ConsoleApp"
+
+	targetdir (dir_bin   .. dir_group .. dir_config)
+	objdir    (dir_build .. dir_group .. dir_config .. dir_project)
+
+	-- Standalone (no engine, no renderer dependencies)
+	includedirs {
+		"source",
+	}
+
+	files {
+		"**.h",
+		"**.cpp"
+	}
+
+	filter "configurations:Debug"
+		defines {
+		}
+
+	filter "configurations:Release"
+		defines {
+		}
+
+	filter {}
@@ -0,0 +1,68 @@
+#include "HMeshWriter.h"
+
+#include <fstream>
+
+
+namespace Helios::Tools {
+
+
+	namespace {
+
+		template<typename T>
+		void Write(std::ofstream& file, const T& value)
+		{
+			file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+	}
+
+
+	bool WriteHMesh(const std::string& path, const Mesh& mesh, const std::vector<MeshLOD>& lods)
+	{
+		std::ofstream file(path, std::ios::binary);
+		if (!file)
+			return false;
+
+		uint32_t indexCount = 0;
+		for (const auto& lod : lods)
+			indexCount += static_cast<uint32_t>(lod.indices.size());
+
+		Vec3 center;
+		float radius;
+		ComputeBoundingSphere(mesh, center, radius);
+
+		file.write("HMSH", 4);
+		Write(file, uint32_t(1));
+		Write(file, static_cast<uint32_t>(mesh.positions.size()));
+		Write(file, indexCount);
+		Write(file, static_cast<uint32_t>(lods.size()));
+		Write(file, center.x);
+		Write(file, center.y);
+		Write(file, center.z);
+		Write(file, radius);
+
+		uint32_t offset = 0;
+		for (const auto& lod : lods)
+		{
+			Write(file, offset);
+			Write(file, static_cast<uint32_t>(lod.indices.size()));
+			Write(file, lod.error);
+			offset += static_cast<uint32_t>(lod.indices.size());
+		}
+
+		for (size_t i = 0; i < mesh.positions.size(); i++)
+		{
+			Write(file, mesh.positions[i].x);
+			Write(file, mesh.positions[i].y);
+			Write(file, mesh.positions[i].z);
+			Write(file, mesh.colors[i]);
+		}
+
+		for (const auto& lod : lods)
+			file.write(reinterpret_cast<const char*>(lod.indices.data()), lod.indices.size() * sizeof(uint32_t));
+
+		return file.good();
+	}
+
+
+} // namespace Helios::Tools
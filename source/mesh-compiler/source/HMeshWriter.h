@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Mesh.h"
+
+
+namespace Helios::Tools {
+
+
+	struct MeshLOD
+	{
+		std::vector<uint32_t> indices;
+		// Largest distance of the simplified surface to the original one (model units)
+		float error = 0.0f;
+	};
+
+
+	// Writes the binary mesh format of the engine (.hmesh, little endian):
+	//   char     magic[4]     "HMSH"
+	//   uint32_t version      1
+	//   uint32_t vertexCount
+	//   uint32_t indexCount   (all LODs)
+	//   uint32_t lodCount
+	//   float    center[3], radius   (bounding sphere)
+	//   lodCount x { uint32_t indexOffset, uint32_t indexCount, float error }
+	//   vertexCount x { float position[3], uint8_t color[4] }
+	//   indexCount x uint32_t
+	// LOD 0 is the full detail, all LODs index the same vertices.
+	bool WriteHMesh(const std::string& path, const Mesh& mesh, const std::vector<MeshLOD>& lods);
+
+
+} // namespace Helios::Tools
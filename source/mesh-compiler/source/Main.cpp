@@ -0,0 +1,93 @@
+#include "Mesh.h"
+#include "Simplifier.h"
+#include "HMeshWriter.h"
+
+#include <chrono>
+#include <iostream>
+
+
+using namespace Helios::Tools;
+
+
+static void PrintUsage()
+{
+	std::cout
+		<< "Usage: helios.tools.meshcompiler <input.obj> <output.hmesh> [options]\n"
+		<< "Options:\n"
+		<< "  --lods <n>      number of LODs including the full detail (1...8, default 4)\n"
+		<< "  --ratio <r>     triangles of a LOD relative to the previous one (default 0.5)\n";
+}
+
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::string input = argv[1];
+	std::string output = argv[2];
+	int lodCount = 4;
+	float ratio = 0.5f;
+
+	for (int i = 3; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg == "--lods" and i + 1 < argc)
+			lodCount = std::atoi(argv[++i]);
+		else if (arg == "--ratio" and i + 1 < argc)
+			ratio = static_cast<float>(std::atof(argv[++i]));
+		else
+		{
+			std::cerr << "Unknown option: " << arg << "\n";
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (lodCount < 1 or lodCount > 8 or ratio <= 0.0f or ratio >= 1.0f)
+	{
+		std::cerr << "Invalid LOD options!\n";
+		PrintUsage();
+		return 1;
+	}
+
+	Mesh mesh;
+	if (!LoadOBJ(input, mesh))
+	{
+		std::cerr << "Failed to load \"" << input << "\"!\n";
+		return 1;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	// Every LOD is simplified from the full detail, stops early if the
+	// mesh can not be simplified any further
+	Simplifier simplifier(mesh);
+	std::vector<MeshLOD> lods = { { mesh.indices, 0.0f } };
+	for (int i = 1; i < lodCount; i++)
+	{
+		size_t target = static_cast<size_t>(lods.back().indices.size() / 3 * ratio) * 3;
+		MeshLOD lod;
+		lod.indices = simplifier.Simplify(target, lod.error);
+		if (lod.indices.empty() or lod.indices.size() >= lods.back().indices.size())
+			break;
+		lod.error = std::max(lod.error, lods.back().error);
+		lods.push_back(std::move(lod));
+	}
+
+	auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+	if (!WriteHMesh(output, mesh, lods))
+	{
+		std::cerr << "Failed to write \"" << output << "\"!\n";
+		return 1;
+	}
+
+	std::cout << input << " -> " << output << ": " << mesh.positions.size() << " vertices (" << elapsed.count() << " ms)\n";
+	for (size_t i = 0; i < lods.size(); i++)
+		std::cout << "  LOD " << i << ": " << lods[i].indices.size() / 3 << " triangles, error " << lods[i].error << "\n";
+
+	return 0;
+}
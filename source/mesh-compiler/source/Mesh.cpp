@@ -0,0 +1,82 @@
+#include "Mesh.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+
+namespace Helios::Tools {
+
+
+	bool LoadOBJ(const std::string& path, Mesh& mesh)
+	{
+		std::ifstream file(path);
+		if (!file)
+			return false;
+
+		auto toByte = [](float value) {
+			return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+		};
+
+		std::string line;
+		while (std::getline(file, line))
+		{
+			std::istringstream stream(line);
+			std::string type;
+			stream >> type;
+
+			if (type == "v")
+			{
+				Vec3 position;
+				float r = 1.0f, g = 1.0f, b = 1.0f;
+				stream >> position.x >> position.y >> position.z;
+				if (!(stream >> r >> g >> b))
+					r = g = b = 1.0f;
+				mesh.positions.push_back(position);
+				mesh.colors.push_back(toByte(r) | (toByte(g) << 8) | (toByte(b) << 16) | (255u << 24));
+			}
+			else if (type == "f")
+			{
+				// "a", "a/b", "a//c" or "a/b/c", negative indices are relative to the end
+				std::vector<uint32_t> polygon;
+				std::string corner;
+				while (stream >> corner)
+				{
+					long index = std::strtol(corner.c_str(), nullptr, 10);
+					if (index < 0)
+						index += static_cast<long>(mesh.positions.size()) + 1;
+					if (index < 1 or index > static_cast<long>(mesh.positions.size()))
+						return false;
+					polygon.push_back(static_cast<uint32_t>(index - 1));
+				}
+				for (size_t i = 2; i < polygon.size(); i++)
+				{
+					mesh.indices.push_back(polygon[0]);
+					mesh.indices.push_back(polygon[i - 1]);
+					mesh.indices.push_back(polygon[i]);
+				}
+			}
+		}
+
+		return !mesh.positions.empty() and !mesh.indices.empty();
+	}
+
+
+	void ComputeBoundingSphere(const Mesh& mesh, Vec3& center, float& radius)
+	{
+		Vec3 min = mesh.positions[0];
+		Vec3 max = mesh.positions[0];
+		for (const Vec3& p : mesh.positions)
+		{
+			min = { std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z) };
+			max = { std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z) };
+		}
+
+		center = (min + max) * 0.5f;
+		radius = 0.0f;
+		for (const Vec3& p : mesh.positions)
+			radius = std::max(radius, Length(p - center));
+	}
+
+
+} // namespace Helios::Tools
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace Helios::Tools {
+
+
+	struct Vec3
+	{
+		float x = 0.0f, y = 0.0f, z = 0.0f;
+
+		Vec3 operator+(const Vec3& o) const { return { x + o.x, y + o.y, z + o.z }; }
+		Vec3 operator-(const Vec3& o) const { return { x - o.x, y - o.y, z - o.z }; }
+		Vec3 operator*(float s) const { return { x * s, y * s, z * s }; }
+		bool operator==(const Vec3& o) const { return x == o.x and y == o.y and z == o.z; }
+	};
+
+	inline float Dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+	inline Vec3 Cross(const Vec3& a, const Vec3& b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+	inline float Length(const Vec3& v) { return std::sqrt(Dot(v, v)); }
+
+
+	// Indexed triangle mesh, all LODs share the vertices
+	struct Mesh
+	{
+		std::vector<Vec3> positions;
+		// RGBA8 per vertex
+		std::vector<uint32_t> colors;
+		// LOD 0 (full detail)
+		std::vector<uint32_t> indices;
+	};
+
+
+	// Wavefront OBJ: "v x y z [r g b]" and "f" lines (polygons are triangulated
+	// as fans, texture coordinates and normals are ignored)
+	bool LoadOBJ(const std::string& path, Mesh& mesh);
+
+	// Smallest sphere around the center of the bounding box
+	void ComputeBoundingSphere(const Mesh& mesh, Vec3& center, float& radius);
+
+
+} // namespace Helios::Tools
@@ -0,0 +1,282 @@
+#include "Simplifier.h"
+
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+
+
+namespace Helios::Tools {
+
+
+	namespace {
+
+		// Weight of the planes which keep the borders in place
+		constexpr double BORDER_WEIGHT = 10.0;
+
+		struct Collapse
+		{
+			double cost;
+			// Welded vertex u is moved onto v
+			uint32_t u, v;
+			// Versions of the vertices when the collapse was computed
+			uint32_t versionU, versionV;
+
+			bool operator>(const Collapse& o) const { return cost > o.cost; }
+		};
+
+		uint64_t EdgeKey(uint32_t a, uint32_t b)
+		{
+			return (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+		}
+
+	}
+
+
+	Simplifier::Quadric Simplifier::Quadric::FromPlane(double a, double b, double c, double d, double weight)
+	{
+		Quadric q;
+		q.m[0] = a * a * weight; q.m[1] = a * b * weight; q.m[2] = a * c * weight; q.m[3] = a * d * weight;
+		q.m[4] = b * b * weight; q.m[5] = b * c * weight; q.m[6] = b * d * weight;
+		q.m[7] = c * c * weight; q.m[8] = c * d * weight;
+		q.m[9] = d * d * weight;
+		q.weight = weight;
+		return q;
+	}
+
+
+	Simplifier::Quadric& Simplifier::Quadric::operator+=(const Quadric& o)
+	{
+		for (int i = 0; i < 10; i++)
+			m[i] += o.m[i];
+		weight += o.weight;
+		return *this;
+	}
+
+
+	double Simplifier::Quadric::Evaluate(const Vec3& v) const
+	{
+		double x = v.x, y = v.y, z = v.z;
+		return
+			m[0] * x * x + 2 * m[1] * x * y + 2 * m[2] * x * z + 2 * m[3] * x +
+			m[4] * y * y + 2 * m[5] * y * z + 2 * m[6] * y +
+			m[7] * z * z + 2 * m[8] * z +
+			m[9];
+	}
+
+
+	Simplifier::Simplifier(const Mesh& mesh)
+		: m_mesh(mesh)
+	{
+		// Weld vertices with the same position (attribute seams)
+		struct PositionLess
+		{
+			bool operator()(const Vec3& a, const Vec3& b) const
+			{
+				return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+			}
+		};
+		std::map<Vec3, uint32_t, PositionLess> welded;
+		m_weld.resize(mesh.positions.size());
+		for (uint32_t i = 0; i < mesh.positions.size(); i++)
+			m_weld[i] = welded.emplace(mesh.positions[i], i).first->second;
+
+		// Face planes (weighted by the area)
+		m_quadrics.resize(mesh.positions.size());
+		std::unordered_map<uint64_t, int> edgeUse;
+		for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3)
+		{
+			uint32_t w[3] = { m_weld[mesh.indices[t]], m_weld[mesh.indices[t + 1]], m_weld[mesh.indices[t + 2]] };
+			const Vec3& p0 = mesh.positions[w[0]];
+			Vec3 normal = Cross(mesh.positions[w[1]] - p0, mesh.positions[w[2]] - p0);
+			float area = Length(normal);
+			if (area <= 0.0f)
+				continue;
+			normal = normal * (1.0f / area);
+
+			Quadric q = Quadric::FromPlane(normal.x, normal.y, normal.z, -Dot(normal, p0), area * 0.5);
+			for (uint32_t corner : w)
+				m_quadrics[corner] += q;
+			for (int e = 0; e < 3; e++)
+				edgeUse[EdgeKey(w[e], w[(e + 1) % 3])]++;
+		}
+
+		// Border edges (only used by one face) get a plane perpendicular to the face
+		for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3)
+		{
+			uint32_t w[3] = { m_weld[mesh.indices[t]], m_weld[mesh.indices[t + 1]], m_weld[mesh.indices[t + 2]] };
+			const Vec3& p0 = mesh.positions[w[0]];
+			Vec3 normal = Cross(mesh.positions[w[1]] - p0, mesh.positions[w[2]] - p0);
+			if (Length(normal) <= 0.0f)
+				continue;
+
+			for (int e = 0; e < 3; e++)
+			{
+				uint32_t a = w[e], b = w[(e + 1) % 3];
+				if (edgeUse[EdgeKey(a, b)] != 1)
+					continue;
+
+				Vec3 edge = mesh.positions[b] - mesh.positions[a];
+				Vec3 side = Cross(edge, normal);
+				float length = Length(side);
+				if (length <= 0.0f)
+					continue;
+				side = side * (1.0f / length);
+				Quadric q = Quadric::FromPlane(side.x, side.y, side.z, -Dot(side, mesh.positions[a]), BORDER_WEIGHT * Length(edge));
+				m_quadrics[a] += q;
+				m_quadrics[b] += q;
+			}
+		}
+	}
+
+
+	std::vector<uint32_t> Simplifier::Simplify(size_t targetIndexCount, float& error) const
+	{
+		const std::vector<Vec3>& positions = m_mesh.positions;
+		std::vector<uint32_t> corners = m_mesh.indices;
+		size_t triangleCount = corners.size() / 3;
+		std::vector<bool> removed(triangleCount, false);
+		size_t liveIndices = corners.size();
+		error = 0.0f;
+
+		// Welded vertex every welded vertex was collapsed into (itself if not collapsed)
+		std::vector<uint32_t> target(positions.size());
+		for (uint32_t i = 0; i < target.size(); i++)
+			target[i] = i;
+		auto resolve = [&](uint32_t w) {
+			while (target[w] != w)
+				w = target[w];
+			return w;
+		};
+
+		std::vector<Quadric> quadrics = m_quadrics;
+		std::vector<uint32_t> versions(positions.size(), 0);
+		std::vector<std::vector<uint32_t>> faces(positions.size());
+		for (uint32_t t = 0; t < triangleCount; t++)
+			for (int c = 0; c < 3; c++)
+				faces[m_weld[corners[t * 3 + c]]].push_back(t);
+
+		auto computeCollapse = [&](uint32_t a, uint32_t b) {
+			Quadric q = quadrics[a];
+			q += quadrics[b];
+			double costAB = q.Evaluate(positions[b]);
+			double costBA = q.Evaluate(positions[a]);
+			if (costAB <= costBA)
+				return Collapse{ std::max(costAB, 0.0), a, b, versions[a], versions[b] };
+			return Collapse{ std::max(costBA, 0.0), b, a, versions[b], versions[a] };
+		};
+
+		std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue;
+		{
+			std::unordered_map<uint64_t, bool> edges;
+			for (uint32_t t = 0; t < triangleCount; t++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					uint32_t a = m_weld[corners[t * 3 + c]];
+					uint32_t b = m_weld[corners[t * 3 + (c + 1) % 3]];
+					if (a != b and edges.emplace(EdgeKey(a, b), true).second)
+						queue.push(computeCollapse(a, b));
+				}
+			}
+		}
+
+		auto weldedCorner = [&](uint32_t t, int c) { return resolve(m_weld[corners[t * 3 + c]]); };
+
+		while (liveIndices > targetIndexCount and !queue.empty())
+		{
+			Collapse collapse = queue.top();
+			queue.pop();
+
+			// Outdated (one of the vertices changed since)
+			if (target[collapse.u] != collapse.u or target[collapse.v] != collapse.v or
+				versions[collapse.u] != collapse.versionU or versions[collapse.v] != collapse.versionV)
+				continue;
+
+			// Reject collapses which flip a remaining face
+			bool flips = false;
+			for (uint32_t t : faces[collapse.u])
+			{
+				if (removed[t])
+					continue;
+				uint32_t w[3] = { weldedCorner(t, 0), weldedCorner(t, 1), weldedCorner(t, 2) };
+				if (w[0] == collapse.v or w[1] == collapse.v or w[2] == collapse.v)
+					continue;
+
+				Vec3 before = Cross(positions[w[1]] - positions[w[0]], positions[w[2]] - positions[w[0]]);
+				for (uint32_t& corner : w)
+					if (corner == collapse.u)
+						corner = collapse.v;
+				Vec3 after = Cross(positions[w[1]] - positions[w[0]], positions[w[2]] - positions[w[0]]);
+				if (Dot(before, after) <= 0.0f)
+				{
+					flips = true;
+					break;
+				}
+			}
+			if (flips)
+				continue;
+
+			// Collapse u into v
+			target[collapse.u] = collapse.v;
+			quadrics[collapse.v] += quadrics[collapse.u];
+			versions[collapse.v]++;
+			// Root mean squared distance to the planes of the merged vertex
+			double weight = quadrics[collapse.v].weight;
+			if (weight > 0.0)
+				error = std::max(error, static_cast<float>(std::sqrt(collapse.cost / weight)));
+
+			for (uint32_t t : faces[collapse.u])
+			{
+				if (removed[t])
+					continue;
+				uint32_t w[3] = { weldedCorner(t, 0), weldedCorner(t, 1), weldedCorner(t, 2) };
+				if (w[0] == w[1] or w[1] == w[2] or w[0] == w[2])
+				{
+					removed[t] = true;
+					liveIndices -= 3;
+					continue;
+				}
+				faces[collapse.v].push_back(t);
+			}
+			faces[collapse.u].clear();
+
+			// New collapses around v
+			std::vector<uint32_t> neighbors;
+			for (uint32_t t : faces[collapse.v])
+			{
+				if (removed[t])
+					continue;
+				for (int c = 0; c < 3; c++)
+				{
+					uint32_t w = weldedCorner(t, c);
+					if (w != collapse.v and std::find(neighbors.begin(), neighbors.end(), w) == neighbors.end())
+						neighbors.push_back(w);
+				}
+			}
+			for (uint32_t n : neighbors)
+				queue.push(computeCollapse(collapse.v, n));
+		}
+
+		// Corners of collapsed vertices use the vertex they were moved onto
+		// (the first vertex with its position), others keep their vertex
+		std::vector<uint32_t> indices;
+		indices.reserve(liveIndices);
+		for (uint32_t t = 0; t < triangleCount; t++)
+		{
+			if (removed[t])
+				continue;
+			for (int c = 0; c < 3; c++)
+			{
+				uint32_t vertex = corners[t * 3 + c];
+				uint32_t w = resolve(m_weld[vertex]);
+				indices.push_back(w == m_weld[vertex] ? vertex : w);
+			}
+		}
+
+		return indices;
+	}
+
+
+} // namespace Helios::Tools
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Mesh.h"
+
+
+namespace Helios::Tools {
+
+
+	// Mesh simplification with quadric error metrics (Garland & Heckbert).
+	// Edges are collapsed into one of their vertices (no new positions), so
+	// every LOD only needs its own index buffer and shares the vertices.
+	// Vertices with the same position are welded for the topology, borders
+	// are kept in place by additional planes perpendicular to the border.
+	class Simplifier
+	{
+	public:
+		Simplifier(const Mesh& mesh);
+
+		// Simplifies LOD 0 until the target index count is reached (or no
+		// collapse is possible). Error: largest distance of a collapse in model units.
+		std::vector<uint32_t> Simplify(size_t targetIndexCount, float& error) const;
+
+	private:
+		// Symmetric 4x4 matrix (upper triangle)
+		struct Quadric
+		{
+			double m[10] = {};
+			// Sum of the plane weights (to get a mean squared distance)
+			double weight = 0.0;
+
+			static Quadric FromPlane(double a, double b, double c, double d, double weight);
+			Quadric& operator+=(const Quadric& o);
+			double Evaluate(const Vec3& v) const;
+		};
+
+		const Mesh& m_mesh;
+		// Welded vertex of every vertex (same position)
+		std::vector<uint32_t> m_weld;
+		// Quadric of every welded vertex (faces and borders of LOD 0)
+		std::vector<Quadric> m_quadrics;
+	};
+
+
+} // namespace Helios::Tools
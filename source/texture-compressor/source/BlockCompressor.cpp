@@ -0,0 +1,317 @@
+#include "BlockCompressor.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace Helios::Tools {
+
+
+	namespace {
+
+		uint16_t To565(const int* color)
+		{
+			return static_cast<uint16_t>(
+				((color[0] * 31 + 127) / 255) << 11 |
+				((color[1] * 63 + 127) / 255) << 5 |
+				((color[2] * 31 + 127) / 255));
+		}
+
+		void From565(uint16_t value, int* color)
+		{
+			int r = (value >> 11) & 31, g = (value >> 5) & 63, b = value & 31;
+			color[0] = (r << 3) | (r >> 2);
+			color[1] = (g << 2) | (g >> 4);
+			color[2] = (b << 3) | (b >> 2);
+		}
+
+		int Distance(const int* a, const uint8_t* b, int channels)
+		{
+			int sum = 0;
+			for (int c = 0; c < channels; c++)
+				sum += (a[c] - b[c]) * (a[c] - b[c]);
+			return sum;
+		}
+
+		// Writes values LSB first (as used by BC7)
+		class BitWriter
+		{
+		public:
+			BitWriter(uint8_t* out) : m_out(out) { std::memset(m_out, 0, 16); }
+
+			void Write(uint32_t value, uint32_t bits)
+			{
+				for (uint32_t i = 0; i < bits; i++, m_pos++)
+					m_out[m_pos / 8] |= ((value >> i) & 1) << (m_pos % 8);
+			}
+
+		private:
+			uint8_t* m_out;
+			uint32_t m_pos = 0;
+		};
+
+	}
+
+
+	std::vector<uint8_t> BlockCompressor::Compress(const Image& image, BlockFormat format)
+	{
+		if (format == BlockFormat::RGBA8)
+			return image.pixels;
+
+		uint32_t blocksX = (image.width + 3) / 4;
+		uint32_t blocksY = (image.height + 3) / 4;
+		uint32_t blockBytes = GetBlockBytes(format);
+		std::vector<uint8_t> result(static_cast<size_t>(blocksX) * blocksY * blockBytes);
+
+		uint8_t block[64];
+		for (uint32_t by = 0; by < blocksY; by++)
+		{
+			for (uint32_t bx = 0; bx < blocksX; bx++)
+			{
+				// Gather the pixels, repeating the last row/column at the edges
+				for (uint32_t y = 0; y < 4; y++)
+				{
+					for (uint32_t x = 0; x < 4; x++)
+					{
+						uint32_t sx = std::min(bx * 4 + x, image.width - 1);
+						uint32_t sy = std::min(by * 4 + y, image.height - 1);
+						std::memcpy(&block[(y * 4 + x) * 4], &image.pixels[(static_cast<size_t>(sy) * image.width + sx) * 4], 4);
+					}
+				}
+
+				uint8_t* out = &result[(static_cast<size_t>(by) * blocksX + bx) * blockBytes];
+				switch (format)
+				{
+				case BlockFormat::BC1: EncodeBC1(block, out); break;
+				case BlockFormat::BC3: EncodeBC4(block, 3, out); EncodeBC1(block, out + 8); break;
+				case BlockFormat::BC4: EncodeBC4(block, 0, out); break;
+				case BlockFormat::BC5: EncodeBC4(block, 0, out); EncodeBC4(block, 1, out + 8); break;
+				case BlockFormat::BC7: EncodeBC7(block, out); break;
+				default: break;
+				}
+			}
+		}
+
+		return result;
+	}
+
+
+	uint32_t BlockCompressor::GetBlockBytes(BlockFormat format)
+	{
+		switch (format)
+		{
+		case BlockFormat::RGBA8: return 4;
+		case BlockFormat::BC1:   return 8;
+		case BlockFormat::BC4:   return 8;
+		default:                 return 16;
+		}
+	}
+
+
+	void BlockCompressor::EncodeBC1(const uint8_t* block, uint8_t* out)
+	{
+		int lo[3] = { 255, 255, 255 }, hi[3] = { 0, 0, 0 };
+		bool transparent = false;
+		for (int i = 0; i < 16; i++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				lo[c] = std::min<int>(lo[c], block[i * 4 + c]);
+				hi[c] = std::max<int>(hi[c], block[i * 4 + c]);
+			}
+			transparent |= block[i * 4 + 3] < 128;
+		}
+
+		// Inset the bounding box a bit to reduce the error of the extremes
+		for (int c = 0; c < 3; c++)
+		{
+			int inset = (hi[c] - lo[c]) / 16;
+			lo[c] += inset;
+			hi[c] -= inset;
+		}
+
+		uint16_t c0 = To565(hi), c1 = To565(lo);
+		// c0 > c1 selects the 4 color mode, c0 <= c1 the 3 color mode with transparency
+		if ((c0 < c1) != transparent)
+			std::swap(c0, c1);
+
+		int palette[4][3];
+		From565(c0, palette[0]);
+		From565(c1, palette[1]);
+		int colors = 4;
+		for (int c = 0; c < 3; c++)
+		{
+			if (c0 > c1)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+			else
+			{
+				palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+				palette[3][c] = 0;
+				colors = 3;
+			}
+		}
+
+		uint32_t indices = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			uint32_t best = 0;
+			if (colors == 3 and block[i * 4 + 3] < 128)
+				best = 3;
+			else
+			{
+				int bestDistance = INT32_MAX;
+				for (int p = 0; p < colors; p++)
+				{
+					int distance = Distance(palette[p], &block[i * 4], 3);
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						best = p;
+					}
+				}
+			}
+			indices |= best << (i * 2);
+		}
+
+		out[0] = c0 & 0xFF;
+		out[1] = c0 >> 8;
+		out[2] = c1 & 0xFF;
+		out[3] = c1 >> 8;
+		for (int i = 0; i < 4; i++)
+			out[4 + i] = (indices >> (i * 8)) & 0xFF;
+	}
+
+
+	void BlockCompressor::EncodeBC4(const uint8_t* block, uint32_t channel, uint8_t* out)
+	{
+		int lo = 255, hi = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			lo = std::min<int>(lo, block[i * 4 + channel]);
+			hi = std::max<int>(hi, block[i * 4 + channel]);
+		}
+
+		// a0 > a1 selects the 8 value mode
+		int palette[8] = { hi, lo };
+		for (int i = 1; i < 7; i++)
+			palette[i + 1] = ((7 - i) * hi + i * lo) / 7;
+
+		uint64_t indices = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			int value = block[i * 4 + channel];
+			uint64_t best = 0;
+			int bestDistance = INT32_MAX;
+			for (int p = 0; p < (hi > lo ? 8 : 1); p++)
+			{
+				int distance = std::abs(palette[p] - value);
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = p;
+				}
+			}
+			indices |= best << (i * 3);
+		}
+
+		out[0] = static_cast<uint8_t>(hi);
+		out[1] = static_cast<uint8_t>(lo);
+		for (int i = 0; i < 6; i++)
+			out[2 + i] = (indices >> (i * 8)) & 0xFF;
+	}
+
+
+	void BlockCompressor::EncodeBC7(const uint8_t* block, uint8_t* out)
+	{
+		// Mode 6: one subset, RGBA endpoints with 7 bits + p-bit, 4 bit indices
+		static constexpr int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		int lo[4] = { 255, 255, 255, 255 }, hi[4] = { 0, 0, 0, 0 };
+		for (int i = 0; i < 16; i++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				lo[c] = std::min<int>(lo[c], block[i * 4 + c]);
+				hi[c] = std::max<int>(hi[c], block[i * 4 + c]);
+			}
+		}
+
+		// Quantize the endpoints with the p-bit which gives the smaller error
+		int endpoint[2][4], pbit[2];
+		const int* source[2] = { lo, hi };
+		for (int e = 0; e < 2; e++)
+		{
+			int bestError = INT32_MAX;
+			for (int p = 0; p < 2; p++)
+			{
+				int error = 0, quantized[4];
+				for (int c = 0; c < 4; c++)
+				{
+					quantized[c] = std::clamp((source[e][c] - p + 1) / 2, 0, 127);
+					int value = (quantized[c] << 1) | p;
+					error += (value - source[e][c]) * (value - source[e][c]);
+				}
+				if (error < bestError)
+				{
+					bestError = error;
+					pbit[e] = p;
+					std::memcpy(endpoint[e], quantized, sizeof(quantized));
+				}
+			}
+		}
+
+		int palette[16][4];
+		for (int i = 0; i < 16; i++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				int e0 = (endpoint[0][c] << 1) | pbit[0];
+				int e1 = (endpoint[1][c] << 1) | pbit[1];
+				palette[i][c] = ((64 - weights[i]) * e0 + weights[i] * e1 + 32) >> 6;
+			}
+		}
+
+		int indices[16];
+		for (int i = 0; i < 16; i++)
+		{
+			int bestDistance = INT32_MAX;
+			for (int p = 0; p < 16; p++)
+			{
+				int distance = Distance(palette[p], &block[i * 4], 4);
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					indices[i] = p;
+				}
+			}
+		}
+
+		// The MSB of the first index is implicit zero, so swap the endpoints if needed
+		if (indices[0] >= 8)
+		{
+			std::swap(endpoint[0], endpoint[1]);
+			std::swap(pbit[0], pbit[1]);
+			for (int& index : indices)
+				index = 15 - index;
+		}
+
+		BitWriter writer(out);
+		writer.Write(1 << 6, 7);
+		for (int c = 0; c < 4; c++)
+		{
+			writer.Write(endpoint[0][c], 7);
+			writer.Write(endpoint[1][c], 7);
+		}
+		writer.Write(pbit[0], 1);
+		writer.Write(pbit[1], 1);
+		for (int i = 0; i < 16; i++)
+			writer.Write(indices[i], i == 0 ? 3 : 4);
+	}
+
+
+} // namespace Helios::Tools
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Image.h"
+
+
+namespace Helios::Tools {
+
+
+	enum class BlockFormat
+	{
+		RGBA8,
+		BC1,
+		BC3,
+		BC4,
+		BC5,
+		BC7
+	};
+
+
+	// Simple range fit encoders (bounding box endpoints, nearest palette entry).
+	// Quality is below dedicated encoders, but good enough for the asset pipeline
+	// and fast enough to run on every asset build.
+	class BlockCompressor
+	{
+	public:
+		// Tightly packed blocks of the image (4x4 blocks, edge pixels are repeated)
+		static std::vector<uint8_t> Compress(const Image& image, BlockFormat format);
+
+		// Bytes of a 4x4 block (4 bytes per pixel for RGBA8)
+		static uint32_t GetBlockBytes(BlockFormat format);
+		static uint32_t GetBlockSize(BlockFormat format) { return format == BlockFormat::RGBA8 ? 1 : 4; }
+
+	private:
+		// Block: 16 RGBA8 pixels (row by row)
+		static void EncodeBC1(const uint8_t* block, uint8_t* out);
+		static void EncodeBC4(const uint8_t* block, uint32_t channel, uint8_t* out);
+		static void EncodeBC7(const uint8_t* block, uint8_t* out);
+	};
+
+
+} // namespace Helios::Tools
@@ -0,0 +1,118 @@
+#include "Image.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+
+namespace Helios::Tools {
+
+
+	bool LoadPPM(const std::string& path, Image& image)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream)
+			return false;
+		std::vector<char> file((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+		// Header: "P6" <width> <height> <maxval> (whitespace separated, '#' comments)
+		size_t pos = 0;
+		auto next = [&]() -> std::string
+		{
+			while (pos < file.size())
+			{
+				if (file[pos] == '#')
+					while (pos < file.size() and file[pos] != '\n') pos++;
+				else if (std::isspace(static_cast<unsigned char>(file[pos])))
+					pos++;
+				else
+					break;
+			}
+			size_t start = pos;
+			while (pos < file.size() and !std::isspace(static_cast<unsigned char>(file[pos])))
+				pos++;
+			return std::string(file.data() + start, pos - start);
+		};
+
+		if (next() != "P6")
+			return false;
+		image.width = static_cast<uint32_t>(std::strtoul(next().c_str(), nullptr, 10));
+		image.height = static_cast<uint32_t>(std::strtoul(next().c_str(), nullptr, 10));
+		uint32_t maxval = static_cast<uint32_t>(std::strtoul(next().c_str(), nullptr, 10));
+		// Exactly one whitespace before the data
+		pos++;
+
+		size_t pixelCount = static_cast<size_t>(image.width) * image.height;
+		if (image.width == 0 or image.height == 0 or maxval != 255 or file.size() < pos + pixelCount * 3)
+			return false;
+
+		image.pixels.resize(pixelCount * 4);
+		const uint8_t* src = reinterpret_cast<const uint8_t*>(file.data() + pos);
+		for (size_t i = 0; i < pixelCount; i++)
+		{
+			image.pixels[i * 4 + 0] = src[i * 3 + 0];
+			image.pixels[i * 4 + 1] = src[i * 3 + 1];
+			image.pixels[i * 4 + 2] = src[i * 3 + 2];
+			image.pixels[i * 4 + 3] = 255;
+		}
+
+		return true;
+	}
+
+
+	std::vector<Image> GenerateMips(const Image& image, bool srgb)
+	{
+		// sRGB <-> linear lookup (alpha is always linear)
+		std::array<float, 256> toLinear;
+		for (int i = 0; i < 256; i++)
+		{
+			float c = i / 255.0f;
+			toLinear[i] = srgb ? (c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f)) : c;
+		}
+		auto fromLinear = [srgb](float c) -> uint8_t
+		{
+			if (srgb)
+				c = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+			return static_cast<uint8_t>(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+		};
+
+		std::vector<Image> levels{ image };
+		while (levels.back().width > 1 or levels.back().height > 1)
+		{
+			const Image& src = levels.back();
+			Image dst;
+			dst.width = std::max(src.width / 2, 1u);
+			dst.height = std::max(src.height / 2, 1u);
+			dst.pixels.resize(static_cast<size_t>(dst.width) * dst.height * 4);
+
+			for (uint32_t y = 0; y < dst.height; y++)
+			{
+				for (uint32_t x = 0; x < dst.width; x++)
+				{
+					uint32_t x0 = std::min(x * 2, src.width - 1), x1 = std::min(x * 2 + 1, src.width - 1);
+					uint32_t y0 = std::min(y * 2, src.height - 1), y1 = std::min(y * 2 + 1, src.height - 1);
+					const uint8_t* p[4] = {
+						&src.pixels[(static_cast<size_t>(y0) * src.width + x0) * 4],
+						&src.pixels[(static_cast<size_t>(y0) * src.width + x1) * 4],
+						&src.pixels[(static_cast<size_t>(y1) * src.width + x0) * 4],
+						&src.pixels[(static_cast<size_t>(y1) * src.width + x1) * 4]
+					};
+
+					uint8_t* out = &dst.pixels[(static_cast<size_t>(y) * dst.width + x) * 4];
+					for (int c = 0; c < 3; c++)
+						out[c] = fromLinear((toLinear[p[0][c]] + toLinear[p[1][c]] + toLinear[p[2][c]] + toLinear[p[3][c]]) * 0.25f);
+					out[3] = static_cast<uint8_t>((p[0][3] + p[1][3] + p[2][3] + p[3][3] + 2) / 4);
+				}
+			}
+
+			levels.push_back(std::move(dst));
+		}
+
+		return levels;
+	}
+
+
+} // namespace Helios::Tools
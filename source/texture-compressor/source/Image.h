@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace Helios::Tools {
+
+
+	// Uncompressed RGBA8 image
+	struct Image
+	{
+		uint32_t width = 0;
+		uint32_t height = 0;
+		std::vector<uint8_t> pixels;
+	};
+
+
+	// Binary PPM (P6), alpha is set to 255
+	bool LoadPPM(const std::string& path, Image& image);
+
+	// Full mip chain with a box filter (level 0 is the image itself).
+	// sRGB images are filtered in linear space.
+	std::vector<Image> GenerateMips(const Image& image, bool srgb);
+
+
+} // namespace Helios::Tools
@@ -0,0 +1,167 @@
+#include "KTX2Writer.h"
+
+#include <fstream>
+
+
+namespace Helios::Tools {
+
+
+	namespace {
+
+		// Values of VkFormat
+		uint32_t GetVkFormat(BlockFormat format, bool srgb)
+		{
+			switch (format)
+			{
+			case BlockFormat::RGBA8: return srgb ? 43 : 37;
+			case BlockFormat::BC1:   return srgb ? 134 : 133;
+			case BlockFormat::BC3:   return srgb ? 138 : 137;
+			case BlockFormat::BC4:   return 139;
+			case BlockFormat::BC5:   return 141;
+			case BlockFormat::BC7:   return srgb ? 146 : 145;
+			default:                 return 0;
+			}
+		}
+
+		struct Sample
+		{
+			uint32_t bitOffset;
+			uint32_t bitLength;
+			uint32_t channel;
+			uint32_t upper;
+		};
+
+		// Basic data format descriptor (Khronos Data Format Specification)
+		std::vector<uint32_t> CreateDFD(BlockFormat format, bool srgb)
+		{
+			constexpr uint32_t QUALIFIER_LINEAR = 0x10;
+
+			uint32_t model = 0;
+			std::vector<Sample> samples;
+			switch (format)
+			{
+			case BlockFormat::RGBA8:
+				model = 1; // RGBSDA
+				samples = { { 0, 8, 0, 255 }, { 8, 8, 1, 255 }, { 16, 8, 2, 255 }, { 24, 8, 15 | (srgb ? QUALIFIER_LINEAR : 0), 255 } };
+				break;
+			case BlockFormat::BC1:
+				model = 128;
+				samples = { { 0, 64, 1, UINT32_MAX } };
+				break;
+			case BlockFormat::BC3:
+				model = 130;
+				samples = { { 0, 64, 15, UINT32_MAX }, { 64, 64, 0, UINT32_MAX } };
+				break;
+			case BlockFormat::BC4:
+				model = 131;
+				samples = { { 0, 64, 0, UINT32_MAX } };
+				break;
+			case BlockFormat::BC5:
+				model = 132;
+				samples = { { 0, 64, 0, UINT32_MAX }, { 64, 64, 1, UINT32_MAX } };
+				break;
+			case BlockFormat::BC7:
+				model = 134;
+				samples = { { 0, 128, 0, UINT32_MAX } };
+				break;
+			}
+
+			uint32_t blockDim = BlockCompressor::GetBlockSize(format) - 1;
+			uint32_t blockSize = 24 + 16 * static_cast<uint32_t>(samples.size());
+
+			std::vector<uint32_t> dfd;
+			dfd.push_back(4 + blockSize);
+			dfd.push_back(0);                                   // vendorId, descriptorType
+			dfd.push_back(2 | (blockSize << 16));               // versionNumber, descriptorBlockSize
+			dfd.push_back(model | (1 << 8) | ((srgb ? 2 : 1) << 16)); // colorModel, BT709 primaries, transfer, flags
+			dfd.push_back(blockDim | (blockDim << 8));          // texelBlockDimension
+			dfd.push_back(BlockCompressor::GetBlockBytes(format)); // bytesPlane0
+			dfd.push_back(0);
+			for (const Sample& sample : samples)
+			{
+				dfd.push_back(sample.bitOffset | ((sample.bitLength - 1) << 16) | (sample.channel << 24));
+				dfd.push_back(0);                               // samplePosition
+				dfd.push_back(0);                               // sampleLower
+				dfd.push_back(sample.upper);                    // sampleUpper
+			}
+			return dfd;
+		}
+
+		template<typename T>
+		void Write(std::ofstream& stream, T value)
+		{
+			stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+	}
+
+
+	bool WriteKTX2(const std::string& path, BlockFormat format, bool srgb,
+		uint32_t width, uint32_t height, const std::vector<std::vector<uint8_t>>& levels)
+	{
+		static const uint8_t identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+		std::ofstream stream(path, std::ios::binary);
+		if (!stream)
+			return false;
+
+		std::vector<uint32_t> dfd = CreateDFD(format, srgb);
+		uint32_t levelCount = static_cast<uint32_t>(levels.size());
+		uint64_t dfdOffset = 80 + 24ull * levelCount;
+		uint64_t dfdLength = dfd.size() * sizeof(uint32_t);
+
+		// Levels are stored from the smallest to the largest, aligned to the block size
+		uint64_t alignment = BlockCompressor::GetBlockBytes(format);
+		std::vector<uint64_t> offsets(levelCount);
+		uint64_t offset = dfdOffset + dfdLength;
+		for (uint32_t level = levelCount; level-- > 0;)
+		{
+			offset = (offset + alignment - 1) / alignment * alignment;
+			offsets[level] = offset;
+			offset += levels[level].size();
+		}
+
+		// Header
+		stream.write(reinterpret_cast<const char*>(identifier), sizeof(identifier));
+		Write<uint32_t>(stream, GetVkFormat(format, srgb));
+		Write<uint32_t>(stream, 1);          // typeSize
+		Write<uint32_t>(stream, width);
+		Write<uint32_t>(stream, height);
+		Write<uint32_t>(stream, 0);          // pixelDepth
+		Write<uint32_t>(stream, 0);          // layerCount
+		Write<uint32_t>(stream, 1);          // faceCount
+		Write<uint32_t>(stream, levelCount);
+		Write<uint32_t>(stream, 0);          // supercompressionScheme
+
+		// Index
+		Write<uint32_t>(stream, static_cast<uint32_t>(dfdOffset));
+		Write<uint32_t>(stream, static_cast<uint32_t>(dfdLength));
+		Write<uint32_t>(stream, 0);          // kvdByteOffset
+		Write<uint32_t>(stream, 0);          // kvdByteLength
+		Write<uint64_t>(stream, 0);          // sgdByteOffset
+		Write<uint64_t>(stream, 0);          // sgdByteLength
+
+		// Level index
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			Write<uint64_t>(stream, offsets[level]);
+			Write<uint64_t>(stream, levels[level].size());
+			Write<uint64_t>(stream, levels[level].size());
+		}
+
+		stream.write(reinterpret_cast<const char*>(dfd.data()), dfdLength);
+
+		// Level data
+		for (uint32_t level = levelCount; level-- > 0;)
+		{
+			uint64_t position = static_cast<uint64_t>(stream.tellp());
+			for (; position < offsets[level]; position++)
+				stream.put(0);
+			stream.write(reinterpret_cast<const char*>(levels[level].data()), levels[level].size());
+		}
+
+		return stream.good();
+	}
+
+
+} // namespace Helios::Tools
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "BlockCompressor.h"
+
+
+namespace Helios::Tools {
+
+
+	// Writes a 2D KTX2 file without supercompression.
+	// Levels: compressed data per mip level (level 0 first).
+	bool WriteKTX2(const std::string& path, BlockFormat format, bool srgb,
+		uint32_t width, uint32_t height, const std::vector<std::vector<uint8_t>>& levels);
+
+
+} // namespace Helios::Tools
@@ -0,0 +1,97 @@
+#include "Image.h"
+#include "BlockCompressor.h"
+#include "KTX2Writer.h"
+
+#include <chrono>
+#include <iostream>
+#include <map>
+
+
+using namespace Helios::Tools;
+
+
+static void PrintUsage()
+{
+	std::cout
+		<< "Usage: helios.tools.texturecompressor <input.ppm> <output.ktx2> [options]\n"
+		<< "Options:\n"
+		<< "  --format <bc1|bc3|bc4|bc5|bc7|rgba8>  target format (default bc7)\n"
+		<< "  --srgb                                 color data in sRGB (bc1, bc3, bc7, rgba8)\n"
+		<< "  --nomips                               only the base level\n";
+}
+
+
+int main(int argc, char** argv)
+{
+	static const std::map<std::string, BlockFormat> formats = {
+		{ "rgba8", BlockFormat::RGBA8 },
+		{ "bc1",   BlockFormat::BC1 },
+		{ "bc3",   BlockFormat::BC3 },
+		{ "bc4",   BlockFormat::BC4 },
+		{ "bc5",   BlockFormat::BC5 },
+		{ "bc7",   BlockFormat::BC7 }
+	};
+
+	if (argc < 3)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::string input = argv[1];
+	std::string output = argv[2];
+	BlockFormat format = BlockFormat::BC7;
+	bool srgb = false;
+	bool mips = true;
+
+	for (int i = 3; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg == "--format" and i + 1 < argc and formats.contains(argv[i + 1]))
+			format = formats.at(argv[++i]);
+		else if (arg == "--srgb")
+			srgb = true;
+		else if (arg == "--nomips")
+			mips = false;
+		else
+		{
+			std::cerr << "Unknown option: " << arg << "\n";
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	// There are no sRGB variants of the single/dual channel formats
+	if (format == BlockFormat::BC4 or format == BlockFormat::BC5)
+		srgb = false;
+
+	Image image;
+	if (!LoadPPM(input, image))
+	{
+		std::cerr << "Failed to load \"" << input << "\"!\n";
+		return 1;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<Image> images = mips ? GenerateMips(image, srgb) : std::vector<Image>{ image };
+	std::vector<std::vector<uint8_t>> levels;
+	for (const Image& level : images)
+		levels.push_back(BlockCompressor::Compress(level, format));
+
+	auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+	if (!WriteKTX2(output, format, srgb, image.width, image.height, levels))
+	{
+		std::cerr << "Failed to write \"" << output << "\"!\n";
+		return 1;
+	}
+
+	size_t size = 0;
+	for (const auto& level : levels)
+		size += level.size();
+	std::cout << input << " -> " << output << ": " << image.width << "x" << image.height
+		<< ", " << levels.size() << " levels, " << size / 1024 << " KiB (" << elapsed.count() << " ms)\n";
+
+	return 0;
+}